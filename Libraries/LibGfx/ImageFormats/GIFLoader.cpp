@@ -445,6 +445,14 @@ size_t GIFImageDecoderPlugin::loop_count()
     return m_context->loops;
 }
 
+static int duration_of_image(GIFImageDescriptor const& image)
+{
+    auto duration = image.duration * 10;
+    if (duration <= 10)
+        return 100;
+    return duration;
+}
+
 size_t GIFImageDecoderPlugin::frame_count()
 {
     if (m_context->error_state != GIFLoadingContext::ErrorState::NoError) {
@@ -497,13 +505,16 @@ ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::frame(size_t index, Optiona
 
     ImageFrameDescriptor frame {};
     frame.image = TRY(m_context->frame_buffer->clone());
-    frame.duration = m_context->images[index]->duration * 10;
-
-    if (frame.duration <= 10) {
-        frame.duration = 100;
-    }
-
+    frame.duration = duration_of_image(*m_context->images[index]);
     return frame;
 }
 
+Optional<int> GIFImageDecoderPlugin::frame_duration(size_t index)
+{
+    // NOTE: The durations are part of the frame descriptors, which frame_count() has loaded already.
+    if (m_context->state < GIFLoadingContext::State::FrameDescriptorsLoaded || index >= m_context->images.size())
+        return {};
+    return duration_of_image(*m_context->images[index]);
+}
+
 }
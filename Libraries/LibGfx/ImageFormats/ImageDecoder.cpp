@@ -72,4 +72,26 @@ ImageDecoder::ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin> plugin)
 {
 }
 
+float ImageDecoderPlugin::downscale_factor_for_ideal_size(IntSize size, Optional<IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty() || size.is_empty())
+        return 1;
+
+    auto factor = max(static_cast<float>(ideal_size->width()) / size.width(), static_cast<float>(ideal_size->height()) / size.height());
+
+    // NOTE: Decoding at a reduced size costs some quality, so only do it if it saves at least three quarters of the pixels.
+    if (factor > 0.5f)
+        return 1;
+    return factor;
+}
+
+ErrorOr<OwnPtr<ProgressiveImageDecoder>> ProgressiveImageDecoder::try_create_for_data_prefix(ReadonlyBytes bytes)
+{
+    if (JPEGImageDecoderPlugin::sniff(bytes))
+        return TRY(JPEGImageDecoderPlugin::create_progressive_decoder());
+    if (PNGImageDecoderPlugin::sniff(bytes))
+        return TRY(PNGImageDecoderPlugin::create_progressive_decoder());
+    return OwnPtr<ProgressiveImageDecoder> {};
+}
+
 }
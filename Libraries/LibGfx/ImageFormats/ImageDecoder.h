@@ -83,8 +83,17 @@ public:
     virtual size_t frame_count() { return 1; }
     virtual size_t first_animated_frame_index() { return 0; }
 
+    // If ideal_size is much smaller than the image, plugins that can decode the image at a reduced size may return a
+    // smaller bitmap that still covers ideal_size. size() keeps returning the image's actual size.
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
+    // Override this if a frame's duration is known without decoding the frame.
+    virtual Optional<int> frame_duration(size_t) { return {}; }
+
+    // Returns the factor by which an image of the given size can be scaled down while still covering ideal_size, or 1 if
+    // ideal_size isn't small enough for decoding at a reduced size to be worth it.
+    static float downscale_factor_for_ideal_size(IntSize, Optional<IntSize> ideal_size);
+
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
 
     virtual ErrorOr<Optional<Media::CodingIndependentCodePoints>> cicp() { return OptionalNone {}; }
@@ -112,6 +121,7 @@ public:
     size_t first_animated_frame_index() const { return m_plugin->first_animated_frame_index(); }
 
     ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
+    Optional<int> frame_duration(size_t index) const { return m_plugin->frame_duration(index); }
 
     Optional<Metadata const&> metadata() const { return m_plugin->metadata(); }
     ErrorOr<ColorSpace> color_space();
@@ -131,4 +141,25 @@ private:
     NonnullOwnPtr<ImageDecoderPlugin> mutable m_plugin;
 };
 
+// Decodes a still image while its encoded data is still arriving, so that part of it can be shown before all of it has
+// been received. This is only meant for previews, the complete data should still be decoded with ImageDecoder.
+class ProgressiveImageDecoder {
+public:
+    // Returns null if the data doesn't start like an image in a format that can be decoded progressively.
+    static ErrorOr<OwnPtr<ProgressiveImageDecoder>> try_create_for_data_prefix(ReadonlyBytes);
+
+    virtual ~ProgressiveImageDecoder() = default;
+
+    // Decodes as much of the image as the data received so far allows. Returns true if more of the image is available
+    // than before.
+    virtual ErrorOr<bool> append(ReadonlyBytes) = 0;
+
+    // The image at its full size, or null if not even the image header has been received yet. Parts of the image that
+    // haven't been decoded yet are transparent.
+    virtual RefPtr<Bitmap> bitmap() const = 0;
+
+protected:
+    ProgressiveImageDecoder() = default;
+};
+
 }
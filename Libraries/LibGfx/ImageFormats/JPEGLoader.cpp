@@ -15,6 +15,7 @@ struct JPEGLoadingContext {
     enum class State {
         NotDecoded,
         Error,
+        HeaderDecoded,
         Decoded,
     };
 
@@ -23,43 +24,48 @@ struct JPEGLoadingContext {
     RefPtr<Gfx::Bitmap> rgb_bitmap;
     RefPtr<Gfx::CMYKBitmap> cmyk_bitmap;
 
+    // The size of the image, which the decoded bitmap is smaller than if it was scaled down while decoding.
+    IntSize size;
+    unsigned scale_numerator { 8 };
+
     ReadonlyBytes data;
     Vector<u8> icc_data;
+    bool is_cmyk { false };
 
     JPEGLoadingContext(ReadonlyBytes data)
         : data(data)
     {
     }
 
-    ErrorOr<void> decode();
+    ErrorOr<void> decode_header();
+    ErrorOr<void> decode(Optional<IntSize> ideal_size = {});
 };
 
+// libjpeg scales images by scale_num / 8 while decoding them. These are the scales it has fast paths for.
+static unsigned scale_numerator_for_ideal_size(IntSize size, Optional<IntSize> ideal_size)
+{
+    auto factor = ImageDecoderPlugin::downscale_factor_for_ideal_size(size, ideal_size);
+    for (unsigned numerator : { 1u, 2u, 4u }) {
+        if (static_cast<float>(numerator) / 8 >= factor)
+            return numerator;
+    }
+    return 8;
+}
+
 struct JPEGErrorManager : jpeg_error_mgr {
     jmp_buf setjmp_buffer {};
 };
 
-ErrorOr<void> JPEGLoadingContext::decode()
+static void jpeg_error_exit(j_common_ptr cinfo)
 {
-    struct jpeg_decompress_struct cinfo;
-    ScopeGuard guard { [&]() { jpeg_destroy_decompress(&cinfo); } };
-
-    struct JPEGErrorManager jerr;
-    cinfo.err = jpeg_std_error(&jerr);
-
-    jpeg_source_mgr source_manager {};
-
-    if (setjmp(jerr.setjmp_buffer))
-        return Error::from_string_literal("Failed to decode JPEG");
-
-    jerr.error_exit = [](j_common_ptr cinfo) {
-        char buffer[JMSG_LENGTH_MAX];
-        (*cinfo->err->format_message)(cinfo, buffer);
-        dbgln("JPEG error: {}", buffer);
-        longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
-    };
-
-    jpeg_create_decompress(&cinfo);
+    char buffer[JMSG_LENGTH_MAX];
+    (*cinfo->err->format_message)(cinfo, buffer);
+    dbgln("JPEG error: {}", buffer);
+    longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
+}
 
+static void initialize_source_manager(jpeg_source_mgr& source_manager, ReadonlyBytes data)
+{
     source_manager.next_input_byte = data.data();
     source_manager.bytes_in_buffer = data.size();
     source_manager.init_source = [](j_decompress_ptr) { };
@@ -74,19 +80,83 @@ ErrorOr<void> JPEGLoadingContext::decode()
     };
     source_manager.resync_to_restart = jpeg_resync_to_restart;
     source_manager.term_source = [](j_decompress_ptr) { };
+}
+
+// Reads everything that's known without decompressing any image data, i.e. the size, color space and ICC profile.
+ErrorOr<void> JPEGLoadingContext::decode_header()
+{
+    struct jpeg_decompress_struct cinfo;
+    ScopeGuard guard { [&]() { jpeg_destroy_decompress(&cinfo); } };
+
+    struct JPEGErrorManager jerr;
+    cinfo.err = jpeg_std_error(&jerr);
 
+    jpeg_source_mgr source_manager {};
+
+    if (setjmp(jerr.setjmp_buffer))
+        return Error::from_string_literal("Failed to decode JPEG header");
+
+    jerr.error_exit = jpeg_error_exit;
+
+    jpeg_create_decompress(&cinfo);
+    initialize_source_manager(source_manager, data);
     cinfo.src = &source_manager;
 
     jpeg_save_markers(&cinfo, JPEG_APP0 + 2, 0xFFFF);
     if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK)
         return Error::from_string_literal("Failed to read JPEG header");
 
+    size = { static_cast<int>(cinfo.image_width), static_cast<int>(cinfo.image_height) };
+    is_cmyk = cinfo.jpeg_color_space == JCS_CMYK || cinfo.jpeg_color_space == JCS_YCCK;
+
+    JOCTET* icc_data_ptr = nullptr;
+    unsigned int icc_data_length = 0;
+    if (jpeg_read_icc_profile(&cinfo, &icc_data_ptr, &icc_data_length)) {
+        icc_data.resize(icc_data_length);
+        memcpy(icc_data.data(), icc_data_ptr, icc_data_length);
+        free(icc_data_ptr);
+    }
+
+    return {};
+}
+
+ErrorOr<void> JPEGLoadingContext::decode(Optional<IntSize> ideal_size)
+{
+    struct jpeg_decompress_struct cinfo;
+    ScopeGuard guard { [&]() { jpeg_destroy_decompress(&cinfo); } };
+
+    struct JPEGErrorManager jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+
+    jpeg_source_mgr source_manager {};
+
+    if (setjmp(jerr.setjmp_buffer))
+        return Error::from_string_literal("Failed to decode JPEG");
+
+    jerr.error_exit = jpeg_error_exit;
+
+    jpeg_create_decompress(&cinfo);
+    initialize_source_manager(source_manager, data);
+    cinfo.src = &source_manager;
+
+    // NOTE: The size and ICC profile have been read by decode_header() already, so there is no need to save any markers.
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK)
+        return Error::from_string_literal("Failed to read JPEG header");
+
+    scale_numerator = 8;
+
     if (cinfo.jpeg_color_space == JCS_CMYK) {
         cinfo.out_color_space = JCS_CMYK;
     } else if (cinfo.jpeg_color_space == JCS_YCCK) {
         cinfo.out_color_space = JCS_YCCK;
     } else {
         cinfo.out_color_space = JCS_EXT_BGRX;
+
+        // OPTIMIZATION: Scaling the image down while decoding it is a lot cheaper than decoding it at its full size, both
+        //               in time and memory, since most of the DCT coefficients never have to be transformed.
+        scale_numerator = scale_numerator_for_ideal_size(size, ideal_size);
+        cinfo.scale_num = scale_numerator;
+        cinfo.scale_denom = 8;
     }
 
     jpeg_start_decompress(&cinfo);
@@ -147,14 +217,6 @@ ErrorOr<void> JPEGLoadingContext::decode()
         }
     }
 
-    JOCTET* icc_data_ptr = nullptr;
-    unsigned int icc_data_length = 0;
-    if (jpeg_read_icc_profile(&cinfo, &icc_data_ptr, &icc_data_length)) {
-        icc_data.resize(icc_data_length);
-        memcpy(icc_data.data(), icc_data_ptr, icc_data_length);
-        free(icc_data_ptr);
-    }
-
     if (could_read_all_scanlines)
         jpeg_finish_decompress(&cinfo);
     else
@@ -166,6 +228,200 @@ ErrorOr<void> JPEGLoadingContext::decode()
     return {};
 }
 
+// Decodes a JPEG with a suspending data source, so that libjpeg can stop whenever it runs out of data and pick up where
+// it left off once more data has arrived. Baseline images are shown row by row, progressive images scan by scan.
+class JPEGProgressiveImageDecoder final : public ProgressiveImageDecoder {
+public:
+    static ErrorOr<NonnullOwnPtr<JPEGProgressiveImageDecoder>> create()
+    {
+        return adopt_own(*new JPEGProgressiveImageDecoder);
+    }
+
+    virtual ~JPEGProgressiveImageDecoder() override
+    {
+        jpeg_destroy_decompress(&m_cinfo);
+    }
+
+    virtual ErrorOr<bool> append(ReadonlyBytes bytes) override
+    {
+        if (m_state == State::Done || m_state == State::Unsupported || m_state == State::Error)
+            return false;
+
+        // Keep the data that libjpeg hasn't consumed yet, it backs up to the start of whatever it couldn't finish.
+        if (!m_buffer.is_empty()) {
+            auto consumed = m_source_manager.next_input_byte - m_buffer.data();
+            m_buffer = TRY(m_buffer.slice(consumed, m_buffer.size() - consumed));
+        }
+
+        auto bytes_skipped = min(m_bytes_to_skip, bytes.size());
+        m_bytes_to_skip -= bytes_skipped;
+        TRY(m_buffer.try_append(bytes.slice(bytes_skipped)));
+
+        m_source_manager.next_input_byte = m_buffer.data();
+        m_source_manager.bytes_in_buffer = m_buffer.size();
+
+        if (setjmp(m_error_manager.setjmp_buffer)) {
+            m_state = State::Error;
+            return Error::from_string_literal("Failed to decode JPEG");
+        }
+
+        auto result = decode_available_data();
+        if (result.is_error())
+            m_state = State::Error;
+        return result;
+    }
+
+    virtual RefPtr<Bitmap> bitmap() const override { return m_bitmap; }
+
+private:
+    enum class State {
+        ReadingHeader,
+        StartingDecompression,
+        ReadingScanlines,
+        ReadingScans,
+        FinishingDecompression,
+        Done,
+        Unsupported,
+        Error,
+    };
+
+    JPEGProgressiveImageDecoder()
+    {
+        m_cinfo.err = jpeg_std_error(&m_error_manager);
+        m_error_manager.error_exit = [](j_common_ptr cinfo) {
+            char buffer[JMSG_LENGTH_MAX];
+            (*cinfo->err->format_message)(cinfo, buffer);
+            dbgln("JPEG error: {}", buffer);
+            longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
+        };
+
+        jpeg_create_decompress(&m_cinfo);
+        m_cinfo.client_data = this;
+
+        m_source_manager.init_source = [](j_decompress_ptr) { };
+        // NOTE: Returning false suspends decoding until we have more data.
+        m_source_manager.fill_input_buffer = [](j_decompress_ptr) -> boolean { return false; };
+        m_source_manager.skip_input_data = [](j_decompress_ptr context, long num_bytes) {
+            if (num_bytes <= 0)
+                return;
+            auto& source = *context->src;
+            if (static_cast<size_t>(num_bytes) > source.bytes_in_buffer) {
+                static_cast<JPEGProgressiveImageDecoder*>(context->client_data)->m_bytes_to_skip += num_bytes - source.bytes_in_buffer;
+                source.next_input_byte += source.bytes_in_buffer;
+                source.bytes_in_buffer = 0;
+                return;
+            }
+            source.next_input_byte += num_bytes;
+            source.bytes_in_buffer -= num_bytes;
+        };
+        m_source_manager.resync_to_restart = jpeg_resync_to_restart;
+        m_source_manager.term_source = [](j_decompress_ptr) { };
+        m_cinfo.src = &m_source_manager;
+    }
+
+    ErrorOr<bool> decode_available_data()
+    {
+        if (m_state == State::ReadingHeader) {
+            auto result = jpeg_read_header(&m_cinfo, TRUE);
+            if (result == JPEG_SUSPENDED)
+                return false;
+            if (result != JPEG_HEADER_OK)
+                return Error::from_string_literal("Failed to read JPEG header");
+
+            // NOTE: CMYK images are converted to RGB once all of their data is there.
+            if (m_cinfo.jpeg_color_space == JCS_CMYK || m_cinfo.jpeg_color_space == JCS_YCCK) {
+                m_state = State::Unsupported;
+                return false;
+            }
+
+            // Undecoded parts of the image stay transparent, so use a format with an alpha channel.
+            m_cinfo.out_color_space = JCS_EXT_BGRA;
+
+            // Buffered image mode lets us show each scan of a progressive JPEG as soon as it is complete.
+            m_cinfo.buffered_image = jpeg_has_multiple_scans(&m_cinfo);
+            m_state = State::StartingDecompression;
+        }
+
+        if (m_state == State::StartingDecompression) {
+            if (!jpeg_start_decompress(&m_cinfo))
+                return false;
+            m_bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, { static_cast<int>(m_cinfo.output_width), static_cast<int>(m_cinfo.output_height) }));
+            m_state = m_cinfo.buffered_image ? State::ReadingScans : State::ReadingScanlines;
+        }
+
+        bool made_progress = false;
+
+        if (m_state == State::ReadingScanlines) {
+            while (m_cinfo.output_scanline < m_cinfo.output_height) {
+                auto* row_ptr = m_bitmap->scanline_u8(m_cinfo.output_scanline);
+                if (jpeg_read_scanlines(&m_cinfo, &row_ptr, 1) == 0)
+                    return made_progress;
+                made_progress = true;
+            }
+            m_state = State::FinishingDecompression;
+        }
+
+        if (m_state == State::ReadingScans) {
+            if (m_scan_being_shown == 0) {
+                int result = JPEG_SUSPENDED;
+                do {
+                    result = jpeg_consume_input(&m_cinfo);
+                } while (result != JPEG_SUSPENDED && result != JPEG_REACHED_EOI);
+
+                // NOTE: Only show scans that have been read completely, so that showing them never has to wait for data.
+                auto last_complete_scan = jpeg_input_complete(&m_cinfo) ? m_cinfo.input_scan_number : m_cinfo.input_scan_number - 1;
+                if (last_complete_scan <= m_last_shown_scan)
+                    return false;
+                m_scan_being_shown = last_complete_scan;
+            }
+
+            // NOTE: Each of these can still suspend, in which case we pick up where we left off once more data has arrived.
+            if (!m_did_start_output) {
+                if (!jpeg_start_output(&m_cinfo, m_scan_being_shown))
+                    return false;
+                m_did_start_output = true;
+            }
+            while (m_cinfo.output_scanline < m_cinfo.output_height) {
+                auto* row_ptr = m_bitmap->scanline_u8(m_cinfo.output_scanline);
+                if (jpeg_read_scanlines(&m_cinfo, &row_ptr, 1) == 0)
+                    return false;
+            }
+            if (!jpeg_finish_output(&m_cinfo))
+                return false;
+
+            m_last_shown_scan = m_scan_being_shown;
+            m_scan_being_shown = 0;
+            m_did_start_output = false;
+            made_progress = true;
+
+            if (!jpeg_input_complete(&m_cinfo))
+                return true;
+            m_state = State::FinishingDecompression;
+        }
+
+        if (m_state == State::FinishingDecompression) {
+            if (!jpeg_finish_decompress(&m_cinfo))
+                return made_progress;
+            m_state = State::Done;
+        }
+
+        return made_progress;
+    }
+
+    jpeg_decompress_struct m_cinfo {};
+    JPEGErrorManager m_error_manager {};
+    jpeg_source_mgr m_source_manager {};
+
+    ByteBuffer m_buffer;
+    size_t m_bytes_to_skip { 0 };
+
+    RefPtr<Bitmap> m_bitmap;
+    State m_state { State::ReadingHeader };
+    int m_last_shown_scan { 0 };
+    int m_scan_being_shown { 0 };
+    bool m_did_start_output { false };
+};
+
 JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
     : m_context(move(context))
 {
@@ -173,18 +429,26 @@ JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>
 
 JPEGImageDecoderPlugin::~JPEGImageDecoderPlugin() = default;
 
+static void decode_header_if_needed(JPEGLoadingContext& context)
+{
+    if (context.state != JPEGLoadingContext::State::NotDecoded)
+        return;
+
+    if (auto result = context.decode_header(); result.is_error()) {
+        context.state = JPEGLoadingContext::State::Error;
+        return;
+    }
+    context.state = JPEGLoadingContext::State::HeaderDecoded;
+}
+
 IntSize JPEGImageDecoderPlugin::size()
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
-        (void)frame(0);
+    // NOTE: Only the header is read here, so that the image can be decoded at the size it's going to be shown at later.
+    decode_header_if_needed(*m_context);
 
     if (m_context->state == JPEGLoadingContext::State::Error)
         return {};
-    if (m_context->rgb_bitmap)
-        return m_context->rgb_bitmap->size();
-    if (m_context->cmyk_bitmap)
-        return m_context->cmyk_bitmap->size();
-    return {};
+    return m_context->size;
 }
 
 bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
@@ -200,16 +464,29 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
     return adopt_own(*new JPEGImageDecoderPlugin(make<JPEGLoadingContext>(data)));
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<NonnullOwnPtr<ProgressiveImageDecoder>> JPEGImageDecoderPlugin::create_progressive_decoder()
+{
+    return TRY(JPEGProgressiveImageDecoder::create());
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
 
+    decode_header_if_needed(*m_context);
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
+    // If we decoded the image at a different scale before, decode it again at the one that is asked for now.
+    if (m_context->state == JPEGLoadingContext::State::Decoded && !m_context->cmyk_bitmap
+        && scale_numerator_for_ideal_size(m_context->size, ideal_size) != m_context->scale_numerator) {
+        m_context->rgb_bitmap = nullptr;
+        m_context->state = JPEGLoadingContext::State::HeaderDecoded;
+    }
+
     if (m_context->state < JPEGLoadingContext::State::Decoded) {
-        if (auto result = m_context->decode(); result.is_error()) {
+        if (auto result = m_context->decode(ideal_size); result.is_error()) {
             m_context->state = JPEGLoadingContext::State::Error;
             return result.release_error();
         }
@@ -227,8 +504,7 @@ Optional<Metadata const&> JPEGImageDecoderPlugin::metadata()
 
 ErrorOr<Optional<ReadonlyBytes>> JPEGImageDecoderPlugin::icc_data()
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
-        (void)frame(0);
+    decode_header_if_needed(*m_context);
 
     if (!m_context->icc_data.is_empty())
         return m_context->icc_data;
@@ -237,17 +513,16 @@ ErrorOr<Optional<ReadonlyBytes>> JPEGImageDecoderPlugin::icc_data()
 
 NaturalFrameFormat JPEGImageDecoderPlugin::natural_frame_format() const
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
-        (void)const_cast<JPEGImageDecoderPlugin&>(*this).frame(0);
+    decode_header_if_needed(*m_context);
 
-    if (m_context->cmyk_bitmap)
+    if (m_context->is_cmyk)
         return NaturalFrameFormat::CMYK;
     return NaturalFrameFormat::RGB;
 }
 
 ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
+    if (m_context->state < JPEGLoadingContext::State::Decoded)
         (void)frame(0);
 
     if (m_context->state == JPEGLoadingContext::State::Error)
@@ -135,6 +135,30 @@ static void log_png_warning(png_structp, char const* warning_message)
     dbgln("libpng warning: {}", warning_message);
 }
 
+static void set_up_transformations_to_bgra8888(png_structp png_ptr, png_infop info_ptr, int bit_depth, int color_type, int interlace_type)
+{
+    if (color_type == PNG_COLOR_TYPE_PALETTE)
+        png_set_palette_to_rgb(png_ptr);
+
+    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
+        png_set_expand_gray_1_2_4_to_8(png_ptr);
+
+    if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+        png_set_tRNS_to_alpha(png_ptr);
+
+    if (bit_depth == 16)
+        png_set_strip_16(png_ptr);
+
+    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+        png_set_gray_to_rgb(png_ptr);
+
+    if (interlace_type != PNG_INTERLACE_NONE)
+        png_set_interlace_handling(png_ptr);
+
+    png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
+    png_set_bgr(png_ptr);
+}
+
 ErrorOr<void> PNGImageDecoderPlugin::initialize()
 {
     m_context->png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -172,26 +196,7 @@ ErrorOr<void> PNGImageDecoderPlugin::initialize()
     png_get_IHDR(m_context->png_ptr, m_context->info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr);
     m_context->size = { static_cast<int>(width), static_cast<int>(height) };
 
-    if (color_type == PNG_COLOR_TYPE_PALETTE)
-        png_set_palette_to_rgb(m_context->png_ptr);
-
-    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
-        png_set_expand_gray_1_2_4_to_8(m_context->png_ptr);
-
-    if (png_get_valid(m_context->png_ptr, m_context->info_ptr, PNG_INFO_tRNS))
-        png_set_tRNS_to_alpha(m_context->png_ptr);
-
-    if (bit_depth == 16)
-        png_set_strip_16(m_context->png_ptr);
-
-    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
-        png_set_gray_to_rgb(m_context->png_ptr);
-
-    if (interlace_type != PNG_INTERLACE_NONE)
-        png_set_interlace_handling(m_context->png_ptr);
-
-    png_set_filler(m_context->png_ptr, 0xFF, PNG_FILLER_AFTER);
-    png_set_bgr(m_context->png_ptr);
+    set_up_transformations_to_bgra8888(m_context->png_ptr, m_context->info_ptr, bit_depth, color_type, interlace_type);
 
     png_byte color_primaries { 0 };
     png_byte transfer_function { 0 };
@@ -362,6 +367,124 @@ ErrorOr<size_t> PNGLoadingContext::read_frames(png_structp png_ptr, png_infop in
 
 PNGImageDecoderPlugin::~PNGImageDecoderPlugin() = default;
 
+// Feeds data to libpng's progressive reader as it arrives, which hands us each row as soon as it has been decoded.
+class PNGProgressiveImageDecoder final : public ProgressiveImageDecoder {
+public:
+    static ErrorOr<NonnullOwnPtr<PNGProgressiveImageDecoder>> create()
+    {
+        auto decoder = adopt_own(*new PNGProgressiveImageDecoder);
+
+        decoder->m_png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+        if (!decoder->m_png_ptr)
+            return Error::from_string_view("Failed to allocate read struct"sv);
+
+        decoder->m_info_ptr = png_create_info_struct(decoder->m_png_ptr);
+        if (!decoder->m_info_ptr)
+            return Error::from_string_view("Failed to allocate info struct"sv);
+
+        png_set_error_fn(decoder->m_png_ptr, nullptr, log_png_error, log_png_warning);
+        png_set_progressive_read_fn(
+            decoder->m_png_ptr, decoder.ptr(),
+            [](png_structp png_ptr, png_infop) {
+                static_cast<PNGProgressiveImageDecoder*>(png_get_progressive_ptr(png_ptr))->did_read_info();
+            },
+            [](png_structp png_ptr, png_bytep new_row, png_uint_32 row_index, int) {
+                static_cast<PNGProgressiveImageDecoder*>(png_get_progressive_ptr(png_ptr))->did_read_row(new_row, row_index);
+            },
+            [](png_structp png_ptr, png_infop) {
+                static_cast<PNGProgressiveImageDecoder*>(png_get_progressive_ptr(png_ptr))->m_state = State::Done;
+            });
+
+        return decoder;
+    }
+
+    virtual ~PNGProgressiveImageDecoder() override
+    {
+        png_destroy_read_struct(&m_png_ptr, &m_info_ptr, nullptr);
+    }
+
+    virtual ErrorOr<bool> append(ReadonlyBytes bytes) override
+    {
+        if (m_state != State::Decoding)
+            return false;
+
+        m_did_read_rows = false;
+
+        // NOTE: We need to setjmp() here because libpng uses longjmp() for error handling.
+        if (auto error_value = setjmp(png_jmpbuf(m_png_ptr)); error_value) {
+            m_state = State::Error;
+            return Error::from_errno(error_value);
+        }
+
+        png_process_data(m_png_ptr, m_info_ptr, const_cast<u8*>(bytes.data()), bytes.size());
+        return m_did_read_rows;
+    }
+
+    virtual RefPtr<Bitmap> bitmap() const override { return m_bitmap; }
+
+private:
+    enum class State {
+        Decoding,
+        Done,
+        Unsupported,
+        Error,
+    };
+
+    PNGProgressiveImageDecoder() = default;
+
+    void did_read_info()
+    {
+        u32 width = 0;
+        u32 height = 0;
+        int bit_depth = 0;
+        int color_type = 0;
+        int interlace_type = 0;
+        png_get_IHDR(m_png_ptr, m_info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr);
+
+        // NOTE: Animations and images that have to be rotated according to their Exif metadata would look different
+        //       from the final image, so we don't show them until all of their data has arrived.
+        u32 frame_count = 0;
+        u32 loop_count = 0;
+        u8* exif_data = nullptr;
+        u32 exif_length = 0;
+        if (png_get_acTL(m_png_ptr, m_info_ptr, &frame_count, &loop_count) || png_get_eXIf_1(m_png_ptr, m_info_ptr, &exif_length, &exif_data) > 0) {
+            m_state = State::Unsupported;
+            return;
+        }
+
+        set_up_transformations_to_bgra8888(m_png_ptr, m_info_ptr, bit_depth, color_type, interlace_type);
+        png_read_update_info(m_png_ptr, m_info_ptr);
+
+        auto bitmap_or_error = Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Unpremultiplied, { static_cast<int>(width), static_cast<int>(height) });
+        if (bitmap_or_error.is_error()) {
+            m_state = State::Error;
+            return;
+        }
+        m_bitmap = bitmap_or_error.release_value();
+    }
+
+    void did_read_row(png_bytep new_row, png_uint_32 row_index)
+    {
+        // NOTE: libpng passes a null row for rows of interlaced images that didn't change in the current pass.
+        if (m_state != State::Decoding || !m_bitmap || !new_row || row_index >= static_cast<u32>(m_bitmap->height()))
+            return;
+
+        png_progressive_combine_row(m_png_ptr, m_bitmap->scanline_u8(row_index), new_row);
+        m_did_read_rows = true;
+    }
+
+    png_structp m_png_ptr { nullptr };
+    png_infop m_info_ptr { nullptr };
+    RefPtr<Bitmap> m_bitmap;
+    State m_state { State::Decoding };
+    bool m_did_read_rows { false };
+};
+
+ErrorOr<NonnullOwnPtr<ProgressiveImageDecoder>> PNGImageDecoderPlugin::create_progressive_decoder()
+{
+    return TRY(PNGProgressiveImageDecoder::create());
+}
+
 bool PNGImageDecoderPlugin::sniff(ReadonlyBytes data)
 {
     auto constexpr png_signature_size_in_bytes = 8;
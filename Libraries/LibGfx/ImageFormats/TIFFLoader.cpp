@@ -5,22 +5,26 @@
  */
 
 #include "TIFFLoader.h"
-#include <AK/ConstrainedStream.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/String.h>
 #include <LibCompress/Lzw.h>
 #include <LibCompress/PackBitsDecoder.h>
 #include <LibCompress/Zlib.h>
+#include <LibCore/System.h>
 #include <LibGfx/CMYKBitmap.h>
 #include <LibGfx/ImageFormats/CCITTDecoder.h>
 #include <LibGfx/ImageFormats/ExifOrientedBitmap.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibThreading/ParallelFor.h>
 
 namespace Gfx {
 
 namespace {
 
+// Below this size, starting threads costs more than decoding the image on a single one.
+constexpr u64 minimum_pixel_count_for_parallel_decoding = 256 * 256;
+
 CCITT::Group3Options parse_t4_options(u32 bit_field)
 {
     // Section 11: CCITT Bilevel Encodings
@@ -317,7 +321,9 @@ private:
         return CMYK { first_component, second_component, third_component, fourth_component };
     }
 
-    template<CallableAs<ErrorOr<ReadonlyBytes>, u32, IntSize> SegmentDecoder>
+    // The segment decoder turns the encoded bytes of a strip or a tile into its decoded bytes, which it may store in
+    // the given buffer. It may be called on several threads at once.
+    template<CallableAs<ErrorOr<ReadonlyBytes>, ReadonlyBytes, IntSize, ByteBuffer&> SegmentDecoder>
     ErrorOr<void> loop_over_pixels(SegmentDecoder&& segment_decoder)
     {
         auto const offsets = *segment_offsets();
@@ -333,11 +339,18 @@ private:
             return ExifOrientedBitmap::create(*metadata().orientation(), { m_image_width, *metadata().image_length() }, BitmapFormat::BGRA8888);
         }()));
 
+        // NOTE: The segments are read up front, since the stream can't be shared between threads.
+        Vector<ReadonlyBytes> encoded_segments;
+        TRY(encoded_segments.try_ensure_capacity(offsets.size()));
         for (u32 segment_index = 0; segment_index < offsets.size(); ++segment_index) {
             TRY(m_stream->seek(offsets[segment_index]));
+            encoded_segments.unchecked_append(TRY(m_stream->read_in_place<u8 const>(byte_counts[segment_index])));
+        }
 
+        Function<ErrorOr<void>(size_t)> decode_segment = [&](size_t segment_index) -> ErrorOr<void> {
             auto const rows_in_segment = segment_index < offsets.size() - 1 ? segment_length : *m_metadata.image_length() - segment_length * segment_index;
-            auto const decoded_bytes = TRY(segment_decoder(byte_counts[segment_index], { segment_width, rows_in_segment }));
+            ByteBuffer decoded_buffer;
+            auto const decoded_bytes = TRY(segment_decoder(encoded_segments[segment_index], { segment_width, rows_in_segment }, decoded_buffer));
             auto decoded_segment = make<FixedMemoryStream>(decoded_bytes);
             auto decoded_stream = make<BigEndianInputBitStream>(move(decoded_segment));
 
@@ -381,6 +394,20 @@ private:
 
                 decoded_stream->align_to_byte_boundary();
             }
+
+            return {};
+        };
+
+        // OPTIMIZATION: Strips and tiles are compressed independently of each other, and each of them covers its own
+        //               pixels of the bitmap. This lets us decode large images on several threads at once. The
+        //               work is shared with the idle background threads that decode other images, so this never adds
+        //               threads of its own.
+        auto const pixel_count = static_cast<u64>(m_image_width) * *m_metadata.image_length();
+        if (offsets.size() > 1 && pixel_count >= minimum_pixel_count_for_parallel_decoding) {
+            TRY(Threading::parallel_for(offsets.size(), Core::System::hardware_concurrency(), decode_segment));
+        } else {
+            for (u32 segment_index = 0; segment_index < offsets.size(); ++segment_index)
+                TRY(decode_segment(segment_index));
         }
 
         if (m_photometric_interpretation == PhotometricInterpretation::CMYK)
@@ -403,7 +430,7 @@ private:
         return {};
     }
 
-    ErrorOr<ByteBuffer> read_bytes_considering_fill_order(u32 bytes_to_read) const
+    ErrorOr<ByteBuffer> bytes_considering_fill_order(ReadonlyBytes bytes) const
     {
         auto const reverse_byte = [](u8 b) {
             b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
@@ -412,7 +439,6 @@ private:
             return b;
         };
 
-        auto const bytes = TRY(m_stream->read_in_place<u8 const>(bytes_to_read));
         auto copy = TRY(ByteBuffer::copy(bytes));
         if (m_metadata.fill_order() == FillOrder::RightToLeft) {
             for (auto& byte : copy.bytes())
@@ -426,8 +452,8 @@ private:
     {
         switch (*m_metadata.compression()) {
         case Compression::NoCompression: {
-            auto identity = [&](u32 num_bytes, IntSize) {
-                return m_stream->read_in_place<u8 const>(num_bytes);
+            auto identity = [](ReadonlyBytes encoded_bytes, IntSize, ByteBuffer&) -> ErrorOr<ReadonlyBytes> {
+                return encoded_bytes;
             };
 
             TRY(loop_over_pixels(move(identity)));
@@ -436,9 +462,8 @@ private:
         case Compression::CCITTRLE: {
             TRY(ensure_tags_are_correct_for_ccitt());
 
-            ByteBuffer decoded_bytes {};
-            auto decode_ccitt_rle_segment = [&](u32 num_bytes, IntSize segment_size) -> ErrorOr<ReadonlyBytes> {
-                auto const encoded_bytes = TRY(read_bytes_considering_fill_order(num_bytes));
+            auto decode_ccitt_rle_segment = [&](ReadonlyBytes segment_bytes, IntSize segment_size, ByteBuffer& decoded_bytes) -> ErrorOr<ReadonlyBytes> {
+                auto const encoded_bytes = TRY(bytes_considering_fill_order(segment_bytes));
                 decoded_bytes = TRY(CCITT::decode_ccitt_rle(encoded_bytes, segment_size.width(), segment_size.height()));
                 return decoded_bytes;
             };
@@ -450,9 +475,8 @@ private:
             TRY(ensure_tags_are_correct_for_ccitt());
 
             auto const parameters = parse_t4_options(*m_metadata.t4_options());
-            ByteBuffer decoded_bytes {};
-            auto decode_group3_segment = [&](u32 num_bytes, IntSize segment_size) -> ErrorOr<ReadonlyBytes> {
-                auto const encoded_bytes = TRY(read_bytes_considering_fill_order(num_bytes));
+            auto decode_group3_segment = [&](ReadonlyBytes segment_bytes, IntSize segment_size, ByteBuffer& decoded_bytes) -> ErrorOr<ReadonlyBytes> {
+                auto const encoded_bytes = TRY(bytes_considering_fill_order(segment_bytes));
                 decoded_bytes = TRY(CCITT::decode_ccitt_group3(encoded_bytes, segment_size.width(), segment_size.height(), parameters));
                 return decoded_bytes;
             };
@@ -464,9 +488,8 @@ private:
             TRY(ensure_tags_are_correct_for_ccitt());
 
             // FIXME: We need to parse T6 options
-            ByteBuffer decoded_bytes {};
-            auto decode_group3_segment = [&](u32 num_bytes, IntSize segment_size) -> ErrorOr<ReadonlyBytes> {
-                auto const encoded_bytes = TRY(read_bytes_considering_fill_order(num_bytes));
+            auto decode_group3_segment = [&](ReadonlyBytes segment_bytes, IntSize segment_size, ByteBuffer& decoded_bytes) -> ErrorOr<ReadonlyBytes> {
+                auto const encoded_bytes = TRY(bytes_considering_fill_order(segment_bytes));
                 decoded_bytes = TRY(CCITT::decode_ccitt_group4(encoded_bytes, segment_size.width(), segment_size.height()));
                 return decoded_bytes;
             };
@@ -475,10 +498,7 @@ private:
             break;
         }
         case Compression::LZW: {
-            ByteBuffer decoded_bytes {};
-            auto decode_lzw_segment = [&](u32 num_bytes, IntSize) -> ErrorOr<ReadonlyBytes> {
-                auto const encoded_bytes = TRY(m_stream->read_in_place<u8 const>(num_bytes));
-
+            auto decode_lzw_segment = [](ReadonlyBytes encoded_bytes, IntSize, ByteBuffer& decoded_bytes) -> ErrorOr<ReadonlyBytes> {
                 if (encoded_bytes.is_empty())
                     return Error::from_string_literal("TIFFImageDecoderPlugin: Unable to read from empty LZW segment");
 
@@ -504,9 +524,8 @@ private:
         case Compression::PixarDeflate: {
             // This is an extension from the Technical Notes from 2002:
             // https://web.archive.org/web/20160305055905/http://partners.adobe.com/public/developer/en/tiff/TIFFphotoshop.pdf
-            ByteBuffer decoded_bytes {};
-            auto decode_zlib = [&](u32 num_bytes, IntSize) -> ErrorOr<ReadonlyBytes> {
-                auto stream = make<ConstrainedStream>(MaybeOwned<Stream>(*m_stream), num_bytes);
+            auto decode_zlib = [](ReadonlyBytes encoded_bytes, IntSize, ByteBuffer& decoded_bytes) -> ErrorOr<ReadonlyBytes> {
+                auto stream = make<FixedMemoryStream>(encoded_bytes);
                 auto decompressed_stream = TRY(Compress::ZlibDecompressor::create(move(stream)));
                 decoded_bytes = TRY(decompressed_stream->read_until_eof(4096));
                 return decoded_bytes;
@@ -517,10 +536,7 @@ private:
         }
         case Compression::PackBits: {
             // Section 9: PackBits Compression
-            ByteBuffer decoded_bytes {};
-
-            auto decode_packbits_segment = [&](u32 num_bytes, IntSize) -> ErrorOr<ReadonlyBytes> {
-                auto const encoded_bytes = TRY(m_stream->read_in_place<u8 const>(num_bytes));
+            auto decode_packbits_segment = [](ReadonlyBytes encoded_bytes, IntSize, ByteBuffer& decoded_bytes) -> ErrorOr<ReadonlyBytes> {
                 decoded_bytes = TRY(Compress::PackBits::decode_all(encoded_bytes));
                 return decoded_bytes;
             };
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Error.h>
+#include <AK/Math.h>
 #include <LibGfx/ImageFormats/WebPLoader.h>
 
 #include <webp/decode.h>
@@ -34,6 +35,17 @@ struct WebPLoadingContext {
     ByteBuffer icc_data;
 
     Vector<ImageFrameDescriptor> frame_descriptors;
+
+    // Animations are decoded one frame at a time, as their frames are asked for, so we never hold more than one of them.
+    WebPAnimDecoder* anim_decoder { nullptr };
+    size_t next_frame_index { 0 };
+    int previous_timestamp { 0 };
+
+    ~WebPLoadingContext()
+    {
+        if (anim_decoder)
+            WebPAnimDecoderDelete(anim_decoder);
+    }
 };
 
 WebPImageDecoderPlugin::WebPImageDecoderPlugin(ReadonlyBytes data, OwnPtr<WebPLoadingContext> context)
@@ -115,52 +127,105 @@ static ErrorOr<void> decode_webp_header(WebPLoadingContext& context)
     return {};
 }
 
-static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
+static IntSize decoded_size_for_ideal_size(IntSize size, Optional<IntSize> ideal_size)
+{
+    auto factor = ImageDecoderPlugin::downscale_factor_for_ideal_size(size, ideal_size);
+    if (factor == 1)
+        return size;
+    return {
+        max(1, static_cast<int>(ceil(size.width() * factor))),
+        max(1, static_cast<int>(ceil(size.height() * factor))),
+    };
+}
+
+static ErrorOr<void> decode_webp_image(WebPLoadingContext& context, IntSize decoded_size)
 {
     VERIFY(context.state >= WebPLoadingContext::State::HeaderDecoded);
+    VERIFY(!context.has_animation);
+
+    auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
+    auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, decoded_size));
+
+    WebPDecoderConfig config;
+    if (!WebPInitDecoderConfig(&config))
+        return Error::from_string_literal("Failed to initialize webp decoder config");
+
+    // Like for animations, let libwebp filter lossy images on a second thread while it decodes them.
+    config.options.use_threads = 1;
+
+    // OPTIMIZATION: libwebp can scale the image while decoding it, which saves us from holding on to a full size bitmap
+    //               that is only ever drawn a lot smaller.
+    if (decoded_size != context.size) {
+        config.options.use_scaling = 1;
+        config.options.scaled_width = decoded_size.width();
+        config.options.scaled_height = decoded_size.height();
+    }
+
+    config.output.colorspace = MODE_BGRA;
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba = bitmap->scanline_u8(0);
+    config.output.u.RGBA.stride = bitmap->pitch();
+    config.output.u.RGBA.size = bitmap->data_size();
+
+    auto status = WebPDecode(context.data.data(), context.data.size(), &config);
+    WebPFreeDecBuffer(&config.output);
+    if (status != VP8_STATUS_OK)
+        return Error::from_string_literal("Failed to decode webp image into bitmap");
+
+    auto duration = 0;
+    context.frame_descriptors.clear();
+    context.frame_descriptors.append(ImageFrameDescriptor { bitmap, duration });
 
-    if (context.has_animation) {
+    return {};
+}
+
+static ErrorOr<ImageFrameDescriptor> decode_webp_animation_frame(WebPLoadingContext& context, size_t index)
+{
+    VERIFY(context.state >= WebPLoadingContext::State::HeaderDecoded);
+    VERIFY(context.has_animation);
+
+    if (context.anim_decoder == nullptr) {
         WebPAnimDecoderOptions anim_decoder_options {};
         WebPAnimDecoderOptionsInit(&anim_decoder_options);
         anim_decoder_options.color_mode = MODE_BGRA;
         anim_decoder_options.use_threads = 1;
 
         WebPData webp_data { .bytes = context.data.data(), .size = context.data.size() };
-        auto* anim_decoder = WebPAnimDecoderNew(&webp_data, &anim_decoder_options);
-        if (anim_decoder == nullptr)
+        context.anim_decoder = WebPAnimDecoderNew(&webp_data, &anim_decoder_options);
+        if (context.anim_decoder == nullptr)
             return Error::from_string_literal("Failed to allocate WebPAnimDecoderNew failed");
-        ScopeGuard guard { [=]() { WebPAnimDecoderDelete(anim_decoder); } };
+    }
 
-        int old_timestamp = 0;
-        while (WebPAnimDecoderHasMoreFrames(anim_decoder)) {
-            uint8_t* frame_data = nullptr;
-            int timestamp = 0;
-            if (!WebPAnimDecoderGetNext(anim_decoder, &frame_data, &timestamp))
-                return Error::from_string_literal("Failed to decode animated frame");
+    // NOTE: Each frame is composed on top of the ones before it, so frames can only be decoded in order. Going back
+    //       means starting over from the first frame, which mostly happens when the animation loops.
+    if (index < context.next_frame_index) {
+        WebPAnimDecoderReset(context.anim_decoder);
+        context.next_frame_index = 0;
+        context.previous_timestamp = 0;
+    }
 
-            auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
-            auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, context.size));
+    while (WebPAnimDecoderHasMoreFrames(context.anim_decoder)) {
+        uint8_t* frame_data = nullptr;
+        int timestamp = 0;
+        if (!WebPAnimDecoderGetNext(context.anim_decoder, &frame_data, &timestamp))
+            return Error::from_string_literal("Failed to decode animated frame");
 
-            memcpy(bitmap->scanline_u8(0), frame_data, context.size.width() * context.size.height() * 4);
+        auto frame_index = context.next_frame_index++;
+        auto duration = timestamp - context.previous_timestamp;
+        context.previous_timestamp = timestamp;
 
-            auto duration = timestamp - old_timestamp;
-            old_timestamp = timestamp;
+        if (frame_index < index)
+            continue;
 
-            context.frame_descriptors.append(ImageFrameDescriptor { bitmap, duration });
-        }
-    } else {
         auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
         auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, context.size));
 
-        auto image_data = WebPDecodeBGRAInto(context.data.data(), context.data.size(), bitmap->scanline_u8(0), bitmap->data_size(), bitmap->pitch());
-        if (image_data == nullptr)
-            return Error::from_string_literal("Failed to decode webp image into bitmap");
+        memcpy(bitmap->scanline_u8(0), frame_data, context.size.width() * context.size.height() * 4);
 
-        auto duration = 0;
-        context.frame_descriptors.append(ImageFrameDescriptor { bitmap, duration });
+        return ImageFrameDescriptor { bitmap, duration };
     }
 
-    return {};
+    return Error::from_string_literal("WebPImageDecoderPlugin: Invalid frame index");
 }
 
 bool WebPImageDecoderPlugin::sniff(ReadonlyBytes data)
@@ -204,7 +269,7 @@ size_t WebPImageDecoderPlugin::first_animated_frame_index()
     return 0;
 }
 
-ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index >= frame_count())
         return Error::from_string_literal("WebPImageDecoderPlugin: Invalid frame index");
@@ -212,8 +277,16 @@ ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == WebPLoadingContext::State::Error)
         return Error::from_string_literal("WebPImageDecoderPlugin: Decoding failed");
 
+    if (m_context->has_animation)
+        return decode_webp_animation_frame(*m_context, index);
+
+    // FIXME: Animations are always decoded at their full size, as WebPAnimDecoder can't scale them.
+    auto decoded_size = decoded_size_for_ideal_size(m_context->size, ideal_size);
+    if (m_context->state == WebPLoadingContext::State::BitmapDecoded && m_context->frame_descriptors.first().image->size() != decoded_size)
+        m_context->state = WebPLoadingContext::State::HeaderDecoded;
+
     if (m_context->state < WebPLoadingContext::State::BitmapDecoded) {
-        TRY(decode_webp_image(*m_context));
+        TRY(decode_webp_image(*m_context, decoded_size));
         m_context->state = WebPLoadingContext::State::BitmapDecoded;
     }
 
@@ -6,7 +6,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/QuickSort.h>
 #include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
 #include <LibCore/Timer.h>
 #include <LibIPC/Connection.h>
@@ -49,12 +51,96 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (!m_transport->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
+    // NOTE: Every message starts with its endpoint magic and message ID.
+    if (buffer.data().size() >= sizeof(u32) + sizeof(int)) {
+        u32 endpoint_magic = 0;
+        int message_id = 0;
+        memcpy(&endpoint_magic, buffer.data().data(), sizeof(endpoint_magic));
+        memcpy(&message_id, buffer.data().data() + sizeof(endpoint_magic), sizeof(message_id));
+
+        record_sent_message(endpoint_magic, message_id, buffer.data().size());
+    }
+
     MUST(buffer.transfer_message(*m_transport));
+    schedule_flush();
 
     m_responsiveness_timer->start();
     return {};
 }
 
+void ConnectionBase::schedule_flush()
+{
+    // OPTIMIZATION: Hold on to messages until the end of this event loop turn, so that messages posted in quick
+    //               succession (input events, paint notifications, etc.) are written to the socket together.
+    if (!Core::EventLoop::is_running()) {
+        m_transport->flush();
+        return;
+    }
+
+    if (m_flush_scheduled)
+        return;
+
+    m_flush_scheduled = true;
+    deferred_invoke([this] {
+        m_flush_scheduled = false;
+        m_transport->flush();
+    });
+}
+
+static u64 statistics_key(u32 endpoint_magic, int message_id)
+{
+    return (static_cast<u64>(endpoint_magic) << 32) | static_cast<u32>(message_id);
+}
+
+void ConnectionBase::record_sent_message(u32 endpoint_magic, int message_id, size_t size)
+{
+    m_message_statistics.with_locked([&](auto& message_statistics) {
+        auto& statistics = message_statistics.ensure(statistics_key(endpoint_magic, message_id));
+        ++statistics.sent_count;
+        statistics.sent_bytes += size;
+    });
+}
+
+void ConnectionBase::record_received_message(u32 endpoint_magic, int message_id, size_t size)
+{
+    m_message_statistics.with_locked([&](auto& message_statistics) {
+        auto& statistics = message_statistics.ensure(statistics_key(endpoint_magic, message_id));
+        ++statistics.received_count;
+        statistics.received_bytes += size;
+    });
+}
+
+void ConnectionBase::dump_statistics() const
+{
+    struct Entry {
+        StringView name;
+        MessageStatistics statistics;
+    };
+
+    Vector<Entry> entries;
+    MessageStatistics totals;
+
+    m_message_statistics.with_locked([&](auto const& message_statistics) {
+        for (auto const& [key, statistics] : message_statistics) {
+            entries.append({ message_name(key >> 32, static_cast<int>(key & 0xffffffff)), statistics });
+            totals.sent_count += statistics.sent_count;
+            totals.sent_bytes += statistics.sent_bytes;
+            totals.received_count += statistics.received_count;
+            totals.received_bytes += statistics.received_bytes;
+        }
+    });
+
+    quick_sort(entries, [](auto const& a, auto const& b) {
+        return a.statistics.sent_bytes + a.statistics.received_bytes > b.statistics.sent_bytes + b.statistics.received_bytes;
+    });
+
+    dbgln("IPC statistics for {} ({:p}):", class_name(), this);
+    dbgln("    {:50} {:>10} {:>14} {:>10} {:>14}", "Message"sv, "Sent"sv, "Sent bytes"sv, "Received"sv, "Received bytes"sv);
+    for (auto const& [name, statistics] : entries)
+        dbgln("    {:50} {:>10} {:>14} {:>10} {:>14}", name, statistics.sent_count, statistics.sent_bytes, statistics.received_count, statistics.received_bytes);
+    dbgln("    {:50} {:>10} {:>14} {:>10} {:>14}", "Total"sv, totals.sent_count, totals.sent_bytes, totals.received_count, totals.received_bytes);
+}
+
 void ConnectionBase::shutdown()
 {
     m_transport->close();
@@ -96,6 +182,7 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 {
     auto schedule_shutdown = m_transport->read_as_many_messages_as_possible_without_blocking([&](auto&& raw_message) {
         if (auto message = try_parse_message(raw_message.bytes, raw_message.fds)) {
+            record_received_message(message->endpoint_magic(), message->message_id(), raw_message.bytes.size());
             m_unprocessed_messages.append(message.release_nonnull());
         } else {
             dbgln("Failed to parse IPC message {:hex-dump}", raw_message.bytes);
@@ -121,6 +208,9 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 
 OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id)
 {
+    // The peer can't respond to a message that is still waiting for the end of this event loop turn.
+    m_transport->flush();
+
     for (;;) {
         // Double check we don't already have the event waiting for us.
         // Otherwise we might end up blocked for a while for no reason.
@@ -9,12 +9,14 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/HashMap.h>
 #include <AK/Queue.h>
 #include <LibCore/EventReceiver.h>
 #include <LibIPC/File.h>
 #include <LibIPC/Forward.h>
 #include <LibIPC/Message.h>
 #include <LibIPC/Transport.h>
+#include <LibThreading/MutexProtected.h>
 
 namespace IPC {
 
@@ -33,6 +35,9 @@ public:
 
     Transport& transport() const { return *m_transport; }
 
+    // Prints how many messages of each kind were sent and received over this connection, and how large they were.
+    void dump_statistics() const;
+
 protected:
     explicit ConnectionBase(IPC::Stub&, NonnullOwnPtr<Transport>, u32 local_endpoint_magic);
 
@@ -40,6 +45,7 @@ protected:
     virtual void did_become_responsive() { }
     virtual void shutdown_with_error(Error const&);
     virtual OwnPtr<Message> try_parse_message(ReadonlyBytes, Queue<File>&) = 0;
+    virtual StringView message_name(u32 endpoint_magic, int message_id) const = 0;
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
     void wait_for_transport_to_become_readable();
@@ -47,6 +53,17 @@ protected:
 
     void handle_messages();
 
+    void schedule_flush();
+
+    struct MessageStatistics {
+        u64 sent_count { 0 };
+        u64 sent_bytes { 0 };
+        u64 received_count { 0 };
+        u64 received_bytes { 0 };
+    };
+    void record_sent_message(u32 endpoint_magic, int message_id, size_t size);
+    void record_received_message(u32 endpoint_magic, int message_id, size_t size);
+
     IPC::Stub& m_local_stub;
 
     NonnullOwnPtr<Transport> m_transport;
@@ -56,6 +73,11 @@ protected:
     Vector<NonnullOwnPtr<Message>> m_unprocessed_messages;
 
     u32 m_local_endpoint_magic { 0 };
+
+    bool m_flush_scheduled { false };
+
+    // Keyed by endpoint magic (upper 32 bits) and message ID (lower 32 bits). Messages may be posted from any thread.
+    mutable Threading::MutexProtected<HashMap<u64, MessageStatistics>> m_message_statistics;
 };
 
 template<typename LocalEndpoint, typename PeerEndpoint>
@@ -110,6 +132,15 @@ protected:
 
         return nullptr;
     }
+
+    virtual StringView message_name(u32 endpoint_magic, int message_id) const override
+    {
+        if (endpoint_magic == LocalEndpoint::static_magic())
+            return LocalEndpoint::message_name(message_id);
+        if (endpoint_magic == PeerEndpoint::static_magic())
+            return PeerEndpoint::message_name(message_id);
+        return "(unknown)"sv;
+    }
 };
 
 }
@@ -6,6 +6,7 @@
  */
 
 #include <AK/NonnullOwnPtr.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
 #include <LibIPC/File.h>
@@ -18,13 +19,21 @@ void SendQueue::enqueue_message(Vector<u8>&& bytes, Vector<int>&& fds)
     Threading::MutexLocker locker(m_mutex);
     VERIFY(MUST(m_stream.write_some(bytes.span())) == bytes.size());
     m_fds.append(fds.data(), fds.size());
+}
+
+void SendQueue::flush()
+{
+    Threading::MutexLocker locker(m_mutex);
+    if (m_flushed_bytes_count == m_stream.used_buffer_size())
+        return;
+    m_flushed_bytes_count = m_stream.used_buffer_size();
     m_condition.signal();
 }
 
 SendQueue::Running SendQueue::block_until_message_enqueued()
 {
     Threading::MutexLocker locker(m_mutex);
-    while (m_stream.is_eof() && m_fds.is_empty() && m_running)
+    while (m_flushed_bytes_count == 0 && m_running)
         m_condition.wait();
     return m_running ? Running::Yes : Running::No;
 }
@@ -33,7 +42,7 @@ SendQueue::BytesAndFds SendQueue::peek(size_t max_bytes)
 {
     Threading::MutexLocker locker(m_mutex);
     BytesAndFds result;
-    auto bytes_to_send = min(max_bytes, m_stream.used_buffer_size());
+    auto bytes_to_send = min(max_bytes, m_flushed_bytes_count);
     result.bytes.resize(bytes_to_send);
     m_stream.peek_some(result.bytes);
     result.fds = m_fds;
@@ -44,6 +53,7 @@ void SendQueue::discard(size_t bytes_count, size_t fds_count)
 {
     Threading::MutexLocker locker(m_mutex);
     MUST(m_stream.discard(bytes_count));
+    m_flushed_bytes_count -= bytes_count;
     m_fds.remove(0, fds_count);
 }
 
@@ -63,7 +73,7 @@ TransportSocket::TransportSocket(NonnullOwnPtr<Core::LocalSocket> socket)
             if (send_queue->block_until_message_enqueued() == SendQueue::Running::No)
                 break;
 
-            auto [bytes, fds] = send_queue->peek(4096);
+            auto [bytes, fds] = send_queue->peek(64 * KiB);
             auto fds_count = fds.size();
             ReadonlyBytes remaining_to_send_bytes = bytes;
 
@@ -111,6 +121,46 @@ TransportSocket::~TransportSocket()
 {
     m_send_queue->stop();
     (void)m_send_thread->join();
+
+    // NOTE: Messages posted during the current event loop turn haven't been flushed yet, as the flush is scheduled for
+    //       the end of the turn. Send them now, so that e.g. the last messages of a connection that is being torn down
+    //       aren't lost.
+    send_remaining_messages();
+}
+
+void TransportSocket::send_remaining_messages()
+{
+    static constexpr int POLL_TIMEOUT_MS = 1000;
+
+    m_send_queue->flush();
+
+    Threading::RWLockLocker<Threading::LockMode::Read> lock(m_socket_rw_lock);
+    while (m_socket->is_open()) {
+        auto [bytes, fds] = m_send_queue->peek(64 * KiB);
+        if (bytes.is_empty())
+            break;
+
+        auto fds_count = fds.size();
+        ReadonlyBytes remaining_to_send_bytes = bytes;
+        if (auto result = send_message(*m_socket, remaining_to_send_bytes, fds); result.is_error()) {
+            if (!result.error().is_errno() || result.error().code() != EPIPE)
+                dbgln("TransportSocket::send_remaining_messages: {}", result.error());
+            break;
+        }
+        m_send_queue->discard(bytes.size() - remaining_to_send_bytes.size(), fds_count - fds.size());
+
+        if (remaining_to_send_bytes.is_empty())
+            continue;
+
+        // The peer isn't reading, give up rather than blocking forever.
+        Vector<struct pollfd, 1> pollfds;
+        pollfds.append({ .fd = m_socket->fd().value(), .events = POLLOUT, .revents = 0 });
+        auto result = Core::System::poll(pollfds, POLL_TIMEOUT_MS);
+        if (result.is_error() && result.error().code() == EINTR)
+            continue;
+        if (result.is_error() || result.value() == 0)
+            break;
+    }
 }
 
 void TransportSocket::set_up_read_hook(Function<void()> hook)
@@ -149,6 +199,9 @@ struct MessageHeader {
     enum class Type : u8 {
         Payload = 0,
         FileDescriptorAcknowledgement = 1,
+        // The payload lives in shared memory, whose file descriptor is sent ahead of the message's own. The message
+        // itself only carries the size of the payload.
+        SharedMemoryPayload = 2,
     };
     Type type { Type::Payload };
     u32 payload_size { 0 };
@@ -157,6 +210,13 @@ struct MessageHeader {
 
 void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const& fds)
 {
+    if (bytes_to_write.size() >= SHARED_MEMORY_PAYLOAD_THRESHOLD) {
+        auto result = post_message_through_shared_memory(bytes_to_write, fds);
+        if (!result.is_error())
+            return;
+        dbgln("TransportSocket::post_message: Unable to use shared memory, falling back to the socket: {}", result.error());
+    }
+
     Vector<u8> message_buffer;
     message_buffer.resize(sizeof(MessageHeader) + bytes_to_write.size());
     MessageHeader header;
@@ -181,6 +241,55 @@ void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<Nonn
     m_send_queue->enqueue_message(move(message_buffer), move(raw_fds));
 }
 
+ErrorOr<void> TransportSocket::post_message_through_shared_memory(Vector<u8> const& bytes_to_write, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const& fds)
+{
+    auto payload = TRY(Core::AnonymousBuffer::create_with_size(bytes_to_write.size()));
+    memcpy(payload.data<void>(), bytes_to_write.data(), bytes_to_write.size());
+
+    // NOTE: The buffer closes its own file descriptor once we're done with it, but the peer can only map the payload
+    //       after it has received the message.
+    auto payload_fd = adopt_ref(*new AutoCloseFileDescriptor(TRY(Core::System::dup(payload.fd()))));
+
+    u64 payload_size = bytes_to_write.size();
+
+    Vector<u8> message_buffer;
+    message_buffer.resize(sizeof(MessageHeader) + sizeof(payload_size));
+    MessageHeader header;
+    header.payload_size = sizeof(payload_size);
+    header.fd_count = fds.size() + 1;
+    header.type = MessageHeader::Type::SharedMemoryPayload;
+    memcpy(message_buffer.data(), &header, sizeof(MessageHeader));
+    memcpy(message_buffer.data() + sizeof(MessageHeader), &payload_size, sizeof(payload_size));
+
+    m_fds_retained_until_received_by_peer.enqueue(payload_fd);
+    for (auto const& fd : fds)
+        m_fds_retained_until_received_by_peer.enqueue(fd);
+
+    Vector<int> raw_fds;
+    raw_fds.ensure_capacity(fds.size() + 1);
+    raw_fds.unchecked_append(payload_fd->value());
+    for (auto const& fd : fds)
+        raw_fds.unchecked_append(fd->value());
+
+    m_send_queue->enqueue_message(move(message_buffer), move(raw_fds));
+    return {};
+}
+
+void TransportSocket::flush()
+{
+    m_send_queue->flush();
+}
+
+static ErrorOr<Core::AnonymousBuffer> map_shared_memory_payload(File& file, u64 payload_size)
+{
+    // NOTE: Mapping past the end of the file would crash us once we touch it, so make sure the peer isn't lying.
+    auto stat = TRY(Core::System::fstat(file.fd()));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < payload_size)
+        return Error::from_string_literal("Shared memory payload is smaller than advertised");
+
+    return Core::AnonymousBuffer::create_from_anon_fd(file.take_fd(), payload_size);
+}
+
 ErrorOr<void> TransportSocket::send_message(Core::LocalSocket& socket, ReadonlyBytes& bytes_to_write, Vector<int>& unowned_fds)
 {
     auto num_fds_to_transfer = unowned_fds.size();
@@ -247,7 +356,7 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
     u32 received_fd_count = 0;
     u32 acknowledged_fd_count = 0;
     size_t index = 0;
-    while (index + sizeof(MessageHeader) <= m_unprocessed_bytes.size()) {
+    while (!m_peer_sent_malformed_message && index + sizeof(MessageHeader) <= m_unprocessed_bytes.size()) {
         MessageHeader header;
         memcpy(&header, m_unprocessed_bytes.data() + index, sizeof(MessageHeader));
         if (header.type == MessageHeader::Type::Payload) {
@@ -261,6 +370,34 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
                 message.fds.enqueue(m_unprocessed_fds.dequeue());
             message.bytes.append(m_unprocessed_bytes.data() + index + sizeof(MessageHeader), header.payload_size);
             callback(move(message));
+        } else if (header.type == MessageHeader::Type::SharedMemoryPayload) {
+            if (header.payload_size != sizeof(u64) || header.fd_count == 0) {
+                dbgln("TransportSocket::read_as_many_messages_as_possible_without_blocking: Malformed shared memory payload message");
+                m_peer_sent_malformed_message = true;
+                break;
+            }
+            if (header.payload_size + sizeof(MessageHeader) > m_unprocessed_bytes.size() - index)
+                break;
+            if (header.fd_count > m_unprocessed_fds.size())
+                break;
+
+            u64 payload_size = 0;
+            memcpy(&payload_size, m_unprocessed_bytes.data() + index + sizeof(MessageHeader), sizeof(payload_size));
+
+            received_fd_count += header.fd_count;
+            auto payload_file = m_unprocessed_fds.dequeue();
+            Message message;
+            for (size_t i = 1; i < header.fd_count; ++i)
+                message.fds.enqueue(m_unprocessed_fds.dequeue());
+
+            auto payload = map_shared_memory_payload(payload_file, payload_size);
+            if (payload.is_error()) {
+                dbgln("TransportSocket::read_as_many_messages_as_possible_without_blocking: {}", payload.error());
+                m_peer_sent_malformed_message = true;
+                break;
+            }
+            message.bytes.append(payload.value().data<u8>(), payload_size);
+            callback(move(message));
         } else if (header.type == MessageHeader::Type::FileDescriptorAcknowledgement) {
             VERIFY(header.payload_size == 0);
             acknowledged_fd_count += header.fd_count;
@@ -270,6 +407,10 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
         index += header.payload_size + sizeof(MessageHeader);
     }
 
+    // NOTE: A peer that sent us something we can't make sense of can't be trusted with the rest of the connection.
+    if (m_peer_sent_malformed_message)
+        should_shutdown = true;
+
     if (should_shutdown)
         return ShouldShutdown::Yes;
 
@@ -289,6 +430,7 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
         header.type = MessageHeader::Type::FileDescriptorAcknowledgement;
         memcpy(message_buffer.data(), &header, sizeof(MessageHeader));
         m_send_queue->enqueue_message(move(message_buffer), {});
+        m_send_queue->flush();
     }
 
     if (index < m_unprocessed_bytes.size()) {
@@ -52,7 +52,10 @@ public:
     Running block_until_message_enqueued();
     void stop();
 
+    // Messages are only handed to the send thread once they are flushed, so that messages posted in quick succession
+    // go out in as few writes as possible.
     void enqueue_message(Vector<u8>&& bytes, Vector<int>&& fds);
+    void flush();
     struct BytesAndFds {
         Vector<u8> bytes;
         Vector<int> fds;
@@ -62,6 +65,7 @@ public:
 
 private:
     AllocatingMemoryStream m_stream;
+    size_t m_flushed_bytes_count { 0 };
     Vector<int> m_fds;
     Threading::Mutex m_mutex;
     Threading::ConditionVariable m_condition { m_mutex };
@@ -75,6 +79,10 @@ class TransportSocket {
 public:
     static constexpr socklen_t SOCKET_BUFFER_SIZE = 128 * KiB;
 
+    // Payloads that wouldn't fit into the socket buffer are sent through shared memory instead, which takes a handful
+    // of syscalls rather than one per few kilobytes on either end.
+    static constexpr size_t SHARED_MEMORY_PAYLOAD_THRESHOLD = SOCKET_BUFFER_SIZE;
+
     explicit TransportSocket(NonnullOwnPtr<Core::LocalSocket> socket);
     ~TransportSocket();
 
@@ -85,6 +93,7 @@ public:
     void wait_until_readable();
 
     void post_message(Vector<u8> const&, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const&);
+    void flush();
 
     enum class ShouldShutdown {
         No,
@@ -103,11 +112,14 @@ public:
 
 private:
     static ErrorOr<void> send_message(Core::LocalSocket&, ReadonlyBytes& bytes, Vector<int>& unowned_fds);
+    ErrorOr<void> post_message_through_shared_memory(Vector<u8> const&, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const&);
+    void send_remaining_messages();
 
     NonnullOwnPtr<Core::LocalSocket> m_socket;
     mutable Threading::RWLock m_socket_rw_lock;
     ByteBuffer m_unprocessed_bytes;
     Queue<File> m_unprocessed_fds;
+    bool m_peer_sent_malformed_message { false };
 
     // After file descriptor is sent, it is moved to the wait queue until an acknowledgement is received from the peer.
     // This is necessary to handle a specific behavior of the macOS kernel, which may prematurely garbage-collect the file
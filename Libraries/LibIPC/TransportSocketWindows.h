@@ -28,6 +28,9 @@ public:
 
     ErrorOr<void> transfer(Bytes, Vector<size_t> const& handle_offsets);
 
+    // Messages are written to the socket as soon as they are transferred, so there is nothing to flush.
+    void flush() { }
+
     struct [[nodiscard]] ReadResult {
         Vector<u8> bytes;
         Vector<int> fds; // always empty, present to avoid OS #ifdefs in Connection.cpp
@@ -20,6 +20,8 @@ void Client::die()
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
     }
     m_pending_decoded_images.clear();
+    m_animation_sessions.clear();
+    m_progressive_decodes.clear();
 }
 
 NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
@@ -57,7 +59,29 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space)
+ErrorOr<NonnullRefPtr<ProgressiveDecode>> Client::start_progressive_decode(Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::StartProgressiveDecode>(ideal_size, move(mime_type));
+    if (!response) {
+        dbgln("ImageDecoder disconnected trying to start decoding image");
+        return Error::from_string_literal("ImageDecoder disconnected");
+    }
+
+    auto promise = Core::Promise<DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    auto image_id = response->image_id();
+    m_pending_decoded_images.set(image_id, move(promise));
+
+    auto progressive_decode = adopt_ref(*new ProgressiveDecode(*this, image_id));
+    m_progressive_decodes.set(image_id, progressive_decode.ptr());
+    return progressive_decode;
+}
+
+void Client::did_decode_image(i64 image_id, Gfx::IntSize size, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space)
 {
     auto bitmaps = move(bitmap_sequence.bitmaps);
     VERIFY(!bitmaps.is_empty());
@@ -65,13 +89,17 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     auto maybe_promise = m_pending_decoded_images.take(image_id);
     if (!maybe_promise.has_value()) {
         dbgln("ImageDecoderClient: No pending image with ID {}", image_id);
+        if (bitmaps.size() < frame_count)
+            async_end_animation_session(image_id);
         return;
     }
     auto promise = maybe_promise.release_value();
 
     DecodedImage image;
+    image.size = size;
     image.is_animated = is_animated;
     image.loop_count = loop_count;
+    image.frame_count = frame_count;
     image.scale = scale;
     image.frames.ensure_capacity(bitmaps.size());
     image.color_space = move(color_space);
@@ -85,9 +113,56 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
         image.frames.empend(bitmaps[i].release_nonnull(), durations[i]);
     }
 
+    // NOTE: ImageDecoder holds on to the decoder of an animation that it only decoded the first frame of, until the
+    //       session is destroyed.
+    if (image.frames.size() < frame_count) {
+        image.animation_session = adopt_ref(*new AnimationSession(*this, image_id));
+        m_animation_sessions.set(image_id, image.animation_session.ptr());
+
+        durations.resize(frame_count);
+        image.frame_durations = move(durations);
+    }
+
     promise->resolve(move(image));
 }
 
+void Client::did_decode_partial_image(i64 image_id, Gfx::BitmapSequence bitmap_sequence)
+{
+    auto progressive_decode = m_progressive_decodes.get(image_id);
+    if (!progressive_decode.has_value())
+        return;
+
+    auto& bitmaps = bitmap_sequence.bitmaps;
+    if (bitmaps.is_empty() || !bitmaps.first()) {
+        dbgln("ImageDecoderClient: Invalid partial bitmap for request {}", image_id);
+        return;
+    }
+
+    if (progressive_decode.value()->on_partial_image)
+        progressive_decode.value()->on_partial_image(bitmaps.first().release_nonnull());
+}
+
+void Client::did_decode_animation_frames(i64 image_id, u32 first_frame_index, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations)
+{
+    auto session = m_animation_sessions.get(image_id);
+    if (!session.has_value())
+        return;
+
+    auto& bitmaps = bitmap_sequence.bitmaps;
+    if (bitmaps.size() != durations.size()) {
+        dbgln("ImageDecoderClient: Mismatched frame count for animation {}", image_id);
+        return;
+    }
+
+    for (size_t i = 0; i < bitmaps.size(); ++i) {
+        // NOTE: Frames that failed to decode are left out, the animation will keep showing the frame before them.
+        if (!bitmaps[i])
+            continue;
+        if (session.value()->on_frame_decoded)
+            session.value()->on_frame_decoded(first_frame_index + i, Frame { bitmaps[i].release_nonnull(), durations[i] });
+    }
+}
+
 void Client::did_fail_to_decode_image(i64 image_id, String error_message)
 {
     auto maybe_promise = m_pending_decoded_images.take(image_id);
@@ -102,4 +177,83 @@ void Client::did_fail_to_decode_image(i64 image_id, String error_message)
     promise->reject(Error::from_string_literal("Image decoding failed or aborted"));
 }
 
+AnimationSession::AnimationSession(Client& client, i64 image_id)
+    : m_client(client)
+    , m_image_id(image_id)
+{
+}
+
+AnimationSession::~AnimationSession()
+{
+    if (!m_client)
+        return;
+
+    m_client->m_animation_sessions.remove(m_image_id);
+    if (m_client->is_open())
+        m_client->async_end_animation_session(m_image_id);
+}
+
+void AnimationSession::request_frames(u32 first_frame_index, u32 count)
+{
+    if (!m_client || !m_client->is_open())
+        return;
+    m_client->async_request_animation_frames(m_image_id, first_frame_index, count);
+}
+
+ProgressiveDecode::ProgressiveDecode(Client& client, i64 image_id)
+    : m_client(client)
+    , m_image_id(image_id)
+{
+}
+
+ProgressiveDecode::~ProgressiveDecode()
+{
+    if (!m_client)
+        return;
+
+    m_client->m_progressive_decodes.remove(m_image_id);
+    if (!m_is_finished) {
+        if (auto promise = m_client->m_pending_decoded_images.take(m_image_id); promise.has_value())
+            promise.value()->reject(Error::from_string_literal("Image decoding aborted"));
+        if (m_client->is_open())
+            m_client->async_cancel_decoding(m_image_id);
+    }
+}
+
+void ProgressiveDecode::append(ReadonlyBytes bytes)
+{
+    VERIFY(!m_is_finished);
+    if (bytes.is_empty() || !m_client || !m_client->is_open())
+        return;
+
+    auto buffer_or_error = ByteBuffer::copy(bytes);
+    if (buffer_or_error.is_error()) {
+        dbgln("ImageDecoderClient: Could not copy encoded data: {}", buffer_or_error.error());
+
+        // NOTE: Without this data, the image can't be decoded anymore.
+        if (auto promise = m_client->m_pending_decoded_images.take(m_image_id); promise.has_value())
+            promise.value()->reject(buffer_or_error.release_error());
+        m_client->m_progressive_decodes.remove(m_image_id);
+        m_client->async_cancel_decoding(m_image_id);
+        m_client = nullptr;
+        return;
+    }
+    m_client->async_append_progressive_decode_data(m_image_id, buffer_or_error.release_value());
+}
+
+void ProgressiveDecode::finish()
+{
+    VERIFY(!m_is_finished);
+    m_is_finished = true;
+
+    if (!m_client || !m_client->is_open())
+        return;
+
+    // NOTE: Partial images that are still on their way are of no use once the whole image is being decoded.
+    m_client->m_progressive_decodes.remove(m_image_id);
+    on_partial_image = nullptr;
+
+    m_client->async_finish_progressive_decode(m_image_id);
+}
+
 }
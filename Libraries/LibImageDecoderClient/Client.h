@@ -15,17 +15,29 @@
 
 namespace ImageDecoderClient {
 
+class AnimationSession;
+class ProgressiveDecode;
+
 struct Frame {
     NonnullRefPtr<Gfx::Bitmap> bitmap;
     u32 duration { 0 };
 };
 
 struct DecodedImage {
+    // The size of the image. Its frames are smaller than this if it was decoded for a smaller ideal size.
+    Gfx::IntSize size;
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
     u32 loop_count { 0 };
+    u32 frame_count { 0 };
     Vector<Frame> frames;
     Gfx::ColorSpace color_space;
+
+    // Only set for animations, in which case `frames` only holds the first frame.
+    RefPtr<AnimationSession> animation_session;
+
+    // The durations of every frame of such an animation, or 0 for frames whose duration is only known once decoded.
+    Vector<u32> frame_durations;
 };
 
 class Client final
@@ -40,15 +52,66 @@ public:
 
     NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
 
+    // Starts decoding an image whose encoded data is still arriving. The data is handed over with ProgressiveDecode::append(),
+    // and the promise is settled once ProgressiveDecode::finish() has been called and the whole image has been decoded.
+    ErrorOr<NonnullRefPtr<ProgressiveDecode>> start_progressive_decode(Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+
     Function<void()> on_death;
 
 private:
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space) override;
+    virtual void did_decode_image(i64 image_id, Gfx::IntSize size, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space) override;
     virtual void did_fail_to_decode_image(i64 image_id, String error_message) override;
+    virtual void did_decode_partial_image(i64 image_id, Gfx::BitmapSequence bitmap_sequence) override;
+    virtual void did_decode_animation_frames(i64 image_id, u32 first_frame_index, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations) override;
+
+    friend class AnimationSession;
+    friend class ProgressiveDecode;
 
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+    HashMap<i64, AnimationSession*> m_animation_sessions;
+    HashMap<i64, ProgressiveDecode*> m_progressive_decodes;
+};
+
+// Decodes the remaining frames of an animation as they are asked for. ImageDecoder keeps its decoder for the image
+// around until the session is destroyed.
+class AnimationSession : public RefCounted<AnimationSession> {
+public:
+    ~AnimationSession();
+
+    void request_frames(u32 first_frame_index, u32 count);
+
+    Function<void(u32 frame_index, Frame)> on_frame_decoded;
+
+private:
+    friend class Client;
+
+    AnimationSession(Client&, i64 image_id);
+
+    WeakPtr<Client> m_client;
+    i64 m_image_id { 0 };
+};
+
+// Hands the encoded data of an image to ImageDecoder while it is still arriving, and reports what has been decoded of it
+// so far. ImageDecoder gives up on the image if this is destroyed before finish() is called.
+class ProgressiveDecode : public RefCounted<ProgressiveDecode> {
+public:
+    ~ProgressiveDecode();
+
+    void append(ReadonlyBytes);
+    void finish();
+
+    Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image;
+
+private:
+    friend class Client;
+
+    ProgressiveDecode(Client&, i64 image_id);
+
+    WeakPtr<Client> m_client;
+    i64 m_image_id { 0 };
+    bool m_is_finished { false };
 };
 
 }
@@ -13,4 +13,6 @@ class RequestClient;
 class WebSocket;
 struct RequestTimingInfo;
 
+enum class ResponseBodyTransport;
+
 }
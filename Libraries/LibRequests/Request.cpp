@@ -28,6 +28,12 @@ bool Request::stop()
     return m_client->stop_request({}, *this);
 }
 
+void Request::set_priority(::RequestServer::RequestPriority priority)
+{
+    if (m_client)
+        m_client->set_request_priority({}, *this, priority);
+}
+
 void Request::set_request_fd(Badge<Requests::RequestClient>, int fd)
 {
     // If the request was stopped while this IPC was in-flight, just bail.
@@ -44,6 +50,12 @@ void Request::set_request_fd(Badge<Requests::RequestClient>, int fd)
     m_internal_stream_data->read_stream = move(stream);
 }
 
+void Request::set_response_body_ring(Badge<RequestClient>, ResponseBodyRing ring)
+{
+    VERIFY(m_fd == -1);
+    m_response_body_ring = move(ring);
+}
+
 void Request::set_buffered_request_finished_callback(BufferedRequestFinished on_buffered_request_finished)
 {
     VERIFY(m_mode == Mode::Unknown);
@@ -151,19 +163,25 @@ void Request::set_up_internal_stream_data(DataReceived on_data_available)
         if (!m_internal_stream_data)
             return;
 
-        do {
-            auto result = m_internal_stream_data->read_stream->read_some({ buffer, buffer_size });
-            if (result.is_error() && (!result.error().is_errno() || (result.error().is_errno() && result.error().code() != EINTR)))
-                break;
-            if (result.is_error())
-                continue;
-
-            auto read_bytes = result.release_value();
-            if (read_bytes.is_empty())
-                break;
-
-            on_data_available(read_bytes);
-        } while (true);
+        if (m_response_body_ring.has_value()) {
+            read_from_response_body_ring(on_data_available);
+            if (!m_internal_stream_data)
+                return;
+        } else {
+            do {
+                auto result = m_internal_stream_data->read_stream->read_some({ buffer, buffer_size });
+                if (result.is_error() && (!result.error().is_errno() || (result.error().is_errno() && result.error().code() != EINTR)))
+                    break;
+                if (result.is_error())
+                    continue;
+
+                auto read_bytes = result.release_value();
+                if (read_bytes.is_empty())
+                    break;
+
+                on_data_available(read_bytes);
+            } while (true);
+        }
 
         if (m_internal_stream_data->read_stream->is_eof())
             m_internal_stream_data->read_notifier->close();
@@ -173,4 +191,37 @@ void Request::set_up_internal_stream_data(DataReceived on_data_available)
     };
 }
 
+void Request::read_from_response_body_ring(DataReceived const& on_data_available)
+{
+    // NOTE: The fd only carries doorbell bytes (and EOF once the whole body is in the ring), so just drain it.
+    u8 doorbell_buffer[64];
+    while (true) {
+        auto result = m_internal_stream_data->read_stream->read_some({ doorbell_buffer, sizeof(doorbell_buffer) });
+        if (result.is_error() && result.error().is_errno() && result.error().code() == EINTR)
+            continue;
+        if (result.is_error() || result.value().is_empty())
+            break;
+    }
+
+    auto& ring = *m_response_body_ring;
+    while (true) {
+        auto bytes = ring.readable_bytes();
+        if (bytes.is_empty()) {
+            if (ring.should_wait_for_data())
+                break;
+            continue;
+        }
+
+        on_data_available(bytes);
+
+        // If the request was stopped by the callback, there is nobody left to read the rest of the body.
+        if (!m_internal_stream_data)
+            return;
+
+        ring.did_read(bytes.size());
+        if (ring.take_producer_waiting() && m_client)
+            m_client->response_body_ring_has_space({}, *this);
+    }
+}
+
 }
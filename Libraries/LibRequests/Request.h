@@ -16,6 +16,8 @@
 #include <LibHTTP/HeaderMap.h>
 #include <LibRequests/NetworkError.h>
 #include <LibRequests/RequestTimingInfo.h>
+#include <LibRequests/ResponseBodyRing.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Requests {
 
@@ -37,6 +39,9 @@ public:
     int fd() const { return m_fd; }
     bool stop();
 
+    // Ask RequestServer to (de)prioritize this request, e.g. because the element that needs it became visible.
+    void set_priority(::RequestServer::RequestPriority);
+
     using BufferedRequestFinished = Function<void(u64 total_size, RequestTimingInfo const& timing_info, Optional<NetworkError> const& network_error, HTTP::HeaderMap const& response_headers, Optional<u32> response_code, Optional<String> reason_phrase, ReadonlyBytes payload)>;
 
     // Configure the request such that the entirety of the response data is buffered. The callback receives that data and
@@ -59,17 +64,22 @@ public:
 
     RefPtr<Core::Notifier>& write_notifier(Badge<RequestClient>) { return m_write_notifier; }
     void set_request_fd(Badge<RequestClient>, int fd);
+    void set_response_body_ring(Badge<RequestClient>, ResponseBodyRing);
 
 private:
     explicit Request(RequestClient&, i32 request_id);
 
     void set_up_internal_stream_data(DataReceived on_data_available);
+    void read_from_response_body_ring(DataReceived const& on_data_available);
 
     WeakPtr<RequestClient> m_client;
     int m_request_id { -1 };
     RefPtr<Core::Notifier> m_write_notifier;
     int m_fd { -1 };
 
+    // If set, RequestServer writes the response body into this ring, and the fd is only used to wake us up.
+    Optional<ResponseBodyRing> m_response_body_ring;
+
     enum class Mode {
         Buffered,
         Unbuffered,
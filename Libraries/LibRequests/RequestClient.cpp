@@ -28,17 +28,31 @@ void RequestClient::ensure_connection(URL::URL const& url, ::RequestServer::Cach
     async_ensure_connection(url, cache_level);
 }
 
-RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy_data)
+RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy_data, Optional<ByteString> const& cache_partition_key, ::RequestServer::RequestPriority priority, ResponseBodyTransport response_body_transport)
 {
     auto body_result = ByteBuffer::copy(request_body);
     if (body_result.is_error())
         return nullptr;
 
+    Optional<ResponseBodyRing> response_body_ring;
+    if (response_body_transport == ResponseBodyTransport::SharedMemoryRing) {
+        if (auto ring = ResponseBodyRing::create(); !ring.is_error())
+            response_body_ring = ring.release_value();
+        else
+            dbgln("RequestClient: Unable to create response body ring, falling back to a pipe: {}", ring.error());
+    }
+
+    Optional<Core::AnonymousBuffer> response_body_ring_buffer;
+    if (response_body_ring.has_value())
+        response_body_ring_buffer = response_body_ring->buffer();
+
     static i32 s_next_request_id = 0;
     auto request_id = s_next_request_id++;
 
-    IPCProxy::async_start_request(request_id, method, url, request_headers, body_result.release_value(), proxy_data);
+    IPCProxy::async_start_request(request_id, method, url, request_headers, body_result.release_value(), proxy_data, cache_partition_key, priority, move(response_body_ring_buffer));
     auto request = Request::create_from_id({}, *this, request_id);
+    if (response_body_ring.has_value())
+        request->set_response_body_ring({}, response_body_ring.release_value());
     m_requests.set(request_id, request);
     return request;
 }
@@ -69,6 +83,20 @@ bool RequestClient::set_certificate(Badge<Request>, Request& request, ByteString
     return IPCProxy::set_certificate(request.id(), move(certificate), move(key));
 }
 
+void RequestClient::set_request_priority(Badge<Request>, Request& request, ::RequestServer::RequestPriority priority)
+{
+    if (!m_requests.contains(request.id()))
+        return;
+    async_set_request_priority(request.id(), priority);
+}
+
+void RequestClient::response_body_ring_has_space(Badge<Request>, Request& request)
+{
+    if (!m_requests.contains(request.id()))
+        return;
+    async_response_body_ring_has_space(request.id());
+}
+
 void RequestClient::request_finished(i32 request_id, u64 total_size, RequestTimingInfo timing_info, Optional<NetworkError> network_error)
 {
     RefPtr<Request> request;
@@ -19,6 +19,11 @@ namespace Requests {
 
 class Request;
 
+enum class ResponseBodyTransport {
+    Pipe,
+    SharedMemoryRing,
+};
+
 class RequestClient final
     : public IPC::ConnectionToServer<RequestClientEndpoint, RequestServerEndpoint>
     , public RequestClientEndpoint {
@@ -30,7 +35,7 @@ public:
     explicit RequestClient(NonnullOwnPtr<IPC::Transport>);
     virtual ~RequestClient() override;
 
-    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {});
+    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {}, Optional<ByteString> const& cache_partition_key = {}, ::RequestServer::RequestPriority = ::RequestServer::RequestPriority::Medium, ResponseBodyTransport = ResponseBodyTransport::Pipe);
 
     RefPtr<WebSocket> websocket_connect(const URL::URL&, ByteString const& origin = {}, Vector<ByteString> const& protocols = {}, Vector<ByteString> const& extensions = {}, HTTP::HeaderMap const& request_headers = {});
 
@@ -38,6 +43,8 @@ public:
 
     bool stop_request(Badge<Request>, Request&);
     bool set_certificate(Badge<Request>, Request&, ByteString, ByteString);
+    void set_request_priority(Badge<Request>, Request&, ::RequestServer::RequestPriority);
+    void response_body_ring_has_space(Badge<Request>, Request&);
 
 private:
     virtual void die() override;
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace Requests {
+
+// A single-producer, single-consumer ring of response body bytes in shared memory. RequestServer copies the data it
+// receives straight into the ring, and the client hands out spans of the ring to whoever consumes the body, instead of
+// both sides copying the body through a pipe in small pieces.
+//
+// Each side keeps its own position privately and only reads the other side's position from shared memory, so a
+// misbehaving peer can stall the ring but can't make us read or write outside of it.
+//
+// The ring itself has no way to wake up the other side. RequestServer keeps using the pipe handed out with
+// request_started as a doorbell: it writes a byte to it when the client is waiting for data, and closes it once the
+// whole body is in the ring. In the other direction, the client tells RequestServer over IPC when it has made room
+// for a waiting producer.
+class ResponseBodyRing {
+public:
+    static constexpr size_t default_capacity = 1 * MiB;
+
+    static ErrorOr<ResponseBodyRing> create(size_t capacity = default_capacity)
+    {
+        auto buffer = TRY(Core::AnonymousBuffer::create_with_size(sizeof(Header) + capacity));
+        new (buffer.data<void>()) Header;
+        return ResponseBodyRing { move(buffer) };
+    }
+
+    static ErrorOr<ResponseBodyRing> adopt(Core::AnonymousBuffer buffer)
+    {
+        if (!buffer.is_valid() || buffer.size() <= sizeof(Header))
+            return Error::from_string_literal("Response body ring is too small");
+        return ResponseBodyRing { move(buffer) };
+    }
+
+    Core::AnonymousBuffer const& buffer() const { return m_buffer; }
+    size_t capacity() const { return m_capacity; }
+
+    // Producer side.
+
+    size_t available_to_write() const
+    {
+        auto read_position = header().read_position.load();
+        if (read_position > m_write_position || m_write_position - read_position > m_capacity)
+            return 0;
+        return m_capacity - (m_write_position - read_position);
+    }
+
+    size_t write_some(ReadonlyBytes bytes)
+    {
+        auto size = min(bytes.size(), available_to_write());
+        auto offset = m_write_position % m_capacity;
+        auto size_before_wrap = min(size, m_capacity - offset);
+
+        __builtin_memcpy(data() + offset, bytes.data(), size_before_wrap);
+        __builtin_memcpy(data(), bytes.data() + size_before_wrap, size - size_before_wrap);
+
+        m_write_position += size;
+        header().write_position.store(m_write_position);
+        return size;
+    }
+
+    // Returns true if fewer than `size` bytes can be written. In that case, the consumer will tell us once it has read
+    // from the ring.
+    [[nodiscard]] bool should_wait_for_space(size_t size)
+    {
+        if (available_to_write() >= size)
+            return false;
+
+        header().producer_waiting.store(true);
+
+        // The consumer may have made room before it could see that we are waiting.
+        if (available_to_write() >= size) {
+            header().producer_waiting.store(false);
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool take_consumer_waiting() { return header().consumer_waiting.exchange(false); }
+
+    // Consumer side.
+
+    // Returns the longest contiguous span of unread bytes, which stays valid until did_read() is called.
+    ReadonlyBytes readable_bytes() const
+    {
+        auto write_position = header().write_position.load();
+        if (write_position < m_read_position || write_position - m_read_position > m_capacity)
+            return {};
+
+        auto offset = m_read_position % m_capacity;
+        return { data() + offset, min(write_position - m_read_position, m_capacity - offset) };
+    }
+
+    void did_read(size_t size)
+    {
+        m_read_position += size;
+        header().read_position.store(m_read_position);
+    }
+
+    // Returns true if there is nothing to read. In that case, the producer will ring the doorbell once it has written
+    // to the ring.
+    [[nodiscard]] bool should_wait_for_data()
+    {
+        if (!readable_bytes().is_empty())
+            return false;
+
+        header().consumer_waiting.store(true);
+
+        // The producer may have written to the ring before it could see that we are waiting.
+        if (!readable_bytes().is_empty()) {
+            header().consumer_waiting.store(false);
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool take_producer_waiting() { return header().producer_waiting.exchange(false); }
+
+private:
+    struct Header {
+        AK_CACHE_ALIGNED Atomic<u64> write_position { 0 };
+        AK_CACHE_ALIGNED Atomic<u64> read_position { 0 };
+        AK_CACHE_ALIGNED Atomic<bool> producer_waiting { false };
+
+        // NOTE: The consumer starts out waiting, so that the first write rings the doorbell.
+        Atomic<bool> consumer_waiting { true };
+    };
+
+    explicit ResponseBodyRing(Core::AnonymousBuffer buffer)
+        : m_buffer(move(buffer))
+        , m_capacity(m_buffer.size() - sizeof(Header))
+    {
+    }
+
+    // NOTE: The header is shared with the other process, so it's never really const.
+    Header& header() const { return *static_cast<Header*>(const_cast<void*>(m_buffer.data<void>())); }
+
+    u8* data() { return m_buffer.data<u8>() + sizeof(Header); }
+    u8 const* data() const { return m_buffer.data<u8>() + sizeof(Header); }
+
+    Core::AnonymousBuffer m_buffer;
+    size_t m_capacity { 0 };
+    u64 m_write_position { 0 };
+    u64 m_read_position { 0 };
+};
+
+}
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Queue.h>
+#include <AK/Vector.h>
 #include <LibThreading/BackgroundAction.h>
 #include <LibThreading/Mutex.h>
 #include <LibThreading/Thread.h>
@@ -13,28 +14,27 @@
 static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_cond_t s_condition = PTHREAD_COND_INITIALIZER;
 static Queue<Function<void()>>* s_all_actions;
-static Threading::Thread* s_background_thread;
+static Vector<NonnullRefPtr<Threading::Thread>>* s_background_threads;
+static size_t s_background_thread_count = 1;
 static Atomic<bool> s_background_thread_should_run = true;
 
 static intptr_t background_thread_func()
 {
-    Vector<Function<void()>> actions;
     while (s_background_thread_should_run.load(AK::MemoryOrder::memory_order_acquire)) {
         pthread_mutex_lock(&s_mutex);
 
         while (s_all_actions->is_empty() && s_background_thread_should_run.load(AK::MemoryOrder::memory_order_acquire))
             pthread_cond_wait(&s_condition, &s_mutex);
 
-        while (!s_all_actions->is_empty())
-            actions.append(s_all_actions->dequeue());
+        // NOTE: Only take one action at a time, so that any other background threads can pick up the rest.
+        Function<void()> action;
+        if (!s_all_actions->is_empty())
+            action = s_all_actions->dequeue();
 
         pthread_mutex_unlock(&s_mutex);
 
-        for (auto& action : actions) {
-            if (s_background_thread_should_run.load(AK::MemoryOrder::memory_order_acquire))
-                action();
-        }
-        actions.clear();
+        if (action && s_background_thread_should_run.load(AK::MemoryOrder::memory_order_acquire))
+            action();
     }
     return 0;
 }
@@ -42,13 +42,26 @@ static intptr_t background_thread_func()
 static void init()
 {
     s_all_actions = new Queue<Function<void()>>;
-    s_background_thread = &Threading::Thread::construct(background_thread_func, "Background Thread"sv).leak_ref();
-    s_background_thread->start();
+    s_background_threads = new Vector<NonnullRefPtr<Threading::Thread>>;
+
+    for (size_t i = 0; i < s_background_thread_count; ++i) {
+        auto thread = Threading::Thread::construct(background_thread_func, "Background Thread"sv);
+        thread->start();
+        s_background_threads->append(move(thread));
+    }
+}
+
+void Threading::set_background_thread_count(size_t count)
+{
+    // NOTE: The threads are started along with the first background action, so it's too late to change this after.
+    VERIFY(!s_background_threads);
+    VERIFY(count > 0);
+    s_background_thread_count = count;
 }
 
 void Threading::quit_background_thread()
 {
-    if (!s_background_thread)
+    if (!s_background_threads)
         return;
 
     s_background_thread_should_run.store(false, AK::MemoryOrder::memory_order_release);
@@ -57,30 +70,34 @@ void Threading::quit_background_thread()
     pthread_cond_broadcast(&s_condition);
     pthread_mutex_unlock(&s_mutex);
 
-    MUST(s_background_thread->join());
+    for (auto& thread : *s_background_threads)
+        MUST(thread->join());
 
     delete s_all_actions;
-    s_background_thread->unref();
+    delete s_background_threads;
     s_all_actions = nullptr;
-    s_background_thread = nullptr;
+    s_background_threads = nullptr;
 
     s_background_thread_should_run.store(true, AK::MemoryOrder::memory_order_release);
 }
 
-Threading::Thread& Threading::BackgroundActionBase::background_thread()
+size_t Threading::background_thread_count()
 {
-    if (s_background_thread == nullptr)
-        init();
-    return *s_background_thread;
+    return s_background_thread_count;
 }
 
-void Threading::BackgroundActionBase::enqueue_work(Function<void()> work)
+void Threading::run_on_background_thread(Function<void()> work)
 {
     if (s_all_actions == nullptr)
         init();
 
     pthread_mutex_lock(&s_mutex);
     s_all_actions->enqueue(move(work));
-    pthread_cond_broadcast(&s_condition);
+    pthread_cond_signal(&s_condition);
     pthread_mutex_unlock(&s_mutex);
 }
+
+void Threading::BackgroundActionBase::enqueue_work(Function<void()> work)
+{
+    run_on_background_thread(move(work));
+}
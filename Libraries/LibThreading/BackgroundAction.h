@@ -31,7 +31,6 @@ private:
     BackgroundActionBase() = default;
 
     static void enqueue_work(ESCAPING Function<void()>);
-    static Thread& background_thread();
 };
 
 template<typename Result>
@@ -123,6 +122,15 @@ private:
     bool m_canceled { false };
 };
 
+// Background actions run on a single background thread by default, in the order they were created. With more than
+// one thread, they are started in that order, but may run concurrently and finish in any order.
+void set_background_thread_count(size_t);
+size_t background_thread_count();
+
+// Runs the work on one of the background threads, once one of them gets to it. Unlike a background action, it doesn't
+// report back to an event loop.
+void run_on_background_thread(ESCAPING Function<void()>);
+
 void quit_background_thread();
 
 }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/Optional.h>
+#include <LibThreading/BackgroundAction.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ParallelFor.h>
+
+namespace Threading {
+
+namespace {
+
+// Shared with the background threads that help out, since they may only get to it after parallel_for() has returned.
+struct ParallelForState : public AtomicRefCounted<ParallelForState> {
+    ParallelForState(size_t count, Function<ErrorOr<void>(size_t)> const& callback)
+        : count(count)
+        , callback(&callback)
+    {
+    }
+
+    void run()
+    {
+        while (!has_failed.load(AK::MemoryOrder::memory_order_relaxed)) {
+            auto index = next_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (index >= count)
+                return;
+
+            if (auto result = (*callback)(index); result.is_error()) {
+                MutexLocker locker(mutex);
+                if (!error.has_value())
+                    error = result.release_error();
+                has_failed.store(true, AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t const count;
+    Function<ErrorOr<void>(size_t)> const* callback;
+
+    Atomic<size_t> next_index { 0 };
+    Atomic<bool> has_failed { false };
+
+    Mutex mutex;
+    ConditionVariable helpers_done { mutex };
+    Optional<Error> error;
+    size_t running_helper_count { 0 };
+    bool is_finished { false };
+};
+
+}
+
+ErrorOr<void> parallel_for(size_t count, size_t max_thread_count, Function<ErrorOr<void>(size_t)> const& callback)
+{
+    auto state = adopt_ref(*new ParallelForState(count, callback));
+
+    // NOTE: The work is shared with the background threads rather than threads of our own, so that parallel_for() calls
+    //       on several of those threads don't end up with more threads than there are cores between them. Background
+    //       threads that are busy with something else by the time we are done just skip their part.
+    auto thread_count = min(min(count, max_thread_count), background_thread_count() + 1);
+    for (size_t i = 1; i < thread_count; ++i) {
+        run_on_background_thread([state] {
+            {
+                MutexLocker locker(state->mutex);
+                if (state->is_finished)
+                    return;
+                ++state->running_helper_count;
+            }
+
+            state->run();
+
+            MutexLocker locker(state->mutex);
+            if (--state->running_helper_count == 0)
+                state->helpers_done.broadcast();
+        });
+    }
+
+    state->run();
+
+    {
+        // Every index has been handed out by now, but helpers may still be working on theirs.
+        MutexLocker locker(state->mutex);
+        state->is_finished = true;
+        while (state->running_helper_count > 0)
+            state->helpers_done.wait();
+    }
+
+    if (state->error.has_value())
+        return state->error.release_value();
+    return {};
+}
+
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Function.h>
+
+namespace Threading {
+
+// Calls the callback for every index in [0, count), spread over up to max_thread_count threads: the calling thread, and
+// the background threads that are free to help out. Returns once all of the calls have returned. If one of them fails,
+// the indices that haven't been started yet are skipped, and its error is returned.
+ErrorOr<void> parallel_for(size_t count, size_t max_thread_count, Function<ErrorOr<void>(size_t)> const& callback);
+
+}
@@ -32,6 +32,12 @@ namespace Web::CSS {
 
 GC_DEFINE_ALLOCATOR(CSSStyleProperties);
 
+struct CSSStyleProperties::UnparsedDeclarations {
+    GC::Ptr<DOM::Document const> document;
+    GC::Ptr<CSSStyleSheet> style_sheet;
+    Vector<Parser::Declaration> declarations;
+};
+
 GC::Ref<CSSStyleProperties> CSSStyleProperties::create(JS::Realm& realm, Vector<StyleProperty> properties, HashMap<FlyString, StyleProperty> custom_properties)
 {
     // https://drafts.csswg.org/cssom/#dom-cssstylerule-style
@@ -44,6 +50,16 @@ GC::Ref<CSSStyleProperties> CSSStyleProperties::create(JS::Realm& realm, Vector<
     return realm.create<CSSStyleProperties>(realm, Computed::No, Readonly::No, move(properties), move(custom_properties), OptionalNone {});
 }
 
+// OPTIMIZATION: Most rules of a large style sheet never match any element, so we don't parse the values of their
+//               declarations until the cascade (or CSSOM) first asks for them.
+GC::Ref<CSSStyleProperties> CSSStyleProperties::create_with_unparsed_declarations(JS::Realm& realm, GC::Ptr<DOM::Document const> document, Vector<Parser::Declaration> declarations)
+{
+    auto style_properties = create(realm, {}, {});
+    if (!declarations.is_empty())
+        style_properties->m_unparsed_declarations = make<UnparsedDeclarations>(UnparsedDeclarations { document, nullptr, move(declarations) });
+    return style_properties;
+}
+
 GC::Ref<CSSStyleProperties> CSSStyleProperties::create_resolved_style(DOM::ElementReference element_reference)
 {
     // https://drafts.csswg.org/cssom/#dom-window-getcomputedstyle
@@ -75,6 +91,8 @@ CSSStyleProperties::CSSStyleProperties(JS::Realm& realm, Computed computed, Read
     set_owner_node(move(owner_node));
 }
 
+CSSStyleProperties::~CSSStyleProperties() = default;
+
 void CSSStyleProperties::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(CSSStyleProperties);
@@ -84,6 +102,10 @@ void CSSStyleProperties::initialize(JS::Realm& realm)
 void CSSStyleProperties::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
+    if (m_unparsed_declarations) {
+        visitor.visit(m_unparsed_declarations->document);
+        visitor.visit(m_unparsed_declarations->style_sheet);
+    }
     for (auto& property : m_properties) {
         property.value->visit_edges(visitor);
     }
@@ -98,7 +120,7 @@ size_t CSSStyleProperties::length() const
     if (is_computed())
         return to_underlying(last_longhand_property_id) - to_underlying(first_longhand_property_id) + 1;
 
-    return m_properties.size();
+    return properties().size();
 }
 
 String CSSStyleProperties::item(size_t index) const
@@ -171,7 +193,7 @@ Optional<StyleProperty> CSSStyleProperties::property(PropertyID property_id) con
         };
     }
 
-    for (auto& property : m_properties) {
+    for (auto& property : properties()) {
         if (property.property_id == property_id)
             return property;
     }
@@ -197,7 +219,7 @@ Optional<StyleProperty const&> CSSStyleProperties::custom_property(FlyString con
         return {};
     }
 
-    return m_custom_properties.get(custom_property_name);
+    return custom_properties().get(custom_property_name);
 }
 
 // https://drafts.csswg.org/cssom/#dom-cssstyledeclaration-setproperty
@@ -227,6 +249,8 @@ WebIDL::ExceptionOr<void> CSSStyleProperties::set_property(StringView property_n
     if (!priority.is_empty() && !Infra::is_ascii_case_insensitive_match(priority, "important"sv))
         return {};
 
+    parse_declarations_if_needed();
+
     // 5. Let component value list be the result of parsing value for property property.
     auto component_value_list = owner_node().has_value()
         ? parse_css_value(CSS::Parser::ParsingParams { owner_node()->element().document() }, value, property_id)
@@ -1039,6 +1063,7 @@ WebIDL::ExceptionOr<String> CSSStyleProperties::remove_property(StringView prope
 
     // 4. Let removed be false.
     bool removed = false;
+    parse_declarations_if_needed();
 
     // FIXME: 5. If property is a shorthand property, for each longhand property longhand that property maps to:
     //           1. If longhand is not a property name of a CSS declaration in the declarations, continue.
@@ -1092,6 +1117,8 @@ String CSSStyleProperties::serialized() const
     // 2. Let already serialized be an empty array.
     HashTable<PropertyID> already_serialized;
 
+    parse_declarations_if_needed();
+
     // NB: The spec treats custom properties the same as any other property, and expects the above loop to handle them.
     //       However, our implementation separates them from regular properties, so we need to handle them separately here.
     // FIXME: Is the relative order of custom properties and regular properties supposed to be preserved?
@@ -1190,6 +1217,7 @@ void CSSStyleProperties::invalidate_owners(DOM::StyleInvalidationReason reason)
 bool CSSStyleProperties::set_a_css_declaration(PropertyID property_id, NonnullRefPtr<CSSStyleValue const> value, Important important)
 {
     VERIFY(!is_computed());
+    parse_declarations_if_needed();
 
     // FIXME: Handle logical property groups.
 
@@ -1213,16 +1241,44 @@ bool CSSStyleProperties::set_a_css_declaration(PropertyID property_id, NonnullRe
 
 void CSSStyleProperties::empty_the_declarations()
 {
+    m_unparsed_declarations = nullptr;
     m_properties.clear();
     m_custom_properties.clear();
 }
 
 void CSSStyleProperties::set_the_declarations(Vector<StyleProperty> properties, HashMap<FlyString, StyleProperty> custom_properties)
 {
+    m_unparsed_declarations = nullptr;
     m_properties = move(properties);
     m_custom_properties = move(custom_properties);
 }
 
+void CSSStyleProperties::parse_declarations() const
+{
+    auto unparsed_declarations = m_unparsed_declarations.release_nonnull();
+    auto parsing_params = unparsed_declarations->document
+        ? Parser::ParsingParams(*unparsed_declarations->document)
+        : Parser::ParsingParams(realm());
+    auto parsed = Parser::Parser::create(parsing_params, ""sv).convert_to_style_properties(unparsed_declarations->declarations);
+    m_properties = move(parsed.properties);
+    m_custom_properties = move(parsed.custom_properties);
+
+    if (unparsed_declarations->style_sheet)
+        set_style_sheet_for_values(unparsed_declarations->style_sheet);
+}
+
+void CSSStyleProperties::set_style_sheet_for_values(GC::Ptr<CSSStyleSheet> style_sheet) const
+{
+    // NOTE: Don't parse the declarations just for this. The values will get the style sheet once they are parsed.
+    if (m_unparsed_declarations) {
+        m_unparsed_declarations->style_sheet = style_sheet;
+        return;
+    }
+
+    for (auto const& property : m_properties)
+        const_cast<CSSStyleValue&>(*property.value).set_style_sheet(style_sheet);
+}
+
 void CSSStyleProperties::set_declarations_from_text(StringView css_text)
 {
     empty_the_declarations();
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
 #include <LibWeb/CSS/GeneratedCSSStyleProperties.h>
 
@@ -21,11 +22,12 @@ class CSSStyleProperties
 
 public:
     [[nodiscard]] static GC::Ref<CSSStyleProperties> create(JS::Realm&, Vector<StyleProperty>, HashMap<FlyString, StyleProperty> custom_properties);
+    [[nodiscard]] static GC::Ref<CSSStyleProperties> create_with_unparsed_declarations(JS::Realm&, GC::Ptr<DOM::Document const>, Vector<Parser::Declaration>);
 
     [[nodiscard]] static GC::Ref<CSSStyleProperties> create_resolved_style(DOM::ElementReference);
     [[nodiscard]] static GC::Ref<CSSStyleProperties> create_element_inline_style(DOM::ElementReference, Vector<StyleProperty>, HashMap<FlyString, StyleProperty> custom_properties);
 
-    virtual ~CSSStyleProperties() override = default;
+    virtual ~CSSStyleProperties() override;
     virtual void initialize(JS::Realm&) override;
 
     virtual size_t length() const override;
@@ -43,10 +45,23 @@ public:
     virtual String get_property_value(StringView property_name) const override;
     virtual StringView get_property_priority(StringView property_name) const override;
 
-    Vector<StyleProperty> const& properties() const { return m_properties; }
-    HashMap<FlyString, StyleProperty> const& custom_properties() const { return m_custom_properties; }
+    Vector<StyleProperty> const& properties() const
+    {
+        parse_declarations_if_needed();
+        return m_properties;
+    }
+    HashMap<FlyString, StyleProperty> const& custom_properties() const
+    {
+        parse_declarations_if_needed();
+        return m_custom_properties;
+    }
 
-    size_t custom_property_count() const { return m_custom_properties.size(); }
+    size_t custom_property_count() const { return custom_properties().size(); }
+
+    // Style values that request resources need to know their CSSStyleSheet in order to fetch them.
+    void set_style_sheet_for_values(GC::Ptr<CSSStyleSheet>) const;
+
+    bool has_unparsed_declarations() const { return !m_unparsed_declarations.is_null(); }
 
     String css_float() const;
     WebIDL::ExceptionOr<void> set_css_float(StringView);
@@ -73,8 +88,20 @@ private:
 
     void invalidate_owners(DOM::StyleInvalidationReason);
 
-    Vector<StyleProperty> m_properties;
-    HashMap<FlyString, StyleProperty> m_custom_properties;
+    void parse_declarations_if_needed() const
+    {
+        if (m_unparsed_declarations)
+            parse_declarations();
+    }
+    void parse_declarations() const;
+
+    // Declarations from a style sheet whose values haven't been parsed yet. Their values are parsed into
+    // m_properties and m_custom_properties the first time anything looks at them.
+    struct UnparsedDeclarations;
+    mutable OwnPtr<UnparsedDeclarations> m_unparsed_declarations;
+
+    mutable Vector<StyleProperty> m_properties;
+    mutable HashMap<FlyString, StyleProperty> m_custom_properties;
 };
 
 }
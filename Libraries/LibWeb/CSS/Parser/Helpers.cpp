@@ -8,6 +8,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Bindings/PrincipalHostDefined.h>
 #include <LibWeb/CSS/CSSMediaRule.h>
@@ -51,9 +53,11 @@ GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams cons
         style_sheet->set_source_text({});
         return style_sheet;
     }
-    auto style_sheet = CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location, move(media_query_list));
+    auto parse_timer = Core::ElapsedTimer::start_new();
+    auto style_sheet = CSS::Parser::Parser::create_for_style_sheet(context, css).parse_as_css_stylesheet(location, move(media_query_list));
     // FIXME: Avoid this copy
     style_sheet->set_source_text(MUST(String::from_utf8(css)));
+    dbgln_if(CSS_PARSER_DEBUG, "Parsed style sheet {} ({} bytes, {} rules) in {}ms", location, css.length(), style_sheet->rules().length(), parse_timer.elapsed_milliseconds());
     return style_sheet;
 }
 
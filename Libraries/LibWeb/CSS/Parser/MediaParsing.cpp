@@ -491,21 +491,21 @@ Optional<MediaFeatureValue> Parser::parse_media_feature_value(MediaFeatureID med
     return {};
 }
 
-GC::Ptr<CSSMediaRule> Parser::convert_to_media_rule(AtRule const& rule, Nested nested)
+GC::Ptr<CSSMediaRule> Parser::convert_to_media_rule(AtRule& rule, Nested nested)
 {
     auto media_query_tokens = TokenStream { rule.prelude };
     auto media_query_list = parse_a_media_query_list(media_query_tokens);
     auto media_list = MediaList::create(realm(), move(media_query_list));
 
     GC::RootVector<GC::Ref<CSSRule>> child_rules { realm().heap() };
-    for (auto const& child : rule.child_rules_and_lists_of_declarations) {
+    for (auto& child : rule.child_rules_and_lists_of_declarations) {
         child.visit(
-            [&](Rule const& rule) {
+            [&](Rule& rule) {
                 if (auto child_rule = convert_to_rule(rule, nested))
                     child_rules.append(*child_rule);
             },
-            [&](Vector<Declaration> const& declarations) {
-                child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(declarations)));
+            [&](Vector<Declaration>& declarations) {
+                child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(move(declarations))));
             });
     }
     auto rule_list = CSSRuleList::create(realm(), child_rules);
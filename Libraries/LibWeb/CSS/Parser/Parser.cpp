@@ -55,15 +55,20 @@ ParsingParams::ParsingParams(DOM::Document const& document, ParsingMode mode)
 Parser Parser::create(ParsingParams const& context, StringView input, StringView encoding)
 {
     auto tokens = Tokenizer::tokenize(input, encoding);
-    return Parser { context, move(tokens) };
+    return Parser { context, TokenList::create(move(tokens)) };
 }
 
-Parser::Parser(ParsingParams const& context, Vector<Token> tokens)
+Parser Parser::create_for_style_sheet(ParsingParams const& context, StringView input, StringView encoding)
+{
+    return Parser { context, Tokenizer::tokenize_style_sheet(input, encoding) };
+}
+
+Parser::Parser(ParsingParams const& context, NonnullRefPtr<TokenList const> tokens)
     : m_document(context.document)
     , m_realm(context.realm)
     , m_parsing_mode(context.mode)
     , m_tokens(move(tokens))
-    , m_token_stream(m_tokens)
+    , m_token_stream(m_tokens->tokens())
     , m_rule_context(move(context.rule_context))
 {
 }
@@ -106,7 +111,7 @@ GC::RootVector<GC::Ref<CSSRule>> Parser::parse_as_stylesheet_contents()
 {
     auto raw_rules = parse_a_stylesheets_contents(m_token_stream);
     GC::RootVector<GC::Ref<CSSRule>> rules(realm().heap());
-    for (auto const& raw_rule : raw_rules) {
+    for (auto& raw_rule : raw_rules) {
         auto rule = convert_to_rule(raw_rule, Nested::No);
         if (!rule) {
             log_parse_error();
@@ -122,11 +127,11 @@ GC::RootVector<GC::Ref<CSSRule>> Parser::parse_as_stylesheet_contents()
 GC::Ref<CSS::CSSStyleSheet> Parser::parse_as_css_stylesheet(Optional<::URL::URL> location, Vector<NonnullRefPtr<MediaQuery>> media_query_list)
 {
     // To parse a CSS stylesheet, first parse a stylesheet.
-    auto const& style_sheet = parse_a_stylesheet(m_token_stream, location);
+    auto style_sheet = parse_a_stylesheet(m_token_stream, location);
 
     // Interpret all of the resulting top-level qualified rules as style rules, defined below.
     GC::RootVector<GC::Ref<CSSRule>> rules(realm().heap());
-    for (auto const& raw_rule : style_sheet.rules) {
+    for (auto& raw_rule : style_sheet.rules) {
         auto rule = convert_to_rule(raw_rule, Nested::No);
         // If any style rule is invalid, or any at-rule is not recognized or is invalid according to its grammar or context, it’s a parse error.
         // Discard that rule.
@@ -1549,14 +1554,18 @@ void Parser::extract_property(Declaration const& declaration, PropertiesAndCusto
     }
 }
 
-GC::Ref<CSSStyleProperties> Parser::convert_to_style_declaration(Vector<Declaration> const& declarations)
+GC::Ref<CSSStyleProperties> Parser::convert_to_style_declaration(Vector<Declaration> declarations)
+{
+    // NOTE: The values are parsed later, by convert_to_style_properties(), when something first needs them.
+    return CSSStyleProperties::create_with_unparsed_declarations(realm(), m_document, move(declarations));
+}
+
+Parser::PropertiesAndCustomProperties Parser::convert_to_style_properties(Vector<Declaration> const& declarations)
 {
     PropertiesAndCustomProperties properties;
-    PropertiesAndCustomProperties& dest = properties;
-    for (auto const& declaration : declarations) {
-        extract_property(declaration, dest);
-    }
-    return CSSStyleProperties::create(realm(), move(properties.properties), move(properties.custom_properties));
+    for (auto const& declaration : declarations)
+        extract_property(declaration, properties);
+    return properties;
 }
 
 Optional<StyleProperty> Parser::convert_to_style_property(Declaration const& declaration)
@@ -91,6 +91,7 @@ class Parser {
 
 public:
     static Parser create(ParsingParams const&, StringView input, StringView encoding = "utf-8"sv);
+    static Parser create_for_style_sheet(ParsingParams const&, StringView input, StringView encoding = "utf-8"sv);
 
     GC::Ref<CSS::CSSStyleSheet> parse_as_css_stylesheet(Optional<::URL::URL> location, Vector<NonnullRefPtr<MediaQuery>> media_query_list = {});
 
@@ -99,6 +100,7 @@ public:
         HashMap<FlyString, StyleProperty> custom_properties;
     };
     PropertiesAndCustomProperties parse_as_property_declaration_block();
+    PropertiesAndCustomProperties convert_to_style_properties(Vector<Declaration> const&);
     Vector<Descriptor> parse_as_descriptor_declaration_block(AtRuleID);
     CSSRule* parse_as_css_rule();
     Optional<StyleProperty> parse_as_supports_condition();
@@ -134,7 +136,7 @@ public:
     [[nodiscard]] LengthOrCalculated parse_as_sizes_attribute(DOM::Element const& element, HTML::HTMLImageElement const* img = nullptr);
 
 private:
-    Parser(ParsingParams const&, Vector<Token>);
+    Parser(ParsingParams const&, NonnullRefPtr<TokenList const>);
 
     enum class ParseError {
         IncludesIgnoredVendorPrefix,
@@ -237,19 +239,19 @@ private:
     bool is_valid_in_the_current_context(Declaration const&) const;
     bool is_valid_in_the_current_context(AtRule const&) const;
     bool is_valid_in_the_current_context(QualifiedRule const&) const;
-    GC::Ptr<CSSRule> convert_to_rule(Rule const&, Nested);
-    GC::Ptr<CSSStyleRule> convert_to_style_rule(QualifiedRule const&, Nested);
+    GC::Ptr<CSSRule> convert_to_rule(Rule&, Nested);
+    GC::Ptr<CSSStyleRule> convert_to_style_rule(QualifiedRule&, Nested);
     GC::Ptr<CSSFontFaceRule> convert_to_font_face_rule(AtRule const&);
     GC::Ptr<CSSKeyframesRule> convert_to_keyframes_rule(AtRule const&);
     GC::Ptr<CSSImportRule> convert_to_import_rule(AtRule const&);
-    GC::Ptr<CSSRule> convert_to_layer_rule(AtRule const&, Nested);
-    GC::Ptr<CSSMediaRule> convert_to_media_rule(AtRule const&, Nested);
+    GC::Ptr<CSSRule> convert_to_layer_rule(AtRule&, Nested);
+    GC::Ptr<CSSMediaRule> convert_to_media_rule(AtRule&, Nested);
     GC::Ptr<CSSNamespaceRule> convert_to_namespace_rule(AtRule const&);
     GC::Ptr<CSSPageRule> convert_to_page_rule(AtRule const& rule);
     GC::Ptr<CSSPropertyRule> convert_to_property_rule(AtRule const& rule);
-    GC::Ptr<CSSSupportsRule> convert_to_supports_rule(AtRule const&, Nested);
+    GC::Ptr<CSSSupportsRule> convert_to_supports_rule(AtRule&, Nested);
 
-    GC::Ref<CSSStyleProperties> convert_to_style_declaration(Vector<Declaration> const&);
+    GC::Ref<CSSStyleProperties> convert_to_style_declaration(Vector<Declaration>);
     Optional<StyleProperty> convert_to_style_property(Declaration const&);
 
     Optional<Descriptor> convert_to_descriptor(AtRuleID, Declaration const&);
@@ -487,7 +489,7 @@ private:
     GC::Ptr<JS::Realm> m_realm;
     ParsingMode m_parsing_mode { ParsingMode::Normal };
 
-    Vector<Token> m_tokens;
+    NonnullRefPtr<TokenList const> m_tokens;
     TokenStream<Token> m_token_stream;
 
     struct FunctionContext {
@@ -83,10 +83,10 @@ private:
     HashTable<DescriptorID> m_seen_descriptor_ids;
 };
 
-GC::Ptr<CSSRule> Parser::convert_to_rule(Rule const& rule, Nested nested)
+GC::Ptr<CSSRule> Parser::convert_to_rule(Rule& rule, Nested nested)
 {
     return rule.visit(
-        [this, nested](AtRule const& at_rule) -> GC::Ptr<CSSRule> {
+        [this, nested](AtRule& at_rule) -> GC::Ptr<CSSRule> {
             if (has_ignored_vendor_prefix(at_rule.name))
                 return {};
 
@@ -121,12 +121,12 @@ GC::Ptr<CSSRule> Parser::convert_to_rule(Rule const& rule, Nested nested)
             dbgln_if(CSS_PARSER_DEBUG, "Unrecognized CSS at-rule: @{}", at_rule.name);
             return {};
         },
-        [this, nested](QualifiedRule const& qualified_rule) -> GC::Ptr<CSSRule> {
+        [this, nested](QualifiedRule& qualified_rule) -> GC::Ptr<CSSRule> {
             return convert_to_style_rule(qualified_rule, nested);
         });
 }
 
-GC::Ptr<CSSStyleRule> Parser::convert_to_style_rule(QualifiedRule const& qualified_rule, Nested nested)
+GC::Ptr<CSSStyleRule> Parser::convert_to_style_rule(QualifiedRule& qualified_rule, Nested nested)
 {
     TokenStream prelude_stream { qualified_rule.prelude };
 
@@ -152,12 +152,12 @@ GC::Ptr<CSSStyleRule> Parser::convert_to_style_rule(QualifiedRule const& qualifi
     if (nested == Nested::Yes)
         selectors = adapt_nested_relative_selector_list(selectors);
 
-    auto declaration = convert_to_style_declaration(qualified_rule.declarations);
+    auto declaration = convert_to_style_declaration(move(qualified_rule.declarations));
 
     GC::RootVector<GC::Ref<CSSRule>> child_rules { realm().heap() };
     for (auto& child : qualified_rule.child_rules) {
         child.visit(
-            [&](Rule const& rule) {
+            [&](Rule& rule) {
                 // "In addition to nested style rules, this specification allows nested group rules inside of style rules:
                 // any at-rule whose body contains style rules can be nested inside of a style rule as well."
                 // https://drafts.csswg.org/css-nesting-1/#nested-group-rules
@@ -169,8 +169,8 @@ GC::Ptr<CSSStyleRule> Parser::convert_to_style_rule(QualifiedRule const& qualifi
                     }
                 }
             },
-            [&](Vector<Declaration> const& declarations) {
-                child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(declarations)));
+            [&](Vector<Declaration>& declarations) {
+                child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(move(declarations))));
             });
     }
     auto nested_rules = CSSRuleList::create(realm(), child_rules);
@@ -281,7 +281,7 @@ Optional<FlyString> Parser::parse_layer_name(TokenStream<ComponentValue>& tokens
     return builder.to_fly_string_without_validation();
 }
 
-GC::Ptr<CSSRule> Parser::convert_to_layer_rule(AtRule const& rule, Nested nested)
+GC::Ptr<CSSRule> Parser::convert_to_layer_rule(AtRule& rule, Nested nested)
 {
     // https://drafts.csswg.org/css-cascade-5/#at-layer
     if (!rule.child_rules_and_lists_of_declarations.is_empty()) {
@@ -308,14 +308,14 @@ GC::Ptr<CSSRule> Parser::convert_to_layer_rule(AtRule const& rule, Nested nested
 
         // Then the rules
         GC::RootVector<GC::Ref<CSSRule>> child_rules { realm().heap() };
-        for (auto const& child : rule.child_rules_and_lists_of_declarations) {
+        for (auto& child : rule.child_rules_and_lists_of_declarations) {
             child.visit(
-                [&](Rule const& rule) {
+                [&](Rule& rule) {
                     if (auto child_rule = convert_to_rule(rule, nested))
                         child_rules.append(*child_rule);
                 },
-                [&](Vector<Declaration> const& declarations) {
-                    child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(declarations)));
+                [&](Vector<Declaration>& declarations) {
+                    child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(move(declarations))));
                 });
         }
         auto rule_list = CSSRuleList::create(realm(), child_rules);
@@ -505,7 +505,7 @@ GC::Ptr<CSSNamespaceRule> Parser::convert_to_namespace_rule(AtRule const& rule)
     return CSSNamespaceRule::create(realm(), prefix, namespace_uri);
 }
 
-GC::Ptr<CSSSupportsRule> Parser::convert_to_supports_rule(AtRule const& rule, Nested nested)
+GC::Ptr<CSSSupportsRule> Parser::convert_to_supports_rule(AtRule& rule, Nested nested)
 {
     // https://drafts.csswg.org/css-conditional-3/#at-supports
     // @supports <supports-condition> {
@@ -528,14 +528,14 @@ GC::Ptr<CSSSupportsRule> Parser::convert_to_supports_rule(AtRule const& rule, Ne
     }
 
     GC::RootVector<GC::Ref<CSSRule>> child_rules { realm().heap() };
-    for (auto const& child : rule.child_rules_and_lists_of_declarations) {
+    for (auto& child : rule.child_rules_and_lists_of_declarations) {
         child.visit(
-            [&](Rule const& rule) {
+            [&](Rule& rule) {
                 if (auto child_rule = convert_to_rule(rule, nested))
                     child_rules.append(*child_rule);
             },
-            [&](Vector<Declaration> const& declarations) {
-                child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(declarations)));
+            [&](Vector<Declaration>& declarations) {
+                child_rules.append(CSSNestedDeclarations::create(realm(), *convert_to_style_declaration(move(declarations))));
             });
     }
 
@@ -7,6 +7,7 @@
 
 #include <AK/Debug.h>
 #include <AK/FloatingPointStringConversions.h>
+#include <AK/HashFunctions.h>
 #include <AK/SourceLocation.h>
 #include <AK/Vector.h>
 #include <LibTextCodec/Decoder.h>
@@ -218,6 +219,79 @@ Vector<Token> Tokenizer::tokenize(StringView input, StringView encoding)
     return tokenizer.tokenize();
 }
 
+// OPTIMIZATION: Sites tend to use the same large style sheets on every page, and the tokens don't depend on the
+//               document they are parsed for. Keep the tokens of a few recently seen large style sheets around, so
+//               that navigating to the next page only has to build the rules from them.
+static constexpr size_t minimum_cached_input_length = 16 * KiB;
+static constexpr size_t maximum_cached_token_list_count = 4;
+static constexpr size_t maximum_retained_size_of_cached_token_lists = 32 * MiB;
+
+struct CachedTokenList {
+    u32 input_hash { 0 };
+    String input;
+    NonnullRefPtr<TokenList const> token_list;
+    size_t retained_size { 0 };
+};
+
+// Ordered from least to most recently used.
+static Vector<CachedTokenList> s_cached_token_lists;
+static size_t s_retained_size_of_cached_token_lists = 0;
+
+// NOTE: Hashing all of a large style sheet costs about as much as comparing it. Only hash its length and both of its
+//       ends, and compare the whole input once the hash matches.
+static u32 hash_style_sheet_input(StringView input)
+{
+    static constexpr size_t sample_length = 4 * KiB;
+    auto head = input.substring_view(0, min(input.length(), sample_length));
+    auto tail = input.substring_view(input.length() - head.length());
+    return pair_int_hash(pair_int_hash(u64_hash(input.length()), head.hash()), tail.hash());
+}
+
+NonnullRefPtr<TokenList const> Tokenizer::tokenize_style_sheet(StringView input, StringView encoding)
+{
+    if (input.length() < minimum_cached_input_length || !encoding.equals_ignoring_ascii_case("utf-8"sv))
+        return TokenList::create(tokenize(input, encoding));
+
+    auto input_hash = hash_style_sheet_input(input);
+    for (size_t i = 0; i < s_cached_token_lists.size(); ++i) {
+        auto const& cached = s_cached_token_lists[i];
+        if (cached.input_hash != input_hash || cached.input.bytes_as_string_view() != input)
+            continue;
+        dbgln_if(CSS_TOKENIZER_DEBUG, "(Tokenizer) Reusing {} cached tokens for {} bytes of input", cached.token_list->tokens().size(), input.length());
+        // Move the entry to the back to mark it as the most recently used one.
+        auto entry = s_cached_token_lists.take(i);
+        auto token_list = entry.token_list;
+        s_cached_token_lists.append(move(entry));
+        return token_list;
+    }
+
+    auto token_list = TokenList::create(tokenize(input, encoding));
+
+    // NOTE: Tokens are much larger than the source text they were made from, so the cache is bounded by the memory it
+    //       keeps alive rather than by input length. This doesn't count strings that live outside of the tokens.
+    auto retained_size = input.length() + token_list->tokens().capacity() * sizeof(Token);
+    if (retained_size > maximum_retained_size_of_cached_token_lists)
+        return token_list;
+
+    while (!s_cached_token_lists.is_empty()
+        && (s_cached_token_lists.size() >= maximum_cached_token_list_count
+            || s_retained_size_of_cached_token_lists + retained_size > maximum_retained_size_of_cached_token_lists)) {
+        s_retained_size_of_cached_token_lists -= s_cached_token_lists.first().retained_size;
+        s_cached_token_lists.remove(0);
+    }
+    s_retained_size_of_cached_token_lists += retained_size;
+    s_cached_token_lists.append({ input_hash, MUST(String::from_utf8(input)), token_list, retained_size });
+
+    return token_list;
+}
+
+void Tokenizer::clear_style_sheet_token_cache()
+{
+    dbgln_if(CSS_TOKENIZER_DEBUG, "(Tokenizer) Clearing {} cached token lists", s_cached_token_lists.size());
+    s_cached_token_lists.clear();
+    s_retained_size_of_cached_token_lists = 0;
+}
+
 Tokenizer::Tokenizer(String decoded_input)
     : m_decoded_input(move(decoded_input))
     , m_utf8_view(m_decoded_input)
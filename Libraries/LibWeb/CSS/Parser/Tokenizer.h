@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Optional.h>
+#include <AK/RefCounted.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <AK/Utf8View.h>
@@ -57,9 +58,27 @@ public:
     u32 third {};
 };
 
+// An immutable list of tokens, which may be shared between several parsers of the same input.
+class TokenList : public RefCounted<TokenList> {
+public:
+    static NonnullRefPtr<TokenList> create(Vector<Token> tokens) { return adopt_ref(*new TokenList(move(tokens))); }
+
+    Vector<Token> const& tokens() const { return m_tokens; }
+
+private:
+    explicit TokenList(Vector<Token> tokens)
+        : m_tokens(move(tokens))
+    {
+    }
+
+    Vector<Token> m_tokens;
+};
+
 class Tokenizer {
 public:
     static Vector<Token> tokenize(StringView input, StringView encoding);
+    static NonnullRefPtr<TokenList const> tokenize_style_sheet(StringView input, StringView encoding);
+    static void clear_style_sheet_token_cache();
 
     [[nodiscard]] static Token create_eof_token();
 
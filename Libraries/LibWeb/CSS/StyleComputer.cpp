@@ -458,6 +458,19 @@ InvalidationSet StyleComputer::invalidation_set_for_properties(Vector<Invalidati
     return result;
 }
 
+InvalidationSet StyleComputer::sibling_invalidation_set_for_properties(Vector<InvalidationSet::Property> const& properties) const
+{
+    if (!m_style_invalidation_data)
+        return {};
+    auto const& sibling_invalidation_sets = m_style_invalidation_data->sibling_invalidation_sets;
+    InvalidationSet result;
+    for (auto const& property : properties) {
+        if (auto it = sibling_invalidation_sets.find(property); it != sibling_invalidation_sets.end())
+            result.include_all_from(it->value);
+    }
+    return result;
+}
+
 bool StyleComputer::invalidation_property_used_in_has_selector(InvalidationSet::Property const& property) const
 {
     if (!m_style_invalidation_data)
@@ -105,7 +105,12 @@ enum class InsideNthChildPseudoClass {
     Yes
 };
 
-static InvalidationSet build_invalidation_sets_for_selector_impl(StyleInvalidationData& style_invalidation_data, Selector const& selector, InsideNthChildPseudoClass inside_nth_child_pseudo_class);
+enum class NestedInPseudoClass : bool {
+    No,
+    Yes,
+};
+
+static InvalidationSet build_invalidation_sets_for_selector_impl(StyleInvalidationData& style_invalidation_data, Selector const& selector, InsideNthChildPseudoClass inside_nth_child_pseudo_class, NestedInPseudoClass nested_in_pseudo_class);
 
 static void add_invalidation_sets_to_cover_scope_leakage_of_relative_selector_in_has_pseudo_class(Selector const& selector, StyleInvalidationData& style_invalidation_data);
 
@@ -155,7 +160,7 @@ static void build_invalidation_sets_for_simple_selector(Selector::SimpleSelector
             inside_nth_child_pseudo_class_for_nested = InsideNthChildPseudoClass::Yes;
         }
         for (auto const& nested_selector : pseudo_class.argument_selector_list) {
-            auto rightmost_invalidation_set_for_selector = build_invalidation_sets_for_selector_impl(style_invalidation_data, *nested_selector, inside_nth_child_pseudo_class_for_nested);
+            auto rightmost_invalidation_set_for_selector = build_invalidation_sets_for_selector_impl(style_invalidation_data, *nested_selector, inside_nth_child_pseudo_class_for_nested, NestedInPseudoClass::Yes);
             invalidation_set.include_all_from(rightmost_invalidation_set_for_selector);
         }
         break;
@@ -206,7 +211,7 @@ static void add_invalidation_sets_to_cover_scope_leakage_of_relative_selector_in
     });
 }
 
-static InvalidationSet build_invalidation_sets_for_selector_impl(StyleInvalidationData& style_invalidation_data, Selector const& selector, InsideNthChildPseudoClass inside_nth_child_pseudo_class)
+static InvalidationSet build_invalidation_sets_for_selector_impl(StyleInvalidationData& style_invalidation_data, Selector const& selector, InsideNthChildPseudoClass inside_nth_child_pseudo_class, NestedInPseudoClass nested_in_pseudo_class)
 {
     auto const& compound_selectors = selector.compound_selectors();
     int compound_selector_index = compound_selectors.size() - 1;
@@ -260,16 +265,30 @@ static InvalidationSet build_invalidation_sets_for_selector_impl(StyleInvalidati
                 InvalidationSet s;
                 build_invalidation_sets_for_simple_selector(simple_selector, s, ExcludePropertiesNestedInNotPseudoClass::No, style_invalidation_data, inside_nth_child_pseudo_class);
                 s.for_each_property([&](auto const& invalidation_property) {
+                    // If combinator to the right of current compound selector is NextSibling or SubsequentSibling,
+                    // elements affected by a change of this property are the subsequent siblings of the changed
+                    // element and their descendants, so we record what to look for there in a sibling invalidation set.
+                    // NOTE: NextSibling is treated like SubsequentSibling, since in "a + b + c" the subject could be
+                    //       any number of siblings away from the element matching "a".
+                    // NOTE: The rightmost compound of a selector nested in a pseudo-class like :is(.a + .b) .c is not
+                    //       the subject, so matching siblings have their whole subtree invalidated in that case.
+                    if (AK::first_is_one_of(previous_compound_combinator, Selector::Combinator::NextSibling, Selector::Combinator::SubsequentSibling)) {
+                        auto& sibling_invalidation_set = style_invalidation_data.sibling_invalidation_sets.ensure(invalidation_property, [] {
+                            return InvalidationSet {};
+                        });
+                        if (invalidation_set_for_rightmost_selector.is_empty() || nested_in_pseudo_class == NestedInPseudoClass::Yes)
+                            sibling_invalidation_set.set_needs_invalidate_whole_subtree();
+                        else
+                            sibling_invalidation_set.include_all_from(invalidation_set_for_rightmost_selector);
+                        return IterationDecision::Continue;
+                    }
+
                     auto& descendant_invalidation_set = style_invalidation_data.descendant_invalidation_sets.ensure(invalidation_property, [] {
                         return InvalidationSet {};
                     });
                     // If the rightmost selector's invalidation set is empty, it means there's no
                     // specific property-based invalidation, so we fall back to invalidating the whole subtree.
-                    // If combinator to the right of current compound selector is NextSibling or SubsequentSibling,
-                    // we also need to invalidate the whole subtree, because we don't support sibling invalidation sets.
-                    if (AK::first_is_one_of(previous_compound_combinator, Selector::Combinator::NextSibling, Selector::Combinator::SubsequentSibling)) {
-                        descendant_invalidation_set.set_needs_invalidate_whole_subtree();
-                    } else if (invalidation_set_for_rightmost_selector.is_empty()) {
+                    if (invalidation_set_for_rightmost_selector.is_empty()) {
                         descendant_invalidation_set.set_needs_invalidate_whole_subtree();
                     } else {
                         descendant_invalidation_set.include_all_from(invalidation_set_for_rightmost_selector);
@@ -288,7 +307,7 @@ static InvalidationSet build_invalidation_sets_for_selector_impl(StyleInvalidati
 
 void StyleInvalidationData::build_invalidation_sets_for_selector(Selector const& selector)
 {
-    (void)build_invalidation_sets_for_selector_impl(*this, selector, InsideNthChildPseudoClass::No);
+    (void)build_invalidation_sets_for_selector_impl(*this, selector, InsideNthChildPseudoClass::No, NestedInPseudoClass::No);
 }
 
 }
@@ -86,6 +86,7 @@ void ImageStyleValue::animate()
         return;
 
     m_current_frame_index = (m_current_frame_index + 1) % image_data->frame_count();
+    image_data->advance_to_frame(m_current_frame_index);
     auto current_frame_duration = image_data->frame_duration(m_current_frame_index);
 
     if (current_frame_duration != m_timer->interval())
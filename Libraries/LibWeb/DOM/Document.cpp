@@ -528,6 +528,10 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_inspected_node);
     visitor.visit(m_highlighted_node);
     visitor.visit(m_active_favicon);
+    for (auto& result : m_query_selector_all_results) {
+        visitor.visit(result.scope);
+        visitor.visit(result.nodes);
+    }
     visitor.visit(m_focused_element);
     visitor.visit(m_active_element);
     visitor.visit(m_target_element);
@@ -1315,6 +1319,9 @@ void Document::update_layout(UpdateLayoutReason reason)
 
     auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
+    if constexpr (UPDATE_LAYOUT_DEBUG)
+        Layout::FormattingContext::intrinsic_size_cache_statistics() = {};
+
     if (!m_layout_root || needs_layout_tree_update() || child_needs_layout_tree_update() || needs_full_layout_tree_update()) {
         Layout::TreeBuilder tree_builder;
         m_layout_root = as<Layout::Viewport>(*tree_builder.build(*this));
@@ -1331,8 +1338,10 @@ void Document::update_layout(UpdateLayoutReason reason)
         }
     }
 
+    size_t layout_node_count = 0;
     m_layout_root->for_each_in_inclusive_subtree([&](auto& layout_node) {
         layout_node.recompute_containing_block({});
+        layout_node.set_layout_index({}, layout_node_count++);
         return TraversalDecision::Continue;
     });
 
@@ -1364,7 +1373,7 @@ void Document::update_layout(UpdateLayoutReason reason)
         return TraversalDecision::Continue;
     });
 
-    Layout::LayoutState layout_state;
+    Layout::LayoutState layout_state(layout_node_count);
 
     {
         Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
@@ -1419,10 +1428,14 @@ void Document::update_layout(UpdateLayoutReason reason)
 
     if constexpr (UPDATE_LAYOUT_DEBUG) {
         dbgln("LAYOUT {} {} µs", to_string(reason), timer.elapsed_time().to_microseconds());
+        auto const& cache_statistics = Layout::FormattingContext::intrinsic_size_cache_statistics();
+        auto lookups = cache_statistics.hits + cache_statistics.misses;
+        dbgln("INTRINSIC SIZE CACHE {} hits, {} misses ({}% hit rate)", cache_statistics.hits, cache_statistics.misses,
+            lookups ? cache_statistics.hits * 100 / lookups : 0);
     }
 }
 
-[[nodiscard]] static CSS::RequiredInvalidationAfterStyleChange update_style_recursively(Node& node, CSS::StyleComputer& style_computer, bool needs_inherited_style_update)
+[[nodiscard]] static CSS::RequiredInvalidationAfterStyleChange update_style_recursively(Node& node, CSS::StyleComputer& style_computer, bool needs_inherited_style_update, size_t& restyled_element_count)
 {
     bool const needs_full_style_update = node.document().needs_full_style_update();
     CSS::RequiredInvalidationAfterStyleChange invalidation;
@@ -1439,6 +1452,7 @@ void Document::update_layout(UpdateLayoutReason reason)
     if (is<Element>(node)) {
         if (needs_full_style_update || node.needs_style_update()) {
             node_invalidation = static_cast<Element&>(node).recompute_style();
+            ++restyled_element_count;
         } else if (needs_inherited_style_update) {
             node_invalidation = static_cast<Element&>(node).recompute_inherited_style();
         }
@@ -1464,7 +1478,7 @@ void Document::update_layout(UpdateLayoutReason reason)
         if (node.is_element()) {
             if (auto shadow_root = static_cast<DOM::Element&>(node).shadow_root()) {
                 if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update()) {
-                    auto subtree_invalidation = update_style_recursively(*shadow_root, style_computer, children_need_inherited_style_update);
+                    auto subtree_invalidation = update_style_recursively(*shadow_root, style_computer, children_need_inherited_style_update, restyled_element_count);
                     if (!is_display_none)
                         invalidation |= subtree_invalidation;
                 }
@@ -1473,7 +1487,7 @@ void Document::update_layout(UpdateLayoutReason reason)
 
         node.for_each_child([&](auto& child) {
             if (needs_full_style_update || child.needs_style_update() || children_need_inherited_style_update || child.child_needs_style_update()) {
-                auto subtree_invalidation = update_style_recursively(child, style_computer, children_need_inherited_style_update);
+                auto subtree_invalidation = update_style_recursively(child, style_computer, children_need_inherited_style_update, restyled_element_count);
                 if (!is_display_none)
                     invalidation |= subtree_invalidation;
             }
@@ -1546,7 +1560,10 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
-    auto invalidation = update_style_recursively(*this, style_computer(), false);
+    size_t restyled_element_count = 0;
+    auto invalidation = update_style_recursively(*this, style_computer(), false, restyled_element_count);
+    m_restyled_element_count += restyled_element_count;
+    dbgln_if(STYLE_INVALIDATION_DEBUG, "Style update recomputed style of {} element(s)", restyled_element_count);
     if (!invalidation.is_none())
         invalidate_display_list();
     if (invalidation.rebuild_stacking_context_tree)
@@ -6553,6 +6570,45 @@ void Document::set_onvisibilitychange(WebIDL::CallbackType* value)
     set_event_handler_attribute(HTML::EventNames::visibilitychange, value);
 }
 
+Optional<CSS::SelectorList> Document::parse_selector_for_query(StringView selector_text) const
+{
+    static constexpr size_t max_parsed_query_selectors = 256;
+
+    auto key = MUST(String::from_utf8(selector_text));
+    if (auto it = m_parsed_query_selectors.find(key); it != m_parsed_query_selectors.end())
+        return it->value;
+
+    auto selectors = parse_selector(CSS::Parser::ParsingParams { *this }, selector_text);
+    if (m_parsed_query_selectors.size() >= max_parsed_query_selectors)
+        m_parsed_query_selectors.clear();
+    m_parsed_query_selectors.set(move(key), selectors);
+    return selectors;
+}
+
+Optional<Vector<GC::Ref<Node>> const&> Document::cached_query_selector_all_result(ParentNode const& scope, StringView selector_text) const
+{
+    if (m_query_selector_all_results_dom_tree_version != m_dom_tree_version)
+        return {};
+    for (auto const& result : m_query_selector_all_results) {
+        if (result.scope.ptr() == &scope && result.selector_text == selector_text)
+            return result.nodes;
+    }
+    return {};
+}
+
+void Document::cache_query_selector_all_result(ParentNode const& scope, String selector_text, Vector<GC::Ref<Node>> nodes)
+{
+    static constexpr size_t max_query_selector_all_results = 16;
+
+    if (m_query_selector_all_results_dom_tree_version != m_dom_tree_version) {
+        m_query_selector_all_results.clear();
+        m_query_selector_all_results_dom_tree_version = m_dom_tree_version;
+    }
+    if (m_query_selector_all_results.size() >= max_query_selector_all_results)
+        m_query_selector_all_results.remove(0);
+    m_query_selector_all_results.append({ scope, move(selector_text), move(nodes) });
+}
+
 ElementByIdMap& Document::element_by_id() const
 {
     if (!m_element_by_id)
@@ -23,6 +23,7 @@
 #include <LibURL/URL.h>
 #include <LibUnicode/Forward.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
+#include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/Cookie/Cookie.h>
 #include <LibWeb/DOM/ParentNode.h>
@@ -190,6 +191,15 @@ public:
     u64 character_data_version() const { return m_character_data_version; }
     void bump_character_data_version() { ++m_character_data_version; }
 
+    // Parses selectors for querySelector(), matches() and friends. Scripts tend to use the same few selectors over and
+    // over, so the result is remembered for each selector text.
+    Optional<CSS::SelectorList> parse_selector_for_query(StringView selector_text) const;
+
+    // The results of querySelectorAll() for selectors that only depend on the DOM tree, remembered until the next time
+    // dom_tree_version() changes.
+    Optional<Vector<GC::Ref<Node>> const&> cached_query_selector_all_result(ParentNode const& scope, StringView selector_text) const;
+    void cache_query_selector_all_result(ParentNode const& scope, String selector_text, Vector<GC::Ref<Node>>);
+
     WebIDL::ExceptionOr<void> populate_with_html_head_and_body();
 
     GC::Ptr<Selection::Selection> get_selection() const;
@@ -585,6 +595,9 @@ public:
     bool needs_full_style_update() const { return m_needs_full_style_update; }
     void set_needs_full_style_update(bool b) { m_needs_full_style_update = b; }
 
+    // Total number of elements whose style has been recomputed by style updates, for profiling style invalidation.
+    size_t restyled_element_count() const { return m_restyled_element_count; }
+
     [[nodiscard]] bool needs_full_layout_tree_update() const { return m_needs_full_layout_tree_update; }
     void set_needs_full_layout_tree_update(bool b) { m_needs_full_layout_tree_update = b; }
 
@@ -1072,6 +1085,7 @@ private:
     Vector<WeakPtr<CSS::MediaQueryList>> m_media_query_lists;
 
     bool m_needs_full_style_update { false };
+    size_t m_restyled_element_count { 0 };
     bool m_needs_full_layout_tree_update { false };
 
     bool m_needs_animated_style_update { false };
@@ -1203,6 +1217,16 @@ private:
     u64 m_dom_tree_version { 0 };
     u64 m_character_data_version { 0 };
 
+    mutable HashMap<String, Optional<CSS::SelectorList>> m_parsed_query_selectors;
+
+    struct QuerySelectorAllResult {
+        GC::Ref<ParentNode const> scope;
+        String selector_text;
+        Vector<GC::Ref<Node>> nodes;
+    };
+    u64 m_query_selector_all_results_dom_tree_version { 0 };
+    Vector<QuerySelectorAllResult> m_query_selector_all_results;
+
     // https://drafts.csswg.org/css-position-4/#document-top-layer
     // Documents have a top layer, an ordered set containing elements from the document.
     // Elements in the top layer do not lay out normally based on their position in the document;
@@ -511,9 +511,10 @@ void Node::invalidate_style(StyleInvalidationReason reason, Vector<CSS::Invalida
     }
 
     auto invalidation_set = document().style_computer().invalidation_set_for_properties(properties);
+    auto sibling_invalidation_set = document().style_computer().sibling_invalidation_set_for_properties(properties);
     if (options.invalidate_self)
         invalidation_set.set_needs_invalidate_self();
-    if (invalidation_set.is_empty())
+    if (invalidation_set.is_empty() && sibling_invalidation_set.is_empty())
         return;
 
     if (invalidation_set.needs_invalidate_whole_subtree()) {
@@ -521,40 +522,60 @@ void Node::invalidate_style(StyleInvalidationReason reason, Vector<CSS::Invalida
         return;
     }
 
+    size_t invalidated_element_count = 0;
+
     if (invalidation_set.needs_invalidate_self()) {
         set_needs_style_update(true);
+        ++invalidated_element_count;
     }
 
-    auto invalidate_entire_subtree = [&](Node& subtree_root) {
+    auto invalidate_entire_subtree = [&](Node& subtree_root, CSS::InvalidationSet const& subtree_invalidation_set) {
         subtree_root.for_each_shadow_including_inclusive_descendant([&](Node& node) {
             if (!node.is_element())
                 return TraversalDecision::Continue;
             auto& element = static_cast<Element&>(node);
             bool needs_style_recalculation = false;
-            if (invalidation_set.needs_invalidate_whole_subtree()) {
+            if (subtree_invalidation_set.needs_invalidate_whole_subtree()) {
                 VERIFY_NOT_REACHED();
             }
 
-            if (element.includes_properties_from_invalidation_set(invalidation_set)) {
+            if (element.includes_properties_from_invalidation_set(subtree_invalidation_set)) {
                 needs_style_recalculation = true;
             } else if (options.invalidate_elements_that_use_css_custom_properties && element.style_uses_css_custom_properties()) {
                 needs_style_recalculation = true;
             }
-            if (needs_style_recalculation)
+            if (needs_style_recalculation && !element.needs_style_update()) {
                 element.set_needs_style_update(true);
+                ++invalidated_element_count;
+            }
             return TraversalDecision::Continue;
         });
     };
 
-    invalidate_entire_subtree(*this);
+    if (!invalidation_set.is_empty())
+        invalidate_entire_subtree(*this, invalidation_set);
 
-    if (invalidation_set.needs_invalidate_whole_subtree()) {
+    // Elements matched through a sibling combinator can only be the subsequent siblings of this node or their
+    // descendants, so only those are visited for the sibling invalidation set.
+    if (!sibling_invalidation_set.is_empty()) {
         for (auto* sibling = next_sibling(); sibling; sibling = sibling->next_sibling()) {
-            if (sibling->is_element())
-                invalidate_entire_subtree(*sibling);
+            auto* element = as_if<Element>(sibling);
+            if (!element)
+                continue;
+            if (sibling_invalidation_set.needs_invalidate_whole_subtree()) {
+                if (element->affected_by_indirect_sibling_combinator() || element->affected_by_direct_sibling_combinator()) {
+                    element->set_entire_subtree_needs_style_update(true);
+                    element->set_needs_style_update(true);
+                    ++invalidated_element_count;
+                }
+                continue;
+            }
+            invalidate_entire_subtree(*element, sibling_invalidation_set);
         }
     }
 
+    dbgln_if(STYLE_INVALIDATION_DEBUG, "Invalidate style ({}) of {} element(s) for {}: {}", to_string(reason), invalidated_element_count, properties, debug_description());
+
     document().schedule_style_update();
 }
 
@@ -1788,15 +1809,8 @@ u16 Node::compare_document_position(GC::Ptr<Node> other)
         auto* ancestor2 = *it_node2_ancestors;
 
         // If ancestors of nodes at the same level in the tree are different then preceding node is the one with lower sibling position
-        if (ancestor1 != ancestor2) {
-            auto* node = ancestor1;
-            while (node) {
-                if (node == ancestor2)
-                    return DOCUMENT_POSITION_PRECEDING;
-                node = node->next_sibling();
-            }
-            return DOCUMENT_POSITION_FOLLOWING;
-        }
+        if (ancestor1 != ancestor2)
+            return ancestor1->index() < ancestor2->index() ? DOCUMENT_POSITION_PRECEDING : DOCUMENT_POSITION_FOLLOWING;
 
         it_node1_ancestors++;
         it_node2_ancestors++;
@@ -2588,15 +2602,50 @@ bool Node::is_inclusive_descendant_of(Node const& other) const
 }
 
 // https://dom.spec.whatwg.org/#concept-tree-following
-bool Node::is_following(Node const& other) const
+// https://dom.spec.whatwg.org/#concept-tree-order
+// OPTIMIZATION: Rather than walking the tree from one node until we find the other, which is linear in the size of the
+//               tree, compare the positions of their ancestors just below their lowest common ancestor.
+static bool comes_before_in_tree_order(Node const& a, Node const& b)
 {
-    // An object A is following an object B if A and B are in the same tree and A comes after B in tree order.
-    for (auto* node = previous_in_pre_order(); node; node = node->previous_in_pre_order()) {
-        if (node == &other)
-            return true;
+    Vector<Node const*, 32> a_ancestors;
+    for (auto const* node = &a; node; node = node->parent())
+        a_ancestors.append(node);
+
+    Vector<Node const*, 32> b_ancestors;
+    for (auto const* node = &b; node; node = node->parent())
+        b_ancestors.append(node);
+
+    // The nodes aren't in the same tree.
+    if (a_ancestors.last() != b_ancestors.last())
+        return false;
+
+    // Walk down from the root until the ancestor chains diverge.
+    auto a_it = a_ancestors.rbegin();
+    auto b_it = b_ancestors.rbegin();
+    while (a_it != a_ancestors.rend() && b_it != b_ancestors.rend()) {
+        if (*a_it != *b_it)
+            return (*a_it)->index() < (*b_it)->index();
+        ++a_it;
+        ++b_it;
     }
 
-    return false;
+    // One node is an inclusive ancestor of the other, and an ancestor comes before its descendants.
+    return a_ancestors.size() < b_ancestors.size();
+}
+
+bool Node::is_before(Node const& other) const
+{
+    if (this == &other)
+        return false;
+    return comes_before_in_tree_order(*this, other);
+}
+
+bool Node::is_following(Node const& other) const
+{
+    // An object A is following an object B if A and B are in the same tree and A comes after B in tree order.
+    if (this == &other)
+        return false;
+    return comes_before_in_tree_order(other, *this);
 }
 
 void Node::build_accessibility_tree(AccessibilityTreeNode& parent)
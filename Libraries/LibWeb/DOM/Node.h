@@ -452,16 +452,7 @@ public:
 
     bool is_following(Node const&) const;
 
-    bool is_before(Node const& other) const
-    {
-        if (this == &other)
-            return false;
-        for (auto* node = this; node; node = node->next_in_pre_order()) {
-            if (node == &other)
-                return true;
-        }
-        return false;
-    }
+    bool is_before(Node const& other) const;
 
     // https://dom.spec.whatwg.org/#concept-tree-preceding (Object A is 'typename U' and Object B is 'this')
     template<typename U>
@@ -43,6 +43,40 @@ static bool contains_named_namespace(const CSS::SelectorList& selectors)
     return false;
 }
 
+// Returns the only simple selector in selectors, if that's all there is to it. (e.g. `#foo` or `.bar`)
+static CSS::Selector::SimpleSelector const* sole_simple_selector(CSS::SelectorList const& selectors)
+{
+    if (selectors.size() != 1)
+        return nullptr;
+    auto const& compound_selectors = selectors.first()->compound_selectors();
+    if (compound_selectors.size() != 1 || compound_selectors.first().simple_selectors.size() != 1)
+        return nullptr;
+    return &compound_selectors.first().simple_selectors.first();
+}
+
+// Whether the set of elements matching selectors can only change when the DOM tree or an attribute changes,
+// as opposed to e.g. hover, focus or form control state.
+static bool matches_only_depend_on_dom_tree(CSS::SelectorList const& selectors)
+{
+    for (auto const& selector : selectors) {
+        for (auto const& compound_selector : selector->compound_selectors()) {
+            for (auto const& simple_selector : compound_selector.simple_selectors) {
+                switch (simple_selector.type) {
+                case CSS::Selector::SimpleSelector::Type::Universal:
+                case CSS::Selector::SimpleSelector::Type::TagName:
+                case CSS::Selector::SimpleSelector::Type::Id:
+                case CSS::Selector::SimpleSelector::Type::Class:
+                case CSS::Selector::SimpleSelector::Type::Attribute:
+                    continue;
+                default:
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 enum class ReturnMatches {
     First,
     All,
@@ -52,7 +86,7 @@ static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_m
 {
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams { node.document() }, selector_text);
+    auto maybe_selectors = node.document().parse_selector_for_query(selector_text);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -64,28 +98,68 @@ static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_m
     if (contains_named_namespace(selectors))
         return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_string);
 
+    auto const in_quirks_mode = node.document().in_quirks_mode();
+    auto const* simple_selector = sole_simple_selector(selectors);
+
+    // OPTIMIZATION: Documents and shadow roots keep a map of elements by ID, which answers `#id` without a tree walk.
+    //               IDs match case-insensitively in quirks mode, which the map doesn't support.
+    if (return_matches == ReturnMatches::First && simple_selector && simple_selector->type == CSS::Selector::SimpleSelector::Type::Id
+        && !in_quirks_mode && (node.is_document() || node.is_shadow_root())) {
+        return { node.get_element_by_id(simple_selector->name()) };
+    }
+
+    // OPTIMIZATION: Unless the selectors depend on something other than the DOM tree, the result of querySelectorAll()
+    //               stays the same until the tree changes, so we can hand out the same elements again.
+    auto const can_cache_result = return_matches == ReturnMatches::All && matches_only_depend_on_dom_tree(selectors);
+    if (can_cache_result) {
+        if (auto cached_result = node.document().cached_query_selector_all_result(node, selector_text); cached_result.has_value()) {
+            Vector<GC::Root<Node>> results;
+            results.ensure_capacity(cached_result->size());
+            for (auto const& result : *cached_result)
+                results.append(*result);
+            return { StaticNodeList::create(node.realm(), move(results)) };
+        }
+    }
+
+    auto element_matches = [&](Element const& element) {
+        // OPTIMIZATION: A lone `.class` doesn't need the full selector engine.
+        if (simple_selector && simple_selector->type == CSS::Selector::SimpleSelector::Type::Class)
+            return element.has_class(simple_selector->name(), in_quirks_mode ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive);
+
+        for (auto& selector : selectors) {
+            SelectorEngine::MatchContext context;
+            if (SelectorEngine::matches(selector, element, nullptr, context, {}, node))
+                return true;
+        }
+        return false;
+    };
+
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     GC::Ptr<Element> single_result;
     Vector<GC::Root<Node>> results;
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     node.for_each_in_subtree_of_type<Element>([&](auto& element) {
-        for (auto& selector : selectors) {
-            SelectorEngine::MatchContext context;
-            if (SelectorEngine::matches(selector, element, nullptr, context, {}, node)) {
-                if (return_matches == ReturnMatches::First) {
-                    single_result = &element;
-                    return TraversalDecision::Break;
-                }
-                results.append(element);
-                break;
-            }
+        if (!element_matches(element))
+            return TraversalDecision::Continue;
+        if (return_matches == ReturnMatches::First) {
+            single_result = &element;
+            return TraversalDecision::Break;
         }
+        results.append(element);
         return TraversalDecision::Continue;
     });
 
     if (return_matches == ReturnMatches::First)
         return { single_result };
 
+    if (can_cache_result) {
+        Vector<GC::Ref<Node>> result_nodes;
+        result_nodes.ensure_capacity(results.size());
+        for (auto const& result : results)
+            result_nodes.append(*result);
+        node.document().cache_query_selector_all_result(node, MUST(String::from_utf8(selector_text)), move(result_nodes));
+    }
+
     return { StaticNodeList::create(node.realm(), move(results)) };
 }
 
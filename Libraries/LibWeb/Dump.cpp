@@ -6,9 +6,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
+#include <LibGC/HeapBlock.h>
 #include <LibWeb/CSS/CSSDescriptors.h>
 #include <LibWeb/CSS/CSSFontFaceRule.h>
 #include <LibWeb/CSS/CSSImportRule.h>
@@ -29,6 +32,7 @@
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/PropertyID.h>
 #include <LibWeb/CSS/PseudoClass.h>
+#include <LibWeb/DOM/CharacterData.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ShadowRoot.h>
@@ -146,6 +150,58 @@ void dump_tree(StringBuilder& builder, DOM::Node const& node)
     --indent;
 }
 
+void dump_dom_memory_usage(DOM::Document& document)
+{
+    StringBuilder builder;
+    dump_dom_memory_usage(builder, document);
+    dbgln("{}", builder.string_view());
+}
+
+void dump_dom_memory_usage(StringBuilder& builder, DOM::Document& document)
+{
+    struct NodeTypeUsage {
+        size_t node_count { 0 };
+        size_t cell_bytes { 0 };
+        size_t text_bytes { 0 };
+        size_t text_heap_bytes { 0 };
+    };
+    HashMap<StringView, NodeTypeUsage> usage_by_node_type;
+
+    // Character data that shares its buffer with other nodes (e.g. interned whitespace) is only counted once.
+    HashTable<u8 const*> seen_text_buffers;
+
+    document.for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+        auto& usage = usage_by_node_type.ensure(node.class_name());
+        ++usage.node_count;
+        usage.cell_bytes += GC::HeapBlock::from_cell(&node)->cell_size();
+        if (auto const* character_data = as_if<DOM::CharacterData>(node)) {
+            auto const& data = character_data->data();
+            usage.text_bytes += data.bytes().size();
+            if (!data.is_short_string() && seen_text_buffers.set(data.bytes().data()) == HashSetResult::InsertedNewEntry)
+                usage.text_heap_bytes += data.bytes().size();
+        }
+        return TraversalDecision::Continue;
+    });
+
+    auto node_types = usage_by_node_type.keys();
+    quick_sort(node_types, [&](auto a, auto b) { return usage_by_node_type.get(a)->cell_bytes > usage_by_node_type.get(b)->cell_bytes; });
+
+    NodeTypeUsage total;
+    builder.appendff("DOM memory usage for {}\n", document.url());
+    for (auto node_type : node_types) {
+        auto usage = usage_by_node_type.get(node_type).value();
+        builder.appendff("  {}: {} node(s), {} cell byte(s)", node_type, usage.node_count, usage.cell_bytes);
+        if (usage.text_bytes != 0)
+            builder.appendff(", {} text byte(s) of which {} on the heap", usage.text_bytes, usage.text_heap_bytes);
+        builder.append('\n');
+        total.node_count += usage.node_count;
+        total.cell_bytes += usage.cell_bytes;
+        total.text_bytes += usage.text_bytes;
+        total.text_heap_bytes += usage.text_heap_bytes;
+    }
+    builder.appendff("  Total: {} node(s), {} cell byte(s), {} text byte(s) of which {} on the heap", total.node_count, total.cell_bytes, total.text_bytes, total.text_heap_bytes);
+}
+
 void dump_tree(Layout::Node const& layout_node, bool show_box_model, bool show_cascaded_properties)
 {
     StringBuilder builder;
@@ -15,6 +15,8 @@ namespace Web {
 void dump_tree(HTML::TraversableNavigable&);
 void dump_tree(StringBuilder&, DOM::Node const&);
 void dump_tree(DOM::Node const&);
+void dump_dom_memory_usage(StringBuilder&, DOM::Document&);
+void dump_dom_memory_usage(DOM::Document&);
 void dump_tree(StringBuilder&, Layout::Node const&, bool show_box_model = false, bool show_cascaded_properties = false, bool colorize = false);
 void dump_tree(Layout::Node const&, bool show_box_model = true, bool show_cascaded_properties = false);
 void dump_tree(StringBuilder&, Painting::Paintable const&, bool colorize = false, int indent = 0);
@@ -77,6 +77,55 @@ bool g_http_cache_enabled;
         _temporary_result.release_value();                                                           \
     })
 
+static Infrastructure::Request::InternalPriority determine_internal_priority(Infrastructure::Request const& request)
+{
+    using RequestServer::RequestPriority;
+
+    // Speculative fetches only matter once everything else has been loaded.
+    if (request.initiator().has_value() && first_is_one_of(*request.initiator(), Infrastructure::Request::Initiator::Prefetch, Infrastructure::Request::Initiator::Prerender))
+        return { RequestPriority::VeryLow };
+
+    // Resources that block rendering come first, followed by resources that are usually needed for the first paint.
+    // Media can be displayed progressively and is often not even in view yet.
+    auto priority = [&] {
+        if (!request.destination().has_value())
+            return RequestPriority::Medium;
+        switch (*request.destination()) {
+        case Infrastructure::Request::Destination::Document:
+        case Infrastructure::Request::Destination::Frame:
+        case Infrastructure::Request::Destination::IFrame:
+        case Infrastructure::Request::Destination::Style:
+            return RequestPriority::VeryHigh;
+        case Infrastructure::Request::Destination::Font:
+        case Infrastructure::Request::Destination::Script:
+            return request.render_blocking() ? RequestPriority::VeryHigh : RequestPriority::High;
+        case Infrastructure::Request::Destination::Audio:
+        case Infrastructure::Request::Destination::Image:
+        case Infrastructure::Request::Destination::Track:
+        case Infrastructure::Request::Destination::Video:
+            return RequestPriority::Low;
+        default:
+            return RequestPriority::Medium;
+        }
+    }();
+
+    // The author can move a request up or down by one level using the fetchpriority attribute.
+    switch (request.priority()) {
+    case Infrastructure::Request::Priority::High:
+        if (priority != RequestPriority::VeryHigh)
+            priority = static_cast<RequestPriority>(to_underlying(priority) + 1);
+        break;
+    case Infrastructure::Request::Priority::Low:
+        if (priority != RequestPriority::VeryLow)
+            priority = static_cast<RequestPriority>(to_underlying(priority) - 1);
+        break;
+    case Infrastructure::Request::Priority::Auto:
+        break;
+    }
+
+    return { priority };
+}
+
 // https://fetch.spec.whatwg.org/#concept-fetch
 WebIDL::ExceptionOr<GC::Ref<Infrastructure::FetchController>> fetch(JS::Realm& realm, Infrastructure::Request& request, Infrastructure::FetchAlgorithms const& algorithms, UseParallelQueue use_parallel_queue)
 {
@@ -253,6 +302,8 @@ WebIDL::ExceptionOr<GC::Ref<Infrastructure::FetchController>> fetch(JS::Realm& r
     //     in setting request’s priority to a user-agent-defined object.
     // NOTE: The user-agent-defined object could encompass stream weight and dependency for HTTP/2, and equivalent
     //       information used to prioritize dispatch and processing of HTTP/1 fetches.
+    if (!request.internal_priority().has_value())
+        request.set_internal_priority(determine_internal_priority(request));
 
     // 16. If request is a subresource request, then:
     if (request.is_subresource_request()) {
@@ -2298,10 +2349,19 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
     load_request.set_url(request->current_url());
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
+    if (request->internal_priority().has_value())
+        load_request.set_priority(request->internal_priority()->priority);
 
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
 
+    // NOTE: RequestServer keeps a disk cache shared by all WebContent processes. Partition it the same way as the HTTP
+    //       cache, so that one top-level site can't observe what another has loaded.
+    if (request->cache_mode() != Infrastructure::Request::CacheMode::NoStore) {
+        if (auto key = Infrastructure::determine_the_network_partition_key(*request); key.has_value() && !key->top_level_origin.is_opaque())
+            load_request.set_cache_partition_key(key->top_level_origin.serialize().to_byte_string());
+    }
+
     if (auto const* body = request->body().get_pointer<GC::Ref<Infrastructure::Body>>()) {
         TRY((*body)->source().visit(
             [&](ByteBuffer const& byte_buffer) -> WebIDL::ExceptionOr<void> {
@@ -2436,6 +2496,9 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
         });
 
         ResourceLoader::the().load_unbuffered(load_request, on_headers_received, on_data_received, on_complete);
+        fetch_params.controller()->set_update_priority_steps([load_request_id = load_request.id()](RequestServer::RequestPriority priority) {
+            ResourceLoader::the().set_request_priority(load_request_id, priority);
+        });
     } else {
         auto on_load_success = GC::create_function(vm.heap(), [&realm, &vm, request, pending_response, fetch_timing_info, cross_origin_isolated_capability](ReadonlyBytes data, Requests::RequestTimingInfo const& timing_info, HTTP::HeaderMap const& response_headers, Optional<u32> status_code, Optional<String> const& reason_phrase) {
             (void)request;
@@ -2496,6 +2559,9 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
         });
 
         ResourceLoader::the().load(load_request, on_load_success, on_load_error);
+        fetch_params.controller()->set_update_priority_steps([load_request_id = load_request.id()](RequestServer::RequestPriority priority) {
+            ResourceLoader::the().set_request_priority(load_request_id, priority);
+        });
     }
 
     return pending_response;
@@ -14,6 +14,8 @@
 
 namespace Web::Fetch::Fetching {
 
+extern bool g_http_cache_enabled;
+
 // https://fetch.spec.whatwg.org/#document-accept-header-value
 // The document `Accept` header value is `text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8`.
 constexpr auto document_accept_header_value = "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8"sv;
@@ -29,6 +29,7 @@ void FetchController::visit_edges(JS::Cell::Visitor& visitor)
     visitor.visit(m_full_timing_info);
     visitor.visit(m_report_timing_steps);
     visitor.visit(m_next_manual_redirect_steps);
+    visitor.visit(m_update_priority_steps);
     visitor.visit(m_fetch_params);
 }
 
@@ -42,6 +43,11 @@ void FetchController::set_next_manual_redirect_steps(Function<void()> next_manua
     m_next_manual_redirect_steps = GC::create_function(vm().heap(), move(next_manual_redirect_steps));
 }
 
+void FetchController::set_update_priority_steps(Function<void(RequestServer::RequestPriority)> update_priority_steps)
+{
+    m_update_priority_steps = GC::create_function(vm().heap(), move(update_priority_steps));
+}
+
 // https://fetch.spec.whatwg.org/#finalize-and-report-timing
 void FetchController::report_timing(JS::Object& global) const
 {
@@ -62,6 +68,16 @@ void FetchController::process_next_manual_redirect() const
     m_next_manual_redirect_steps->function()();
 }
 
+void FetchController::update_priority(RequestServer::RequestPriority priority) const
+{
+    // NOTE: Fetches that are not backed by a network request (e.g. data: URLs, or responses from the memory cache)
+    //       have nothing to reprioritize.
+    if (m_state != State::Ongoing || !m_update_priority_steps)
+        return;
+
+    m_update_priority_steps->function()(priority);
+}
+
 // https://fetch.spec.whatwg.org/#extract-full-timing-info
 GC::Ref<FetchTimingInfo> FetchController::extract_full_timing_info() const
 {
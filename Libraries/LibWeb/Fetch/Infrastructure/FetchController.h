@@ -17,6 +17,7 @@
 #include <LibWeb/Forward.h>
 #include <LibWeb/HTML/EventLoop/Task.h>
 #include <LibWeb/HTML/StructuredSerialize.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web::Fetch::Infrastructure {
 
@@ -37,11 +38,13 @@ public:
     void set_full_timing_info(GC::Ref<FetchTimingInfo> full_timing_info) { m_full_timing_info = full_timing_info; }
     void set_report_timing_steps(Function<void(JS::Object&)> report_timing_steps);
     void set_next_manual_redirect_steps(Function<void()> next_manual_redirect_steps);
+    void set_update_priority_steps(Function<void(RequestServer::RequestPriority)> update_priority_steps);
 
     [[nodiscard]] State state() const { return m_state; }
 
     void report_timing(JS::Object&) const;
     void process_next_manual_redirect() const;
+    void update_priority(RequestServer::RequestPriority) const;
     [[nodiscard]] GC::Ref<FetchTimingInfo> extract_full_timing_info() const;
     void abort(JS::Realm&, Optional<JS::Value>);
     JS::Value deserialize_a_serialized_abort_reason(JS::Realm&);
@@ -85,6 +88,10 @@ private:
     //     Null or an algorithm accepting nothing.
     GC::Ptr<GC::Function<void()>> m_next_manual_redirect_steps;
 
+    // AD-HOC: Steps that tell the network layer about a new priority for the ongoing fetch, e.g. because the element
+    //         that needs the response was scrolled into view.
+    GC::Ptr<GC::Function<void(RequestServer::RequestPriority)>> m_update_priority_steps;
+
     GC::Ptr<FetchParams> m_fetch_params;
 
     HashMap<u64, HTML::TaskID> m_ongoing_fetch_tasks;
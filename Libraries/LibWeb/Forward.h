@@ -474,6 +474,7 @@ struct DOMPointInit;
 
 namespace Web::HTML {
 
+class AnimatedBitmapDecodedImageData;
 class AnimationFrameCallbackDriver;
 class AudioTrack;
 class AudioTrackList;
@@ -840,6 +841,7 @@ class AutoplayAllowlist;
 namespace Web::Platform {
 
 class AudioCodecPlugin;
+class ProgressiveDecode;
 class Timer;
 
 }
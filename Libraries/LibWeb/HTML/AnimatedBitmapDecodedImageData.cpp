@@ -4,56 +4,434 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibGC/Heap.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/Painter.h>
 #include <LibJS/Runtime/Realm.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/HTML/DecodedImageCache.h>
 
 namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(AnimatedBitmapDecodedImageData);
 
-ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated)
+// The decoded frames of an animation are kept within this budget, unless a single frame is already larger.
+static constexpr size_t animation_frame_memory_budget = 32 * MiB;
+
+// Always decode at least this many frames ahead, so the next frame is usually ready by the time it is shown.
+static constexpr size_t minimum_decode_window_size = 2;
+
+static size_t size_in_bytes(Gfx::IntSize size)
+{
+    return max(static_cast<size_t>(size.width()) * size.height() * sizeof(u32), 1uz);
+}
+
+ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated, Optional<Gfx::IntSize> intrinsic_size)
 {
-    return realm.create<AnimatedBitmapDecodedImageData>(move(frames), loop_count, animated);
+    return realm.create<AnimatedBitmapDecodedImageData>(move(frames), loop_count, animated, intrinsic_size);
 }
 
-AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated)
+ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create_with_animation_session(JS::Realm& realm, Frame first_frame, size_t frame_count, ReadonlySpan<u32> frame_durations, size_t loop_count, Gfx::ColorSpace color_space, NonnullRefPtr<Platform::AnimationSession> animation_session)
+{
+    VERIFY(first_frame.bitmap);
+    VERIFY(frame_count > 1);
+
+    Vector<Frame> frames;
+    TRY(frames.try_resize(frame_count));
+    for (size_t i = 1; i < min(frame_count, frame_durations.size()); ++i)
+        frames[i].duration = static_cast<int>(frame_durations[i]);
+    frames[0] = move(first_frame);
+
+    auto image_data = realm.create<AnimatedBitmapDecodedImageData>(move(frames), loop_count, true, OptionalNone {});
+    image_data->m_color_space = move(color_space);
+    TRY(image_data->m_frame_is_pending.try_resize(frame_count));
+
+    auto frame_size = image_data->m_frames.first().bitmap->size();
+    auto frame_size_in_bytes = max(static_cast<size_t>(frame_size.width()) * frame_size.height() * sizeof(u32), 1uz);
+    image_data->m_decode_window_size = clamp(animation_frame_memory_budget / frame_size_in_bytes, minimum_decode_window_size, frame_count);
+
+    animation_session->on_frame_decoded = [image_data = image_data.ptr()](size_t frame_index, Platform::Frame frame) {
+        image_data->did_decode_frame(frame_index, move(frame));
+    };
+    image_data->m_animation_session = move(animation_session);
+
+    image_data->move_decode_window_to(0);
+    return image_data;
+}
+
+AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated, Optional<Gfx::IntSize> intrinsic_size)
     : m_frames(move(frames))
+    , m_size(intrinsic_size.value_or(m_frames.first().bitmap->size()))
     , m_loop_count(loop_count)
     , m_animated(animated)
 {
 }
 
-AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData() = default;
+AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData()
+{
+    if (m_animation_session)
+        m_animation_session->on_frame_decoded = nullptr;
+}
+
+void AnimatedBitmapDecodedImageData::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_document);
+}
+
+void AnimatedBitmapDecodedImageData::finalize()
+{
+    Base::finalize();
+
+    // NOTE: Elements that are finalized along with us may still remove themselves as our viewport users, which must
+    //       not bring us back into the cache.
+    if (m_document) {
+        DecodedImageCache::the().remove(*this);
+        m_document = nullptr;
+    }
+}
+
+void AnimatedBitmapDecodedImageData::enable_discarding(ByteBuffer encoded_data, Optional<Gfx::IntSize> ideal_decode_size, Gfx::ColorSpace color_space, GC::Ref<DOM::Document> document)
+{
+    VERIFY(!m_animation_session);
+    VERIFY(m_frames.size() == 1 && m_frames.first().bitmap);
+    VERIFY(!m_document);
+
+    m_encoded_data = move(encoded_data);
+    m_ideal_decode_size = ideal_decode_size;
+    m_color_space = move(color_space);
+    m_document = document;
+
+    m_decoded_size_in_bytes = size_in_bytes(m_frames.first().bitmap->size());
+
+    auto& cache = DecodedImageCache::the();
+    cache.add(*this);
+    if (m_viewport_user_count > 0 && m_visible_viewport_user_count == 0)
+        cache.did_become_invisible(*this);
+}
+
+void AnimatedBitmapDecodedImageData::add_viewport_user(bool is_visible)
+{
+    ++m_viewport_user_count;
+    if (is_visible)
+        ++m_visible_viewport_user_count;
+
+    if (!m_document)
+        return;
+
+    if (m_visible_viewport_user_count == 0) {
+        DecodedImageCache::the().did_become_invisible(*this);
+    } else if (is_visible && m_visible_viewport_user_count == 1) {
+        DecodedImageCache::the().did_become_visible(*this);
+
+        // OPTIMIZATION: Bring back discarded pixels as soon as the image scrolls into view, rather than waiting for it
+        //               to be painted.
+        if (is_discarded())
+            redecode();
+    }
+}
+
+void AnimatedBitmapDecodedImageData::remove_viewport_user(bool is_visible)
+{
+    VERIFY(m_viewport_user_count > 0);
+    --m_viewport_user_count;
+    if (is_visible) {
+        VERIFY(m_visible_viewport_user_count > 0);
+        --m_visible_viewport_user_count;
+    }
+
+    if (m_document && m_visible_viewport_user_count == 0)
+        DecodedImageCache::the().did_become_invisible(*this);
+}
+
+void AnimatedBitmapDecodedImageData::discard()
+{
+    m_frames.first().bitmap = nullptr;
+
+    // NOTE: The display list holds on to the bitmaps it draws, so it has to be recorded again for the memory to be freed.
+    m_document->set_needs_display();
+}
+
+void AnimatedBitmapDecodedImageData::redecode()
+{
+    if (m_is_redecoding)
+        return;
+    m_is_redecoding = true;
+
+    auto on_successful_decode = [strong_this = GC::Root(*this)](Platform::DecodedImage& result) -> ErrorOr<void> {
+        strong_this->did_redecode(result);
+        return {};
+    };
+
+    auto on_failed_decode = [strong_this = GC::Root(*this)](Error& error) {
+        dbgln("Failed to decode discarded image again: {}", error);
+        strong_this->m_is_redecoding = false;
+    };
+
+    (void)Platform::ImageCodecPlugin::the().decode_image(m_encoded_data.bytes(), move(on_successful_decode), move(on_failed_decode), m_ideal_decode_size);
+}
+
+void AnimatedBitmapDecodedImageData::keep_decoded()
+{
+    if (m_is_kept_decoded)
+        return;
+    m_is_kept_decoded = true;
+
+    if (!m_document)
+        return;
+
+    DecodedImageCache::the().did_become_visible(*this);
+    if (is_discarded())
+        redecode();
+}
+
+void AnimatedBitmapDecodedImageData::did_redecode(Platform::DecodedImage& result)
+{
+    m_is_redecoding = false;
+    if (result.frames.is_empty() || !result.frames.first().bitmap)
+        return;
+
+    did_redecode(Gfx::ImmutableBitmap::create(*result.frames.first().bitmap, Gfx::AlphaType::Premultiplied, m_color_space));
+}
+
+void AnimatedBitmapDecodedImageData::did_redecode(NonnullRefPtr<Gfx::ImmutableBitmap> bitmap)
+{
+    auto& cache = DecodedImageCache::the();
+
+    if (is_discarded()) {
+        m_frames.first().bitmap = move(bitmap);
+        m_decoded_size_in_bytes = size_in_bytes(m_frames.first().bitmap->size());
+
+        cache.did_redecode(*this);
+        if (m_viewport_user_count > 0 && m_visible_viewport_user_count == 0)
+            cache.did_become_invisible(*this);
+    } else {
+        // NOTE: This is a decode at a larger size than the one we have, see request_decode_at_size() and
+        //       natural_size_bitmap().
+        auto const& current_bitmap = m_frames.first().bitmap;
+        if (bitmap->width() <= current_bitmap->width() && bitmap->height() <= current_bitmap->height())
+            return;
 
-RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize) const
+        auto old_decoded_size_in_bytes = m_decoded_size_in_bytes;
+        m_frames.first().bitmap = move(bitmap);
+        m_decoded_size_in_bytes = size_in_bytes(m_frames.first().bitmap->size());
+        cache.did_change_decoded_size(*this, old_decoded_size_in_bytes);
+    }
+
+    m_document->set_needs_display();
+}
+
+void AnimatedBitmapDecodedImageData::request_decode_at_size(Gfx::IntSize size)
+{
+    if (m_is_redecoding || m_encoded_data.is_empty() || !m_ideal_decode_size.has_value())
+        return;
+
+    m_ideal_decode_size = Gfx::IntSize { max(m_ideal_decode_size->width(), size.width()), max(m_ideal_decode_size->height(), size.height()) };
+    dbgln_if(IMAGE_DECODER_DEBUG, "AnimatedBitmapDecodedImageData: Decoding {}x{} image again for ideal size {}", m_size.width(), m_size.height(), *m_ideal_decode_size);
+    redecode();
+}
+
+RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::decode_synchronously(Optional<Gfx::IntSize> ideal_size) const
+{
+    if (m_encoded_data.is_empty())
+        return nullptr;
+
+    // FIXME: Refactor the callers to handle the async nature of image decoding.
+    auto promise = Platform::ImageCodecPlugin::the().decode_image(m_encoded_data.bytes(), {}, {}, ideal_size);
+    auto result = promise->await();
+    if (result.is_error()) {
+        dbgln("Failed to decode image synchronously: {}", result.error());
+        return nullptr;
+    }
+
+    auto& frames = result.value().frames;
+    if (frames.is_empty() || !frames.first().bitmap)
+        return nullptr;
+    return Gfx::ImmutableBitmap::create(*frames.first().bitmap, Gfx::AlphaType::Premultiplied, m_color_space);
+}
+
+bool AnimatedBitmapDecodedImageData::is_in_decode_window(size_t frame_index) const
+{
+    auto distance = (frame_index + m_frames.size() - m_decode_window_start) % m_frames.size();
+    return distance < m_decode_window_size;
+}
+
+void AnimatedBitmapDecodedImageData::move_decode_window_to(size_t frame_index)
+{
+    // If the whole animation fits into our budget, there's nothing to move, we just keep every frame once it is decoded.
+    if (!keeps_every_frame()) {
+        m_decode_window_start = frame_index;
+
+        // Drop the frames that the animation has moved past, except for the one currently on screen.
+        for (size_t i = 0; i < m_frames.size(); ++i) {
+            if (i == m_last_shown_frame_index || is_in_decode_window(i))
+                continue;
+            m_frames[i].bitmap = nullptr;
+            m_frame_is_pending[i] = false;
+        }
+    }
+
+    // Ask for the frames of the window that we neither have nor are waiting for, in as few requests as possible.
+    Optional<size_t> run_start;
+    size_t run_length = 0;
+    auto flush_run = [&] {
+        if (run_start.has_value())
+            m_animation_session->request_frames(*run_start, run_length);
+        run_start.clear();
+        run_length = 0;
+    };
+
+    for (size_t offset = 0; offset < m_decode_window_size; ++offset) {
+        auto i = (m_decode_window_start + offset) % m_frames.size();
+        if (i == 0 && offset != 0)
+            flush_run();
+
+        if (m_frames[i].bitmap || m_frame_is_pending[i]) {
+            flush_run();
+            continue;
+        }
+
+        m_frame_is_pending[i] = true;
+        if (!run_start.has_value())
+            run_start = i;
+        ++run_length;
+    }
+    flush_run();
+}
+
+void AnimatedBitmapDecodedImageData::did_decode_frame(size_t frame_index, Platform::Frame frame)
+{
+    if (frame_index >= m_frames.size() || !frame.bitmap)
+        return;
+
+    m_frame_is_pending[frame_index] = false;
+
+    // The animation may have moved on while this frame was being decoded.
+    if (!keeps_every_frame() && !is_in_decode_window(frame_index))
+        return;
+
+    m_frames[frame_index] = Frame {
+        .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap, Gfx::AlphaType::Premultiplied, m_color_space),
+        .duration = static_cast<int>(frame.duration),
+    };
+
+    // If the animation is waiting for this frame, it can show it now.
+    if (frame_index == m_decode_window_start)
+        m_last_shown_frame_index = frame_index;
+}
+
+RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::natural_size_bitmap(size_t frame_index)
+{
+    // Decode the image again at its full size, which brings back discarded pixels and loses nothing to a reduced decode.
+    // This replaces the reduced bitmap rather than being kept next to it, so that the DecodedImageCache accounts for it.
+    // Since whoever needed it is likely to need it again, the image is decoded at its full size from now on.
+    if (frame_index == 0) {
+        if (auto bitmap = decode_synchronously({})) {
+            m_ideal_decode_size.clear();
+            did_redecode(bitmap.release_nonnull());
+            return m_frames.first().bitmap;
+        }
+    }
+
+    // NOTE: Without its encoded data, the best we can do is to scale up what we have. We don't hold on to the result,
+    //       since it would be memory that the DecodedImageCache doesn't know about.
+    auto const& bitmap = m_frames[frame_index].bitmap;
+    if (!bitmap)
+        return nullptr;
+
+    auto scaled_bitmap_or_error = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, m_size);
+    if (scaled_bitmap_or_error.is_error())
+        return bitmap;
+    auto scaled_bitmap = scaled_bitmap_or_error.release_value();
+
+    auto painter = Gfx::Painter::create(scaled_bitmap);
+    painter->draw_bitmap(scaled_bitmap->rect().to_type<float>(), *bitmap, bitmap->rect(), Gfx::ScalingMode::BilinearBlend, {}, 1, Gfx::CompositingAndBlendingOperator::SourceOver);
+    return Gfx::ImmutableBitmap::create(move(scaled_bitmap), Gfx::AlphaType::Premultiplied);
+}
+
+RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize size) const
 {
     if (frame_index >= m_frames.size())
         return nullptr;
+
+    if (!m_animation_session) {
+        auto const& bitmap = m_frames[frame_index].bitmap;
+        auto& self = const_cast<AnimatedBitmapDecodedImageData&>(*this);
+
+        // NOTE: Callers that don't tell us the size they want need the image right away and at its natural size, e.g. to
+        //       draw it into a canvas. If it was discarded or decoded at a reduced size, that takes a single decode at
+        //       its natural size.
+        if (size.is_empty()) {
+            if (bitmap ? bitmap->size() == m_size : !is_discarded())
+                return bitmap;
+            return self.natural_size_bitmap(frame_index);
+        }
+
+        // Painting can do without discarded pixels until they have been decoded again.
+        if (!bitmap) {
+            if (is_discarded())
+                self.redecode();
+            return nullptr;
+        }
+
+        if (bitmap->size() == m_size)
+            return bitmap;
+
+        // The image may be shown larger than it was decoded for, e.g. if its box has grown or we have been zoomed in.
+        // Keep showing what we have until it has been decoded again at a size that covers the new one.
+        if (size.width() > bitmap->width() || size.height() > bitmap->height())
+            self.request_decode_at_size(size);
+        return bitmap;
+    }
+
+    // If the frame isn't ready yet, keep showing the last one that was.
+    if (!m_frames[frame_index].bitmap)
+        return m_frames[m_last_shown_frame_index].bitmap;
     return m_frames[frame_index].bitmap;
 }
 
+void AnimatedBitmapDecodedImageData::advance_to_frame(size_t frame_index)
+{
+    if (!m_animation_session || frame_index >= m_frames.size())
+        return;
+
+    if (!keeps_every_frame() && frame_index != m_decode_window_start)
+        move_decode_window_to(frame_index);
+    else
+        m_decode_window_start = frame_index;
+
+    if (m_frames[frame_index].bitmap)
+        m_last_shown_frame_index = frame_index;
+}
+
 int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
 {
     if (frame_index >= m_frames.size())
         return 0;
+
+    // NOTE: Not every decoder knows a frame's duration before decoding it. Until we do, assume it's as long as the
+    //       frame we are showing in its place.
+    if (m_frames[frame_index].duration == 0 && m_animation_session && !m_frames[frame_index].bitmap)
+        return m_frames[m_last_shown_frame_index].duration;
+
     return m_frames[frame_index].duration;
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_width() const
 {
-    return m_frames.first().bitmap->width();
+    return m_size.width();
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_height() const
 {
-    return m_frames.first().bitmap->height();
+    return m_size.height();
 }
 
 Optional<CSSPixelFraction> AnimatedBitmapDecodedImageData::intrinsic_aspect_ratio() const
 {
-    return CSSPixels(m_frames.first().bitmap->width()) / CSSPixels(m_frames.first().bitmap->height());
+    return CSSPixels(m_size.width()) / CSSPixels(m_size.height());
 }
 
 }
@@ -6,8 +6,14 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Time.h>
+#include <LibGfx/ColorSpace.h>
 #include <LibGfx/ImmutableBitmap.h>
+#include <LibWeb/Forward.h>
 #include <LibWeb/HTML/DecodedImageData.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::HTML {
 
@@ -21,11 +27,33 @@ public:
         int duration { 0 };
     };
 
-    static ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated);
+    // If the frames were decoded at a reduced size, intrinsic_size is the actual size of the image.
+    static ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated, Optional<Gfx::IntSize> intrinsic_size = {});
+
+    // Creates image data for an animation of which only the first frame has been decoded. The remaining frames are
+    // decoded through the animation session as the animation reaches them, and dropped again once it has moved past
+    // them, unless all of them fit into our memory budget. Frame durations of 0 are filled in once a frame is decoded.
+    static ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> create_with_animation_session(JS::Realm&, Frame first_frame, size_t frame_count, ReadonlySpan<u32> frame_durations, size_t loop_count, Gfx::ColorSpace, NonnullRefPtr<Platform::AnimationSession>);
+
     virtual ~AnimatedBitmapDecodedImageData() override;
 
+    // Hands the encoded data of a still image to the DecodedImageCache, which may then discard its decoded pixels while no
+    // element displays it in the viewport. They are decoded again from the encoded data once they are needed.
+    void enable_discarding(ByteBuffer encoded_data, Optional<Gfx::IntSize> ideal_decode_size, Gfx::ColorSpace, GC::Ref<DOM::Document>);
+    bool is_discarded() const { return m_decoded_size_in_bytes > 0 && !m_frames.first().bitmap; }
+
+    // Elements that display the image tell us whether they are visible in the viewport.
+    void add_viewport_user(bool is_visible);
+    void remove_viewport_user(bool is_visible);
+
+    // Users that can't tell us whether they display the image in the viewport (e.g. CSS images) need its pixels for as
+    // long as it is alive, so they are never discarded once this has been called.
+    void keep_decoded();
+    bool is_kept_decoded() const { return m_is_kept_decoded; }
+
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const override;
     virtual int frame_duration(size_t frame_index) const override;
+    virtual void advance_to_frame(size_t frame_index) override;
 
     virtual size_t frame_count() const override { return m_frames.size(); }
     virtual size_t loop_count() const override { return m_loop_count; }
@@ -36,11 +64,57 @@ public:
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const override;
 
 private:
-    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated);
+    friend class DecodedImageCache;
+
+    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated, Optional<Gfx::IntSize> intrinsic_size);
+
+    virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
+
+    size_t decoded_size_in_bytes() const { return m_decoded_size_in_bytes; }
+    void discard();
+    void redecode();
+    void did_redecode(Platform::DecodedImage&);
+    void did_redecode(NonnullRefPtr<Gfx::ImmutableBitmap>);
+    void request_decode_at_size(Gfx::IntSize);
+    RefPtr<Gfx::ImmutableBitmap> decode_synchronously(Optional<Gfx::IntSize> ideal_size) const;
+
+    RefPtr<Gfx::ImmutableBitmap> natural_size_bitmap(size_t frame_index);
+
+    void did_decode_frame(size_t frame_index, Platform::Frame);
+    void move_decode_window_to(size_t frame_index);
+    bool is_in_decode_window(size_t frame_index) const;
+    bool keeps_every_frame() const { return m_decode_window_size >= m_frames.size(); }
 
     Vector<Frame> m_frames;
+    Gfx::IntSize m_size;
     size_t m_loop_count { 0 };
     bool m_animated { false };
+
+    RefPtr<Platform::AnimationSession> m_animation_session;
+    Gfx::ColorSpace m_color_space;
+    size_t m_decode_window_size { 0 };
+    Vector<bool> m_frame_is_pending;
+    size_t m_decode_window_start { 0 };
+    size_t m_last_shown_frame_index { 0 };
+
+    // Only set for images whose pixels can be discarded, see enable_discarding(). Images that were decoded at a reduced
+    // size are decoded again from the encoded data if they have to be shown larger, or at their natural size.
+    ByteBuffer m_encoded_data;
+    Optional<Gfx::IntSize> m_ideal_decode_size;
+    GC::Ptr<DOM::Document> m_document;
+    size_t m_decoded_size_in_bytes { 0 };
+    bool m_is_redecoding { false };
+    bool m_is_kept_decoded { false };
+
+    size_t m_viewport_user_count { 0 };
+    size_t m_visible_viewport_user_count { 0 };
+    MonotonicTime m_invisible_since { MonotonicTime::now_coarse() };
+
+    IntrusiveListNode<AnimatedBitmapDecodedImageData> m_decoded_image_cache_list_node;
+
+public:
+    using DecodedImageCacheList = IntrusiveList<&AnimatedBitmapDecodedImageData::m_decoded_image_cache_list_node>;
 };
 
 }
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibCore/Timer.h>
+#include <LibWeb/HTML/DecodedImageCache.h>
+
+namespace Web::HTML {
+
+// Images that were visible only moments ago are likely to be scrolled back into view, so leave them alone for a while.
+static constexpr auto minimum_time_invisible_before_discarding = AK::Duration::from_seconds(5);
+
+DecodedImageCache& DecodedImageCache::the()
+{
+    static DecodedImageCache cache;
+    return cache;
+}
+
+void DecodedImageCache::set_budget(size_t budget)
+{
+    m_budget = budget;
+    discard_images_if_needed();
+}
+
+DecodedImageCache::Statistics DecodedImageCache::statistics() const
+{
+    return {
+        .budget = m_budget,
+        .decoded_size = m_decoded_size,
+        .image_count = m_image_count,
+        .discarded_image_count = m_discarded_image_count,
+        .discard_count = m_discard_count,
+        .redecode_count = m_redecode_count,
+    };
+}
+
+void DecodedImageCache::dump_statistics() const
+{
+    dbgln("Decoded image cache statistics:");
+    dbgln("    Budget:          {} KiB", m_budget / KiB);
+    dbgln("    Decoded size:    {} KiB", m_decoded_size / KiB);
+    dbgln("    Images:          {} ({} discarded)", m_image_count, m_discarded_image_count);
+    dbgln("    Discards:        {}", m_discard_count);
+    dbgln("    Re-decodes:      {}", m_redecode_count);
+}
+
+void DecodedImageCache::add(AnimatedBitmapDecodedImageData& image)
+{
+    ++m_image_count;
+    m_decoded_size += image.decoded_size_in_bytes();
+    discard_images_if_needed();
+}
+
+void DecodedImageCache::remove(AnimatedBitmapDecodedImageData& image)
+{
+    if (image.m_decoded_image_cache_list_node.is_in_list())
+        m_invisible_images.remove(image);
+
+    --m_image_count;
+    if (image.is_discarded())
+        --m_discarded_image_count;
+    else
+        m_decoded_size -= image.decoded_size_in_bytes();
+}
+
+void DecodedImageCache::did_become_visible(AnimatedBitmapDecodedImageData& image)
+{
+    if (image.m_decoded_image_cache_list_node.is_in_list())
+        m_invisible_images.remove(image);
+}
+
+void DecodedImageCache::did_become_invisible(AnimatedBitmapDecodedImageData& image)
+{
+    if (image.is_discarded() || image.is_kept_decoded() || image.m_decoded_image_cache_list_node.is_in_list())
+        return;
+
+    image.m_invisible_since = MonotonicTime::now_coarse();
+    m_invisible_images.append(image);
+
+    if (m_decoded_size > m_budget)
+        schedule_discarding_images(minimum_time_invisible_before_discarding);
+}
+
+void DecodedImageCache::did_redecode(AnimatedBitmapDecodedImageData& image)
+{
+    --m_discarded_image_count;
+    m_decoded_size += image.decoded_size_in_bytes();
+    ++m_redecode_count;
+    discard_images_if_needed();
+}
+
+void DecodedImageCache::did_change_decoded_size(AnimatedBitmapDecodedImageData& image, size_t old_decoded_size)
+{
+    m_decoded_size -= old_decoded_size;
+    m_decoded_size += image.decoded_size_in_bytes();
+    discard_images_if_needed();
+}
+
+void DecodedImageCache::discard_images_if_needed()
+{
+    auto now = MonotonicTime::now_coarse();
+
+    while (m_decoded_size > m_budget && !m_invisible_images.is_empty()) {
+        auto& image = *m_invisible_images.first();
+
+        auto time_invisible = now - image.m_invisible_since;
+        if (time_invisible < minimum_time_invisible_before_discarding) {
+            schedule_discarding_images(minimum_time_invisible_before_discarding - time_invisible);
+            return;
+        }
+
+        discard(image);
+    }
+}
+
+void DecodedImageCache::discard_invisible_images()
+{
+    while (!m_invisible_images.is_empty())
+        discard(*m_invisible_images.first());
+}
+
+void DecodedImageCache::discard(AnimatedBitmapDecodedImageData& image)
+{
+    m_invisible_images.remove(image);
+    m_decoded_size -= image.decoded_size_in_bytes();
+    ++m_discarded_image_count;
+    ++m_discard_count;
+
+    dbgln_if(IMAGE_DECODER_DEBUG, "DecodedImageCache: Discarding {} KiB of image data, {} KiB of {} KiB in use", image.decoded_size_in_bytes() / KiB, m_decoded_size / KiB, m_budget / KiB);
+    image.discard();
+}
+
+void DecodedImageCache::schedule_discarding_images(AK::Duration delay)
+{
+    if (!m_discard_timer) {
+        m_discard_timer = Core::Timer::create_single_shot(0, [this] {
+            discard_images_if_needed();
+        });
+    }
+
+    if (m_discard_timer->is_active())
+        return;
+
+    m_discard_timer->set_interval(static_cast<int>(delay.to_milliseconds()) + 1);
+    m_discard_timer->start();
+}
+
+}
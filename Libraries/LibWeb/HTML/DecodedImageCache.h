@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Time.h>
+#include <LibCore/Forward.h>
+#include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+
+namespace Web::HTML {
+
+// Keeps the decoded pixels of the still images in this process within a memory budget. Images hold on to their encoded
+// data, so that once we run over budget, the pixels of those that haven't been visible for a while can be discarded,
+// least recently visible first. They are decoded again as soon as they are needed.
+class DecodedImageCache {
+public:
+    static DecodedImageCache& the();
+
+    static constexpr size_t default_budget = 256 * MiB;
+
+    size_t budget() const { return m_budget; }
+    void set_budget(size_t);
+
+    struct Statistics {
+        size_t budget { 0 };
+        size_t decoded_size { 0 };
+        size_t image_count { 0 };
+        size_t discarded_image_count { 0 };
+        u64 discard_count { 0 };
+        u64 redecode_count { 0 };
+    };
+    Statistics statistics() const;
+    void dump_statistics() const;
+
+    void add(AnimatedBitmapDecodedImageData&);
+    void remove(AnimatedBitmapDecodedImageData&);
+
+    void did_become_visible(AnimatedBitmapDecodedImageData&);
+    void did_become_invisible(AnimatedBitmapDecodedImageData&);
+
+    void did_redecode(AnimatedBitmapDecodedImageData&);
+    void did_change_decoded_size(AnimatedBitmapDecodedImageData&, size_t old_decoded_size);
+
+    // Discards the pixels of every image that nobody displays in the viewport, no matter how recently they were visible
+    // or how much memory is in use.
+    void discard_invisible_images();
+
+private:
+    DecodedImageCache() = default;
+
+    void discard_images_if_needed();
+    void discard(AnimatedBitmapDecodedImageData&);
+    void schedule_discarding_images(AK::Duration delay);
+
+    size_t m_budget { default_budget };
+    size_t m_decoded_size { 0 };
+    size_t m_image_count { 0 };
+    size_t m_discarded_image_count { 0 };
+    u64 m_discard_count { 0 };
+    u64 m_redecode_count { 0 };
+
+    // Decoded images that no element displays in the viewport, least recently visible first.
+    AnimatedBitmapDecodedImageData::DecodedImageCacheList m_invisible_images;
+
+    RefPtr<Core::Timer> m_discard_timer;
+};
+
+}
@@ -23,6 +23,9 @@ public:
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const = 0;
     virtual int frame_duration(size_t frame_index) const = 0;
 
+    // Animations call this when they move on to another frame, so that the frames following it can be prepared.
+    virtual void advance_to_frame(size_t) { }
+
     virtual size_t frame_count() const = 0;
     virtual size_t loop_count() const = 0;
     virtual bool is_animated() const = 0;
@@ -60,6 +60,9 @@ void HTMLImageElement::finalize()
 {
     Base::finalize();
     document().unregister_viewport_client(*this);
+
+    if (m_viewport_user_image_data)
+        m_viewport_user_image_data->remove_viewport_user(m_is_visible_in_viewport);
 }
 
 void HTMLImageElement::initialize(JS::Realm& realm)
@@ -81,6 +84,8 @@ void HTMLImageElement::visit_edges(Cell::Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_current_request);
     visitor.visit(m_pending_request);
+    visitor.visit(m_viewport_user_image_data);
+    visitor.visit(m_prioritized_request);
     visit_lazy_loading_element(visitor);
 }
 
@@ -192,14 +197,90 @@ Optional<CSSPixelFraction> HTMLImageElement::intrinsic_aspect_ratio() const
 
 RefPtr<Gfx::ImmutableBitmap> HTMLImageElement::current_image_bitmap(Gfx::IntSize size) const
 {
-    if (auto data = m_current_request->image_data())
-        return data->bitmap(m_current_frame_index, size);
-    return nullptr;
+    auto data = m_current_request->image_data();
+    if (!data)
+        return nullptr;
+
+    // NOTE: Painting an image that is out of view is no reason to decode its discarded pixels again.
+    if (!size.is_empty() && !m_is_visible_in_viewport) {
+        if (auto* bitmap_data = as_if<AnimatedBitmapDecodedImageData>(*data); bitmap_data && bitmap_data->is_discarded())
+            return nullptr;
+    }
+
+    return data->bitmap(m_current_frame_index, size);
 }
 
-void HTMLImageElement::set_visible_in_viewport(bool)
+Optional<Gfx::IntSize> HTMLImageElement::current_image_natural_size() const
 {
-    // FIXME: Loosen grip on image data when it's not visible, e.g via volatile memory.
+    // NOTE: Raster images may have been decoded at a reduced size, so we can't go by the size of their bitmap.
+    if (auto data = m_current_request->image_data(); data && is<AnimatedBitmapDecodedImageData>(*data))
+        return Gfx::IntSize { data->intrinsic_width()->to_int(), data->intrinsic_height()->to_int() };
+    if (auto bitmap = current_image_bitmap())
+        return bitmap->size();
+    return {};
+}
+
+// Returns the size in device pixels that the image is going to be displayed at, if we can tell before it has been
+// fetched. This allows it to be decoded at a reduced size if that is a lot smaller than the image itself.
+Optional<Gfx::IntSize> HTMLImageElement::ideal_decode_size() const
+{
+    // NOTE: With object-fit: none, the image is drawn at its natural size whatever the size of its box.
+    if (auto computed_properties = this->computed_properties(); computed_properties && computed_properties->object_fit() == CSS::ObjectFit::None)
+        return {};
+
+    auto device_pixels_per_css_pixel = document().page().client().device_pixels_per_css_pixel();
+    auto to_device_size = [&](double width, double height) -> Optional<Gfx::IntSize> {
+        if (width <= 0 || height <= 0)
+            return {};
+        return Gfx::IntSize { static_cast<int>(ceil(width * device_pixels_per_css_pixel)), static_cast<int>(ceil(height * device_pixels_per_css_pixel)) };
+    };
+
+    if (auto* paintable_box = this->paintable_box())
+        return to_device_size(paintable_box->content_width().to_double(), paintable_box->content_height().to_double());
+
+    // Until we have been laid out, the dimension attributes are our best guess, but only if both of them are there.
+    // NOTE: If the image ends up being shown larger than this (e.g. because CSS makes its box larger, gives it
+    //       object-fit: none, or the page is zoomed in), it is decoded again at the larger size once it is painted.
+    auto width_attribute = get_attribute(HTML::AttributeNames::width);
+    auto height_attribute = get_attribute(HTML::AttributeNames::height);
+    if (!width_attribute.has_value() || !height_attribute.has_value())
+        return {};
+
+    auto width = parse_non_negative_integer(*width_attribute);
+    auto height = parse_non_negative_integer(*height_attribute);
+    if (!width.has_value() || !height.has_value())
+        return {};
+    return to_device_size(*width, *height);
+}
+
+void HTMLImageElement::set_visible_in_viewport(bool visible_in_viewport)
+{
+    // AD-HOC: Images are fetched at a low priority, since most of them start out below the fold. When an image that is
+    //         still being fetched scrolls into view, move it ahead of those that are not visible, and back again when
+    //         it scrolls out. An explicit fetchpriority attribute takes precedence.
+    // NOTE: We're called for every image after each layout and scroll, so only tell the request about its priority when
+    //       the image's visibility (or the request itself) has changed.
+    if (m_prioritized_request != m_current_request || visible_in_viewport != m_is_visible_in_viewport) {
+        m_prioritized_request = m_current_request;
+        auto fetch_priority = Fetch::Infrastructure::request_priority_from_string(get_attribute_value(HTML::AttributeNames::fetchpriority));
+        if (!fetch_priority.has_value() || *fetch_priority == Fetch::Infrastructure::Request::Priority::Auto)
+            m_current_request->update_priority(visible_in_viewport ? RequestServer::RequestPriority::High : RequestServer::RequestPriority::Low);
+    }
+
+    // Let the decoded image know whether we are showing it, so that its pixels can be discarded while nobody does.
+    GC::Ptr<AnimatedBitmapDecodedImageData> image_data;
+    if (auto data = m_current_request->image_data())
+        image_data = as_if<AnimatedBitmapDecodedImageData>(*data);
+
+    if (image_data == m_viewport_user_image_data && visible_in_viewport == m_is_visible_in_viewport)
+        return;
+
+    if (m_viewport_user_image_data)
+        m_viewport_user_image_data->remove_viewport_user(m_is_visible_in_viewport);
+    m_viewport_user_image_data = image_data;
+    m_is_visible_in_viewport = visible_in_viewport;
+    if (m_viewport_user_image_data)
+        m_viewport_user_image_data->add_viewport_user(m_is_visible_in_viewport);
 }
 
 // https://html.spec.whatwg.org/multipage/embedded-content.html#dom-img-width
@@ -219,8 +300,8 @@ WebIDL::UnsignedLong HTMLImageElement::width() const
 
     // ...or else the density-corrected intrinsic width and height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available but not being rendered.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->width();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->width();
 
     // ...or else 0, if the image is not available or does not have intrinsic dimensions.
     return 0;
@@ -250,8 +331,8 @@ WebIDL::UnsignedLong HTMLImageElement::height() const
 
     // ...or else the density-corrected intrinsic height and height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available but not being rendered.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->height();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->height();
 
     // ...or else 0, if the image is not available or does not have intrinsic dimensions.
     return 0;
@@ -269,8 +350,8 @@ unsigned HTMLImageElement::natural_width() const
 {
     // Return the density-corrected intrinsic width of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->width();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->width();
 
     // ...or else 0.
     return 0;
@@ -281,8 +362,8 @@ unsigned HTMLImageElement::natural_height() const
 {
     // Return the density-corrected intrinsic height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->height();
+    if (auto size = current_image_natural_size(); size.has_value())
+        return size->height();
 
     // ...or else 0.
     return 0;
@@ -674,7 +755,7 @@ after_step_7:
 
         // 16. Set image request to a new image request whose current URL is urlString.
         auto image_request = ImageRequest::create(realm(), document().page());
-        image_request->set_current_url(realm(), url_string);
+        image_request->set_current_url(realm(), url_string, ideal_decode_size());
 
         // 17. If current request's state is unavailable or broken, then set the current request to image request.
         //     Otherwise, set the pending request to image request.
@@ -760,7 +841,10 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
                 image_request->set_state(ImageRequest::State::CompletelyAvailable);
 
                 // 3. Add the image to the list of available images using the key key, with the ignore higher-layer caching flag set.
-                document().list_of_available_images().add(key, *image_data, true);
+                // AD-HOC: Unless it was decoded for a smaller size than its natural size, in which case other img elements
+                //         can't be expected to display it at the same size.
+                if (!image_request->shared_resource_request()->ideal_decode_size().has_value())
+                    document().list_of_available_images().add(key, *image_data, true);
 
                 set_needs_style_update(true);
                 if (auto layout_node = this->layout_node())
@@ -800,6 +884,41 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request]() {
+            batching_dispatcher().enqueue(GC::create_function(realm().heap(), [this, image_request] {
+                // NOTE: Part of the image has been decoded, so we know its width and height.
+                VERIFY(image_request->shared_resource_request());
+                auto image_data = image_request->shared_resource_request()->image_data();
+                if (!image_data)
+                    return;
+
+                // https://html.spec.whatwg.org/multipage/images.html#update-the-image-data
+                // 2. Otherwise, if image request is the pending request and the user agent is able to determine image request's image's width and height,
+                //    abort the image request for the current request, upgrade the pending request to the current request, prepare image request for presentation given the img element,
+                //    and set image request's state to partially available.
+                if (image_request == m_pending_request) {
+                    abort_the_image_request(realm(), m_current_request);
+                    upgrade_pending_request_to_current_request();
+                    image_request->prepare_for_presentation(*this);
+                    image_request->set_state(ImageRequest::State::PartiallyAvailable);
+                }
+                // 3. Otherwise, if image request is the current request, its state is unavailable, and the user agent is able to determine image request's image's width and height,
+                //    then set image request's state to partially available.
+                else if (image_request == m_current_request && image_request->state() == ImageRequest::State::Unavailable) {
+                    image_request->set_state(ImageRequest::State::PartiallyAvailable);
+                }
+
+                // NOTE: Keep showing more of the image as it is decoded.
+                if (image_request != m_current_request || image_request->state() != ImageRequest::State::PartiallyAvailable)
+                    return;
+
+                image_request->set_image_data(image_data);
+
+                set_needs_style_update(true);
+                if (auto layout_node = this->layout_node())
+                    layout_node->set_needs_layout_update(DOM::SetNeedsLayoutReason::HTMLImageElementUpdateTheImageData);
+            }));
         });
 }
 
@@ -872,7 +991,7 @@ void HTMLImageElement::react_to_changes_in_the_environment()
 
     // 11. ⌛ Let image request be a new image request whose current URL is urlString
     auto image_request = ImageRequest::create(realm(), document().page());
-    image_request->set_current_url(realm(), url_string);
+    image_request->set_current_url(realm(), url_string, ideal_decode_size());
 
     // 12. ⌛ Let the element's pending request be image request.
     m_pending_request = image_request;
@@ -895,7 +1014,9 @@ void HTMLImageElement::react_to_changes_in_the_environment()
             image_request->set_state(ImageRequest::State::CompletelyAvailable);
 
             // 4. Add the image to the list of available images using the key key, with the ignore higher-layer caching flag set.
-            document().list_of_available_images().add(key, image_data, true);
+            // AD-HOC: Unless it was decoded for a smaller size than its natural size, see add_callbacks_to_image_request().
+            if (auto shared_resource_request = image_request->shared_resource_request(); !shared_resource_request || !shared_resource_request->ideal_decode_size().has_value())
+                document().list_of_available_images().add(key, image_data, true);
 
             // 5. Upgrade the pending request to the current request.
             upgrade_pending_request_to_current_request();
@@ -995,6 +1116,7 @@ void HTMLImageElement::restart_the_animation()
 
     auto image_data = m_current_request->image_data();
     if (image_data && image_data->frame_count() > 1) {
+        image_data->advance_to_frame(0);
         m_animation_timer->start();
     } else {
         m_animation_timer->stop();
@@ -1199,6 +1321,7 @@ void HTMLImageElement::animate()
     }
 
     m_current_frame_index = (m_current_frame_index + 1) % image_data->frame_count();
+    image_data->advance_to_frame(m_current_frame_index);
     auto current_frame_duration = image_data->frame_duration(m_current_frame_index);
 
     if (current_frame_duration != m_animation_timer->interval()) {
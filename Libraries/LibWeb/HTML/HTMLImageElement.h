@@ -136,6 +136,9 @@ private:
     void handle_failed_fetch();
     void add_callbacks_to_image_request(GC::Ref<ImageRequest>, bool maybe_omit_events, URL::URL const& url_string, String const& previous_url);
 
+    Optional<Gfx::IntSize> current_image_natural_size() const;
+    Optional<Gfx::IntSize> ideal_decode_size() const;
+
     void animate();
 
     RefPtr<Core::Timer> m_animation_timer;
@@ -159,6 +162,13 @@ private:
     SourceSet m_source_set;
 
     CSSPixelSize m_last_seen_viewport_size;
+
+    // The decoded image we have told whether we are showing it, see set_visible_in_viewport().
+    GC::Ptr<AnimatedBitmapDecodedImageData> m_viewport_user_image_data;
+    bool m_is_visible_in_viewport { false };
+
+    // The request whose fetch priority was last updated for our visibility, see set_visible_in_viewport().
+    GC::Ptr<ImageRequest> m_prioritized_request;
 };
 
 }
@@ -58,6 +58,14 @@ bool ImageRequest::is_fetching() const
     return m_shared_resource_request && m_shared_resource_request->is_fetching();
 }
 
+void ImageRequest::update_priority(RequestServer::RequestPriority priority)
+{
+    if (!is_fetching())
+        return;
+    if (auto fetch_controller = m_shared_resource_request->fetch_controller())
+        fetch_controller->update_priority(priority);
+}
+
 ImageRequest::State ImageRequest::state() const
 {
     return m_state;
@@ -68,11 +76,11 @@ void ImageRequest::set_state(State state)
     m_state = state;
 }
 
-void ImageRequest::set_current_url(JS::Realm& realm, String url)
+void ImageRequest::set_current_url(JS::Realm& realm, String url, Optional<Gfx::IntSize> ideal_decode_size)
 {
     m_current_url = move(url);
     if (auto url = URL::Parser::basic_parse(m_current_url); url.has_value())
-        m_shared_resource_request = SharedResourceRequest::get_or_create(realm, m_page, url.release_value());
+        m_shared_resource_request = SharedResourceRequest::get_or_create(realm, m_page, url.release_value(), ideal_decode_size, SharedResourceRequest::UserReportsVisibility::Yes);
 }
 
 // https://html.spec.whatwg.org/multipage/images.html#abort-the-image-request
@@ -127,10 +135,10 @@ void ImageRequest::fetch_image(JS::Realm& realm, GC::Ref<Fetch::Infrastructure::
     m_shared_resource_request->fetch_resource(realm, request);
 }
 
-void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial)
 {
     VERIFY(m_shared_resource_request);
-    m_shared_resource_request->add_callbacks(move(on_finish), move(on_fail));
+    m_shared_resource_request->add_callbacks(move(on_finish), move(on_fail), move(on_partial));
 }
 
 }
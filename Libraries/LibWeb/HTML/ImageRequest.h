@@ -12,6 +12,7 @@
 #include <LibGfx/Size.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Forward.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web::HTML {
 
@@ -40,7 +41,9 @@ public:
     void set_state(State);
 
     String const& current_url() const { return m_current_url; }
-    void set_current_url(JS::Realm&, String);
+    // If the image is going to be displayed a lot smaller than its natural size, ideal_decode_size lets it be decoded
+    // at a reduced size.
+    void set_current_url(JS::Realm&, String, Optional<Gfx::IntSize> ideal_decode_size = {});
 
     [[nodiscard]] GC::Ptr<DecodedImageData> image_data() const;
     void set_image_data(GC::Ptr<DecodedImageData>);
@@ -55,7 +58,10 @@ public:
     void prepare_for_presentation(HTMLImageElement&);
 
     void fetch_image(JS::Realm&, GC::Ref<Fetch::Infrastructure::Request>);
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial = {});
+
+    // Changes the network priority of the underlying fetch, if it is still in progress.
+    void update_priority(RequestServer::RequestPriority);
 
     GC::Ptr<SharedResourceRequest const> shared_resource_request() const { return m_shared_resource_request; }
 
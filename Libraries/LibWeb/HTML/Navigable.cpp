@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/CSS/Parser/Tokenizer.h>
 #include <LibWeb/CSS/SystemColor.h>
 #include <LibWeb/ContentSecurityPolicy/BlockingAlgorithms.h>
 #include <LibWeb/ContentSecurityPolicy/Directives/DirectiveOperations.h>
@@ -1632,6 +1633,11 @@ void Navigable::begin_navigation(NavigateParams params)
     // AD-HOC: Tell the UI that we started loading.
     if (is_top_level_traversable()) {
         active_browsing_context()->page().client().page_did_start_loading(url, false);
+
+        // AD-HOC: The tokens of style sheets are cached so that the next page of the same site can reuse them. Once we
+        //         leave the site, they are unlikely to be needed again.
+        if (auto document = active_document(); document && !document->origin().is_same_origin(url.origin()))
+            CSS::Parser::Tokenizer::clear_style_sheet_token_cache();
     }
 
     // 21. In parallel, run these steps:
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/Debug.h>
 #include <AK/SourceLocation.h>
 #include <AK/Utf32View.h>
@@ -14,6 +15,7 @@
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/StyleValues/LengthStyleValue.h>
 #include <LibWeb/CSS/StyleValues/PercentageStyleValue.h>
+#include <LibWeb/Cookie/Cookie.h>
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Comment.h>
 #include <LibWeb/DOM/Document.h>
@@ -25,6 +27,7 @@
 #include <LibWeb/DOM/QualifiedName.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/DOM/Text.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/HTML/CustomElements/CustomElementDefinition.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/EventNames.h>
@@ -38,12 +41,15 @@
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/HTML/Scripting/SimilarOriginWindowAgent.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Infra/CharacterTypes.h>
 #include <LibWeb/Infra/Strings.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/MathML/TagNames.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/SVG/SVGScriptElement.h>
@@ -265,6 +271,86 @@ void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point
     flush_character_insertions();
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // NOTE: Instead of a speculative HTML parser, we run a preload scanner over the input that hasn't been parsed yet.
+    //       Every time the parser blocks, the scanner looks a bit further ahead, continuing where it stopped the last
+    //       time. It pre-connects to the origins of the subresources it finds, so their fetches don't have to wait for
+    //       DNS resolution and connection setup, and preloads them into RequestServer's HTTP disk cache, so that the
+    //       real fetch can be served from there once the parser gets to them.
+    static constexpr size_t code_points_to_scan_per_block = 64 * KiB;
+
+    if (m_parsing_fragment || !m_document->browsing_context())
+        return;
+
+    auto unparsed_code_points = m_tokenizer.unparsed_code_points();
+    if (!m_preload_scanner) {
+        m_preload_scanner = make<HTMLPreloadScanner>(m_document->base_url(), m_document->encoding_or_default(), m_scripting_enabled);
+        m_preload_scanner->set_input(unparsed_code_points);
+        m_preload_scanner_input_length = m_tokenizer.input_length();
+    } else if (m_tokenizer.input_length() != m_preload_scanner_input_length) {
+        // NOTE: Input has been inserted since the scanner got its copy of it, e.g. by document.write() or because more
+        //       of a text document arrived. Scan everything the parser hasn't got to yet again, so we don't miss it.
+        m_preload_scanner->set_input(unparsed_code_points);
+        m_preload_scanner_input_length = m_tokenizer.input_length();
+    } else if (unparsed_code_points.size() < m_preload_scanner->remaining_input_length()) {
+        // NOTE: The parser has overtaken the scanner, so anything it would find before the parser's position is
+        //       already being fetched. Skip ahead instead of scanning it.
+        m_preload_scanner->set_input(unparsed_code_points);
+    }
+
+    for (auto const& preload_request : m_preload_scanner->scan(code_points_to_scan_per_block)) {
+        auto const& url = preload_request.url;
+        if (!url.scheme().is_one_of("http"sv, "https"sv))
+            continue;
+
+        auto origin = url.origin();
+        if (m_preconnected_origins.set(origin.serialize()) == AK::HashSetResult::InsertedNewEntry) {
+            dbgln_if(HTML_PARSER_DEBUG, "Preload scanner: Pre-connecting to {} for {}", origin.serialize(), url);
+            ResourceLoader::the().preconnect(url);
+        }
+
+        // NOTE: Without the disk cache, the response would be thrown away, and the resource fetched a second time.
+        if (Fetch::Fetching::g_http_cache_enabled && m_preloaded_urls.set(url.serialize()) == AK::HashSetResult::InsertedNewEntry)
+            preload_into_http_cache(preload_request);
+    }
+}
+
+void HTMLParser::preload_into_http_cache(PreloadRequest const& preload_request)
+{
+    auto const& url = preload_request.url;
+    dbgln_if(HTML_PARSER_DEBUG, "Preload scanner: Preloading {}", url);
+
+    LoadRequest request;
+    request.set_url(url);
+    request.set_page(m_document->page());
+    request.set_priority(RequestServer::RequestPriority::Low);
+
+    // NOTE: The response has to be one that the element's own fetch could have gotten, so send the same credentials and
+    //       Origin header that Fetch would, see http_network_or_cache_fetch().
+    auto const& document_origin = m_document->origin();
+    auto is_same_origin = url.origin().is_same_origin(document_origin);
+    auto include_credentials = preload_request.credentials_mode == Fetch::Infrastructure::Request::CredentialsMode::Include
+        || (preload_request.credentials_mode == Fetch::Infrastructure::Request::CredentialsMode::SameOrigin && is_same_origin);
+    if (include_credentials) {
+        if (auto cookie = m_document->page().client().page_did_request_cookie(url, Cookie::Source::Http); !cookie.is_empty())
+            request.set_header("Cookie", cookie.to_byte_string());
+    }
+    if (preload_request.mode == Fetch::Infrastructure::Request::Mode::CORS && !is_same_origin)
+        request.set_header("Origin", document_origin.serialize().to_byte_string());
+
+    // NOTE: This must match the cache partition key of the fetch that will use the response, see http_network_fetch().
+    auto const& top_level_origin = relevant_settings_object(*m_document).top_level_origin;
+    if (!top_level_origin.is_opaque())
+        request.set_cache_partition_key(top_level_origin.serialize().to_byte_string());
+
+    // NOTE: We only care about the response ending up in the disk cache, so there is nothing to do once it arrives.
+    auto on_load_success = GC::create_function(heap(), [](ReadonlyBytes, Requests::RequestTimingInfo const&, HTTP::HeaderMap const&, Optional<u32>, Optional<String> const&) {});
+    auto on_load_error = GC::create_function(heap(), [](ByteString const&, Requests::RequestTimingInfo const&, Optional<u32>, Optional<String> const&, ReadonlyBytes, HTTP::HeaderMap const&) {});
+    ResourceLoader::the().load(request, on_load_success, on_load_error);
+}
+
 void HTMLParser::run(const URL::URL& url, HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
 {
     m_document->set_url(url);
@@ -1281,12 +1367,23 @@ DOM::Text* HTMLParser::find_character_insertion_node()
     return new_text_node;
 }
 
+// OPTIMIZATION: Pretty-printed markup produces lots of text nodes whose data is the same run of whitespace (a newline
+//               followed by indentation). Runs too long for the short string optimization are interned, so all of
+//               these text nodes share a single allocation.
+static String text_node_data_from_builder(StringBuilder const& builder)
+{
+    auto data = builder.string_view();
+    if (data.length() > String::MAX_SHORT_STRING_BYTE_COUNT && all_of(data, [](char c) { return Infra::is_ascii_whitespace(c); }))
+        return FlyString::from_utf8_without_validation(data.bytes()).to_string();
+    return MUST(builder.to_string());
+}
+
 void HTMLParser::flush_character_insertions()
 {
     if (m_character_insertion_builder.is_empty())
         return;
     if (m_character_insertion_node->data().is_empty())
-        m_character_insertion_node->set_data(MUST(m_character_insertion_builder.to_string()));
+        m_character_insertion_node->set_data(text_node_data_from_builder(m_character_insertion_builder));
     else
         (void)m_character_insertion_node->append_data(MUST(m_character_insertion_builder.to_string()));
     m_character_insertion_builder.clear();
@@ -1294,6 +1391,16 @@ void HTMLParser::flush_character_insertions()
 
 void HTMLParser::insert_character(u32 data)
 {
+    // OPTIMIZATION: Character tokens arrive one code point at a time. While the parser keeps appending to the text node
+    //               that is the last child of the current node, the appropriate place for inserting the next character
+    //               can't have moved, so skip looking for it again.
+    if (m_character_insertion_node && !m_foster_parenting
+        && m_character_insertion_node->parent() == current_node().ptr()
+        && !m_character_insertion_node->next_sibling()) {
+        m_character_insertion_builder.append_code_point(data);
+        return;
+    }
+
     auto node = find_character_insertion_node();
     if (node == m_character_insertion_node.ptr()) {
         m_character_insertion_builder.append_code_point(data);
@@ -1309,6 +1416,17 @@ void HTMLParser::insert_character(u32 data)
     m_character_insertion_builder.append_code_point(data);
 }
 
+void HTMLParser::insert_characters(ReadonlySpan<u32> code_points)
+{
+    if (code_points.is_empty())
+        return;
+    insert_character(code_points.first());
+    if (!m_character_insertion_node)
+        return;
+    for (auto code_point : code_points.slice(1))
+        m_character_insertion_builder.append_code_point(code_point);
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#the-after-head-insertion-mode
 void HTMLParser::handle_after_head(HTMLToken& token)
 {
@@ -3083,7 +3201,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    start_the_speculative_html_parser();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -3102,7 +3221,9 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: Our preload scanner only scans a bounded amount of input each time it is started, and is
+                    //       kept around so it can continue where it stopped the next time the parser blocks.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -3347,7 +3468,10 @@ void HTMLParser::handle_in_table_text(HTMLToken& token)
         }
         // Any other character token
         // Append the character token to the pending table character tokens list.
-        m_pending_table_character_tokens.append(move(token));
+        // NOTE: We only keep the code points, and remember whether any of them was not whitespace as we go.
+        m_pending_table_characters.append(token.code_point());
+        if (!token.is_parser_whitespace())
+            m_pending_table_characters_contain_non_whitespace = true;
         return;
     }
 
@@ -3357,18 +3481,17 @@ void HTMLParser::handle_in_table_text(HTMLToken& token)
     // are character tokens that are not ASCII whitespace, then this is a parse error:
     // reprocess the character tokens in the pending table character tokens list using
     // the rules given in the "anything else" entry in the "in table" insertion mode.
-    if (any_of(m_pending_table_character_tokens, [](auto const& token) { return !token.is_parser_whitespace(); })) {
+    if (m_pending_table_characters_contain_non_whitespace) {
         log_parse_error();
-        for (auto& pending_token : m_pending_table_character_tokens) {
+        for (auto code_point : m_pending_table_characters) {
+            auto pending_token = HTMLToken::make_character(code_point);
             m_foster_parenting = true;
             process_using_the_rules_for(InsertionMode::InBody, pending_token);
             m_foster_parenting = false;
         }
     } else {
         // Otherwise, insert the characters given by the pending table character tokens list.
-        for (auto& pending_token : m_pending_table_character_tokens) {
-            insert_character(pending_token.code_point());
-        }
+        insert_characters(m_pending_table_characters);
     }
 
     // Switch the insertion mode to the original insertion mode and reprocess the token.
@@ -3437,7 +3560,8 @@ void HTMLParser::handle_in_table(HTMLToken& token)
     // A character token, if the current node is table, tbody, template, tfoot, thead, or tr element
     if (token.is_character() && current_node()->local_name().is_one_of(HTML::TagNames::table, HTML::TagNames::tbody, HTML::TagNames::tfoot, HTML::TagNames::thead, HTML::TagNames::tr)) {
         // Let the pending table character tokens be an empty list of tokens.
-        m_pending_table_character_tokens.clear();
+        m_pending_table_characters.clear();
+        m_pending_table_characters_contain_non_whitespace = false;
 
         // Let the original insertion mode be the current insertion mode.
         m_original_insertion_mode = m_insertion_mode;
@@ -4560,8 +4684,42 @@ DOM::Document& HTMLParser::document()
 }
 
 // https://html.spec.whatwg.org/multipage/parsing.html#parsing-html-fragments
+// Returns true if parsing markup as a fragment with the given context element is known to produce a single text node
+// holding markup as-is (or nothing, if markup is empty).
+static bool fragment_parses_as_plain_text(DOM::Element const& context_element, StringView markup)
+{
+    // The tokenizer only emits the input as character tokens verbatim when in the data state, and there is no markup,
+    // character reference or newline and U+0000 NULL handling to do.
+    for (auto byte : markup.bytes()) {
+        if (byte == '<' || byte == '&' || byte == '\r' || byte == '\0')
+            return false;
+    }
+
+    // The context element must be an HTML element that leaves the tokenizer in the data state, and for which resetting
+    // the insertion mode appropriately ends up in a mode where character tokens are inserted as they are.
+    if (context_element.namespace_uri() != Namespace::HTML)
+        return false;
+    return !context_element.local_name().is_one_of(
+        HTML::TagNames::title, HTML::TagNames::textarea, HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe,
+        HTML::TagNames::noembed, HTML::TagNames::noframes, HTML::TagNames::script, HTML::TagNames::noscript, HTML::TagNames::plaintext,
+        HTML::TagNames::select, HTML::TagNames::tr, HTML::TagNames::tbody, HTML::TagNames::thead, HTML::TagNames::tfoot,
+        HTML::TagNames::colgroup, HTML::TagNames::table, HTML::TagNames::template_, HTML::TagNames::html, HTML::TagNames::frameset);
+}
+
 Vector<GC::Root<DOM::Node>> HTMLParser::parse_html_fragment(DOM::Element& context_element, StringView markup, AllowDeclarativeShadowRoots allow_declarative_shadow_roots)
 {
+    // OPTIMIZATION: Setting innerHTML to plain text is common, and the result is a single text node. Create it directly
+    //               instead of setting up a temporary document and parser to arrive at the same result.
+    if (fragment_parses_as_plain_text(context_element, markup)) {
+        if (markup.is_empty())
+            return {};
+        if (auto data = String::from_utf8(markup); !data.is_error()) {
+            Vector<GC::Root<DOM::Node>> children;
+            children.append(GC::make_root(context_element.document().create_text_node(data.release_value())));
+            return children;
+        }
+    }
+
     // 1. Let document be a Document node whose type is "html".
     auto temp_document = DOM::Document::create_for_fragment_parsing(context_element.realm());
     temp_document->set_document_type(DOM::Document::Type::HTML);
@@ -4687,41 +4845,75 @@ enum class AttributeMode {
     Yes,
 };
 
-static String escape_string(StringView string, AttributeMode attribute_mode)
+// https://html.spec.whatwg.org/multipage/parsing.html#escapingString
+static void append_escaped_string(StringBuilder& builder, StringView string, AttributeMode attribute_mode)
 {
-    // https://html.spec.whatwg.org/multipage/parsing.html#escapingString
-    StringBuilder builder;
-    for (auto code_point : Utf8View { string }) {
+    // OPTIMIZATION: Everything that needs escaping is either a single ASCII byte or U+00A0 NO-BREAK SPACE, which is
+    //               encoded as the bytes C2 A0. Scan the UTF-8 bytes directly and append the runs between them in bulk,
+    //               instead of decoding and re-encoding every code point.
+    auto bytes = string.bytes();
+    size_t run_start = 0;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        StringView replacement;
+        size_t byte_count = 1;
+        switch (bytes[i]) {
         // 1. Replace any occurrence of the "&" character by the string "&amp;".
-        if (code_point == '&')
-            builder.append("&amp;"sv);
+        case '&':
+            replacement = "&amp;"sv;
+            break;
         // 2. Replace any occurrences of the U+00A0 NO-BREAK SPACE character by the string "&nbsp;".
-        else if (code_point == 0xA0)
-            builder.append("&nbsp;"sv);
+        case 0xC2:
+            if (i + 1 < bytes.size() && bytes[i + 1] == 0xA0) {
+                replacement = "&nbsp;"sv;
+                byte_count = 2;
+            }
+            break;
         // 3. If the algorithm was invoked in the attribute mode, replace any occurrences of the """ character by the string "&quot;".
-        else if (code_point == '"' && attribute_mode == AttributeMode::Yes)
-            builder.append("&quot;"sv);
+        case '"':
+            if (attribute_mode == AttributeMode::Yes)
+                replacement = "&quot;"sv;
+            break;
         // 4. If the algorithm was not invoked in the attribute mode, replace any occurrences of the "<" character by the string "&lt;", and any occurrences of the ">" character by the string "&gt;".
-        else if (code_point == '<' && attribute_mode == AttributeMode::No)
-            builder.append("&lt;"sv);
-        else if (code_point == '>' && attribute_mode == AttributeMode::No)
-            builder.append("&gt;"sv);
-        else
-            builder.append_code_point(code_point);
-    }
-    return builder.to_string_without_validation();
+        case '<':
+            if (attribute_mode == AttributeMode::No)
+                replacement = "&lt;"sv;
+            break;
+        case '>':
+            if (attribute_mode == AttributeMode::No)
+                replacement = "&gt;"sv;
+            break;
+        default:
+            break;
+        }
+        if (replacement.is_null())
+            continue;
+        builder.append(string.substring_view(run_start, i - run_start));
+        builder.append(replacement);
+        i += byte_count - 1;
+        run_start = i + 1;
+    }
+    builder.append(string.substring_view(run_start));
 }
 
 // https://html.spec.whatwg.org/multipage/parsing.html#html-fragment-serialisation-algorithm
 String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableShadowRoots serializable_shadow_roots, Vector<GC::Root<DOM::ShadowRoot>> const& shadow_roots, DOM::FragmentSerializationMode fragment_serialization_mode)
+{
+    // 2. Let s be a string, and initialize it to the empty string.
+    StringBuilder builder;
+    append_html_fragment_serialization(builder, node, serializable_shadow_roots, shadow_roots, fragment_serialization_mode);
+
+    // 6. Return s.
+    return builder.to_string_without_validation();
+}
+
+// OPTIMIZATION: The whole serialization, including that of descendants, is streamed into the single StringBuilder
+//               backing s, instead of building and copying a separate string for every element.
+void HTMLParser::append_html_fragment_serialization(StringBuilder& builder, DOM::Node const& node, SerializableShadowRoots serializable_shadow_roots, Vector<GC::Root<DOM::ShadowRoot>> const& shadow_roots, DOM::FragmentSerializationMode fragment_serialization_mode)
 {
     // NOTE: Steps in this function are jumbled a bit to accommodate the Element.outerHTML API.
     //       When called with FragmentSerializationMode::Outer, we will serialize the element itself,
     //       not just its children.
 
-    // 2. Let s be a string, and initialize it to the empty string.
-    StringBuilder builder;
-
     auto serialize_element = [&](DOM::Element const& element) {
         // If current node is an element in the HTML namespace, the MathML namespace, or the SVG namespace, then let tagname be current node's local name.
         // Otherwise, let tagname be current node's qualified name.
@@ -4742,7 +4934,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
         // followed by a U+0022 QUOTATION MARK character (").
         if (element.is_value().has_value() && !element.has_attribute(AttributeNames::is)) {
             builder.append(" is=\""sv);
-            builder.append(escape_string(element.is_value().value(), AttributeMode::Yes));
+            append_escaped_string(builder, element.is_value().value(), AttributeMode::Yes);
             builder.append('"');
         }
 
@@ -4775,7 +4967,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
             builder.append(attribute.name());
 
             builder.append("=\""sv);
-            builder.append(escape_string(attribute.value(), AttributeMode::Yes));
+            append_escaped_string(builder, attribute.value(), AttributeMode::Yes);
             builder.append('"');
         });
 
@@ -4792,7 +4984,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
         // a U+002F SOLIDUS character (/),
         // tagname again,
         // and finally a U+003E GREATER-THAN SIGN character (>).
-        builder.append(serialize_html_fragment(element, serializable_shadow_roots, shadow_roots));
+        append_html_fragment_serialization(builder, element, serializable_shadow_roots, shadow_roots, DOM::FragmentSerializationMode::Inner);
         builder.append("</"sv);
         builder.append(tag_name);
         builder.append('>');
@@ -4802,7 +4994,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
 
     if (fragment_serialization_mode == DOM::FragmentSerializationMode::Outer) {
         serialize_element(as<DOM::Element>(node));
-        return builder.to_string_without_validation();
+        return;
     }
 
     // The algorithm takes as input a DOM Element, Document, or DocumentFragment referred to as the node.
@@ -4815,7 +5007,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
         // 1. If the node serializes as void, then return the empty string.
         //    (NOTE: serializes as void is defined only on elements in the spec)
         if (element.serializes_as_void())
-            return String {};
+            return;
 
         // 3. If the node is a template element, then let the node instead be the template element's template contents (a DocumentFragment node).
         //    (NOTE: This is out of order of the spec to avoid another dynamic cast. The second step just creates a string builder, so it shouldn't matter)
@@ -4859,7 +5051,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
 
                 // 8. Append the value of running the HTML fragment serialization algorithm with shadow,
                 //    serializableShadowRoots, and shadowRoots (thus recursing into this algorithm for that element).
-                builder.append(serialize_html_fragment(*shadow, serializable_shadow_roots, shadow_roots));
+                append_html_fragment_serialization(builder, *shadow, serializable_shadow_roots, shadow_roots, DOM::FragmentSerializationMode::Inner);
 
                 // 9. Append "</template>".
                 builder.append("</template>"sv);
@@ -4898,7 +5090,7 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
             }
 
             // Otherwise, append the value of current node's data IDL attribute, escaped as described below.
-            builder.append(escape_string(text_node.data(), AttributeMode::No));
+            append_escaped_string(builder, text_node.data(), AttributeMode::No);
         }
 
         if (is<DOM::Comment>(current_node)) {
@@ -4942,9 +5134,6 @@ String HTMLParser::serialize_html_fragment(DOM::Node const& node, SerializableSh
 
         return IterationDecision::Continue;
     });
-
-    // 6. Return s.
-    return MUST(builder.to_string());
 }
 
 // https://html.spec.whatwg.org/multipage/common-microsyntaxes.html#current-dimension-value
@@ -5212,7 +5401,8 @@ void HTMLParser::abort()
     // 1. Throw away any pending content in the input stream, and discard any future content that would have been added to it.
     m_tokenizer.abort();
 
-    // FIXME: 2. Stop the speculative HTML parser for this HTML parser.
+    // 2. Stop the speculative HTML parser for this HTML parser.
+    m_preload_scanner = nullptr;
 
     // 3. Update the current document readiness to "interactive".
     m_document->update_readiness(DocumentReadyState::Interactive);
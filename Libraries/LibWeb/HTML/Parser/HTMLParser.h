@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <AK/HashTable.h>
 #include <LibGfx/Color.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/DOM/Node.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
 #include <LibWeb/HTML/Parser/StackOfOpenElements.h>
@@ -103,6 +105,8 @@ public:
 
 private:
     HTMLParser(DOM::Document&, StringView input, StringView encoding);
+
+    static void append_html_fragment_serialization(StringBuilder&, DOM::Node const&, SerializableShadowRoots, Vector<GC::Root<DOM::ShadowRoot>> const&, DOM::FragmentSerializationMode);
     HTMLParser(DOM::Document&);
 
     virtual void visit_edges(Cell::Visitor&) override;
@@ -163,6 +167,7 @@ private:
     [[nodiscard]] GC::Ptr<DOM::Element> adjusted_current_node();
     [[nodiscard]] GC::Ptr<DOM::Element> node_before_current_node();
     void insert_character(u32 data);
+    void insert_characters(ReadonlySpan<u32>);
     void insert_comment(HTMLToken&);
     void reconstruct_the_active_formatting_elements();
     void close_a_p_element();
@@ -173,6 +178,9 @@ private:
     void decrement_script_nesting_level();
     void reset_the_insertion_mode_appropriately();
 
+    void start_the_speculative_html_parser();
+    void preload_into_http_cache(PreloadRequest const&);
+
     void adjust_mathml_attributes(HTMLToken&);
     void adjust_svg_tag_names(HTMLToken&);
     void adjust_svg_attributes(HTMLToken&);
@@ -225,7 +233,13 @@ private:
     GC::ForeignPtr<Web::SpeculativeHTMLParser> m_speculative_parser;
 #endif
 
-    Vector<HTMLToken> m_pending_table_character_tokens;
+    OwnPtr<HTMLPreloadScanner> m_preload_scanner;
+    size_t m_preload_scanner_input_length { 0 };
+    HashTable<String> m_preconnected_origins;
+    HashTable<String> m_preloaded_urls;
+
+    Vector<u32> m_pending_table_characters;
+    bool m_pending_table_characters_contain_non_whitespace { false };
 
     GC::Ptr<DOM::Text> m_character_insertion_node;
     StringBuilder m_character_insertion_builder;
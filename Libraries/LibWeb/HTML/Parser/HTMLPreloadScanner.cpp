@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/SourceSet.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Infra/Strings.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+HTMLPreloadScanner::HTMLPreloadScanner(URL::URL base_url, String encoding, bool scripting_enabled)
+    : m_base_url(move(base_url))
+    , m_encoding(move(encoding))
+    , m_scripting_enabled(scripting_enabled)
+{
+}
+
+HTMLPreloadScanner::~HTMLPreloadScanner() = default;
+
+void HTMLPreloadScanner::set_input(ReadonlySpan<u32> code_points)
+{
+    m_tokenizer = make<HTMLTokenizer>(code_points);
+    m_has_reached_end_of_input = false;
+}
+
+void HTMLPreloadScanner::set_input(StringView input)
+{
+    m_tokenizer = make<HTMLTokenizer>(input, "utf-8"sv);
+    m_has_reached_end_of_input = false;
+}
+
+size_t HTMLPreloadScanner::remaining_input_length() const
+{
+    if (!m_tokenizer)
+        return 0;
+    return m_tokenizer->unparsed_code_points().size();
+}
+
+static bool link_types_are_fetched_eagerly(StringView rel)
+{
+    for (auto link_type : rel.split_view_if(Infra::is_ascii_whitespace)) {
+        if (link_type.equals_ignoring_ascii_case("stylesheet"sv)
+            || link_type.equals_ignoring_ascii_case("preload"sv)
+            || link_type.equals_ignoring_ascii_case("modulepreload"sv))
+            return true;
+    }
+    return false;
+}
+
+static bool link_types_contain_modulepreload(StringView rel)
+{
+    for (auto link_type : rel.split_view_if(Infra::is_ascii_whitespace)) {
+        if (link_type.equals_ignoring_ascii_case("modulepreload"sv))
+            return true;
+    }
+    return false;
+}
+
+enum class ScriptType {
+    Classic,
+    Module,
+};
+
+// https://html.spec.whatwg.org/multipage/scripting.html#prepare-the-script-element
+// Returns the type of script that a script element with these attributes fetches, if it fetches one at all.
+static Optional<ScriptType> fetched_script_type(HTMLToken const& token)
+{
+    // 8. If any of the following are true: el has a type attribute whose value is the empty string; el has no type
+    //    attribute but it has a language attribute and that attribute's value is the empty string; or el has neither
+    //    a type attribute nor a language attribute, then let the script block's type string be "text/javascript".
+    auto type = token.attribute(AttributeNames::type);
+    auto language = token.attribute(AttributeNames::language);
+    String script_block_type;
+    if ((type.has_value() && type->is_empty()) || (!type.has_value() && (!language.has_value() || language->is_empty())))
+        script_block_type = "text/javascript"_string;
+    // Otherwise, if el has a type attribute, then let the script block's type string be the value of that attribute
+    // with leading and trailing ASCII whitespace stripped.
+    else if (type.has_value())
+        script_block_type = MUST(type->trim(Infra::ASCII_WHITESPACE));
+    // Otherwise, el has a non-empty language attribute; let the script block's type string be the concatenation of
+    // "text/" and the value of el's language attribute.
+    else
+        script_block_type = MUST(String::formatted("text/{}", *language));
+
+    // 9. If the script block's type string is a JavaScript MIME type essence match, then set el's type to "classic".
+    if (MimeSniff::is_javascript_mime_type_essence_match(script_block_type)) {
+        // 18. If el has a nomodule content attribute and its type is "classic", then return.
+        // NOTE: We support module scripts, so classic scripts meant for browsers without module support never run.
+        if (token.has_attribute(AttributeNames::nomodule))
+            return {};
+        return ScriptType::Classic;
+    }
+
+    // 10. Otherwise, if the script block's type string is an ASCII case-insensitive match for the string "module",
+    //     then set el's type to "module".
+    if (Infra::is_ascii_case_insensitive_match(script_block_type, "module"sv))
+        return ScriptType::Module;
+
+    // 11. and 12. Import maps can't have a src attribute, and scripts of any other type aren't fetched.
+    return {};
+}
+
+// Picks the image source that the img element is going to fetch, see HTMLImageElement::update_the_image_data().
+static Optional<String> image_source_url(HTMLToken const& token)
+{
+    auto src = token.attribute(AttributeNames::src).value_or({});
+    auto srcset = token.attribute(AttributeNames::srcset);
+    if (!srcset.has_value() || srcset->is_empty()) {
+        if (src.is_empty())
+            return {};
+        return src;
+    }
+
+    // https://html.spec.whatwg.org/multipage/images.html#create-a-source-set
+    auto source_set = parse_a_srcset_attribute(*srcset);
+    bool contains_image_source_with_pixel_density_descriptor_value_of_1 = false;
+    for (auto& source : source_set.m_sources) {
+        // NOTE: Width descriptors are resolved against the sizes attribute, which takes a laid out document. Rather than
+        //       preloading the wrong image, we leave these to the img element.
+        if (source.descriptor.has<ImageSource::WidthDescriptorValue>())
+            return {};
+        if (!source.descriptor.has<ImageSource::PixelDensityDescriptorValue>())
+            source.descriptor = ImageSource::PixelDensityDescriptorValue { .value = 1.0 };
+        else if (source.descriptor.get<ImageSource::PixelDensityDescriptorValue>().value == 1.0)
+            contains_image_source_with_pixel_density_descriptor_value_of_1 = true;
+    }
+    if (!src.is_empty() && !contains_image_source_with_pixel_density_descriptor_value_of_1)
+        source_set.m_sources.append({ .url = src, .descriptor = ImageSource::PixelDensityDescriptorValue { .value = 1.0 } });
+
+    if (source_set.is_empty())
+        return {};
+    return source_set.select_an_image_source().source.url;
+}
+
+void HTMLPreloadScanner::add_request(StringView url_string, Optional<String> const& crossorigin, IsModuleScript is_module_script)
+{
+    auto trimmed_url_string = url_string.trim(Infra::ASCII_WHITESPACE);
+    if (trimmed_url_string.is_empty())
+        return;
+    auto url = DOMURL::parse(trimmed_url_string, m_base_url, m_encoding);
+    if (!url.has_value())
+        return;
+
+    // NOTE: A preloaded response can only be used by a fetch with the same mode and credentials mode, so these have to
+    //       match what the element is going to fetch with.
+    auto cors_setting = cors_setting_attribute_from_keyword(crossorigin);
+    PreloadRequest request { .url = url.release_value() };
+    if (is_module_script == IsModuleScript::Yes) {
+        // https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-single-module-script
+        request.mode = Fetch::Infrastructure::Request::Mode::CORS;
+        request.credentials_mode = cors_settings_attribute_credentials_mode(cors_setting);
+    } else if (cors_setting != CORSSettingAttribute::NoCORS) {
+        // https://html.spec.whatwg.org/multipage/urls-and-fetching.html#create-a-potential-cors-request
+        request.mode = Fetch::Infrastructure::Request::Mode::CORS;
+        if (cors_setting == CORSSettingAttribute::Anonymous)
+            request.credentials_mode = Fetch::Infrastructure::Request::CredentialsMode::SameOrigin;
+    }
+    m_requests.append(move(request));
+}
+
+Vector<PreloadRequest> HTMLPreloadScanner::scan(size_t max_code_points)
+{
+    if (!m_tokenizer || m_has_reached_end_of_input)
+        return {};
+
+    auto& tokenizer = *m_tokenizer;
+    auto remaining_input_length_at_start = remaining_input_length();
+
+    while (remaining_input_length_at_start - remaining_input_length() < max_code_points) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file()) {
+            m_has_reached_end_of_input = true;
+            break;
+        }
+        if (!token->is_start_tag())
+            continue;
+
+        auto const& tag_name = token->tag_name();
+
+        // NOTE: Without a tree builder to do it for us, switch the tokenizer into the right state for elements
+        //       with raw text contents, so that markup inside them isn't mistaken for real elements.
+        if (tag_name == TagNames::script) {
+            auto src = token->attribute(AttributeNames::src);
+            if (auto type = fetched_script_type(*token); src.has_value() && type.has_value())
+                add_request(*src, token->attribute(AttributeNames::crossorigin), *type == ScriptType::Module ? IsModuleScript::Yes : IsModuleScript::No);
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+        } else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes)
+            || (tag_name == TagNames::noscript && m_scripting_enabled)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        } else if (tag_name.is_one_of(TagNames::textarea, TagNames::title)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        } else if (tag_name == TagNames::plaintext) {
+            m_has_reached_end_of_input = true;
+            break;
+        } else if (tag_name == TagNames::link) {
+            auto rel = token->attribute(AttributeNames::rel);
+            auto href = token->attribute(AttributeNames::href);
+            if (rel.has_value() && href.has_value() && link_types_are_fetched_eagerly(*rel))
+                add_request(*href, token->attribute(AttributeNames::crossorigin), link_types_contain_modulepreload(*rel) ? IsModuleScript::Yes : IsModuleScript::No);
+        } else if (tag_name == TagNames::img) {
+            // https://html.spec.whatwg.org/multipage/urls-and-fetching.html#will-lazy-load-element-steps
+            // NOTE: Lazily loaded images are only fetched once they come near the viewport, so they must not be preloaded.
+            auto loading = token->attribute(AttributeNames::loading);
+            if (m_scripting_enabled && loading.has_value() && loading->equals_ignoring_ascii_case("lazy"sv))
+                continue;
+
+            if (auto url = image_source_url(*token); url.has_value())
+                add_request(*url, token->attribute(AttributeNames::crossorigin));
+        } else if (tag_name == TagNames::base && !m_has_seen_base_element) {
+            // https://html.spec.whatwg.org/multipage/semantics.html#set-the-frozen-base-url
+            if (auto href = token->attribute(AttributeNames::href); href.has_value()) {
+                m_has_seen_base_element = true;
+                if (auto base_url = DOMURL::parse(*href, m_base_url, m_encoding); base_url.has_value())
+                    m_base_url = base_url.release_value();
+            }
+        }
+    }
+
+    return move(m_requests);
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NumericLimits.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibURL/URL.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+
+namespace Web::HTML {
+
+class HTMLTokenizer;
+
+// A subresource that the parser is going to fetch, with the mode and credentials mode that it's going to be fetched with.
+struct PreloadRequest {
+    URL::URL url;
+    Fetch::Infrastructure::Request::Mode mode { Fetch::Infrastructure::Request::Mode::NoCORS };
+    Fetch::Infrastructure::Request::CredentialsMode credentials_mode { Fetch::Infrastructure::Request::CredentialsMode::Include };
+};
+
+// Looks ahead in input that the HTML parser has not consumed yet for the URLs of subresources it will request once it
+// gets there: scripts, stylesheets, images and <link rel=preload> targets. For images with a srcset, that is only the
+// one image source that the img element will pick.
+// This is a lightweight stand-in for https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// that does not build a speculative tree, and only looks at tokens.
+// The scanner remembers where it stopped, so that the parser can have it look a little further ahead every time it
+// blocks without tokenizing the same input twice.
+class HTMLPreloadScanner {
+public:
+    HTMLPreloadScanner(URL::URL base_url, String encoding, bool scripting_enabled);
+    ~HTMLPreloadScanner();
+
+    // Restarts scanning at the start of the given input, e.g. once the parser has caught up with the scanner, or more
+    // input has arrived. The base URL found in a previous <base> element is kept.
+    void set_input(ReadonlySpan<u32> code_points);
+    void set_input(StringView);
+
+    size_t remaining_input_length() const;
+    bool has_reached_end_of_input() const { return m_has_reached_end_of_input; }
+
+    // Scans at least max_code_points of input (stopping at the next token boundary), continuing where the previous
+    // call stopped, and returns the subresources found along the way.
+    Vector<PreloadRequest> scan(size_t max_code_points = NumericLimits<size_t>::max());
+
+private:
+    enum class IsModuleScript {
+        No,
+        Yes,
+    };
+    void add_request(StringView url, Optional<String> const& crossorigin, IsModuleScript = IsModuleScript::No);
+
+    OwnPtr<HTMLTokenizer> m_tokenizer;
+    bool m_has_reached_end_of_input { false };
+    URL::URL m_base_url;
+    bool m_has_seen_base_element { false };
+    String m_encoding;
+    bool m_scripting_enabled { true };
+    Vector<PreloadRequest> m_requests;
+};
+
+}
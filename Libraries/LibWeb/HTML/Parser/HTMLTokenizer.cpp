@@ -237,6 +237,30 @@ void HTMLTokenizer::skip(size_t count)
     }
 }
 
+// OPTIMIZATION: Long attribute values and comments consist almost entirely of code points that the current state
+//               simply appends to the current builder. Scan ahead for the next code point that needs handling and
+//               append everything before it at once, instead of going around the state machine for each one.
+template<typename IsSpecialCodePoint>
+void HTMLTokenizer::append_run_to_current_builder(StopAtInsertionPoint stop_at_insertion_point, IsSpecialCodePoint is_special_code_point)
+{
+    auto end = static_cast<ssize_t>(m_decoded_input.size());
+    if (stop_at_insertion_point == StopAtInsertionPoint::Yes && m_insertion_point.defined)
+        end = min(end, m_insertion_point.position);
+
+    auto run_end = m_current_offset;
+    while (run_end < end) {
+        auto code_point = m_decoded_input[run_end];
+        // NOTE: Carriage returns must go through next_code_point() to be normalized.
+        if (code_point == '\r' || code_point == 0 || is_special_code_point(code_point))
+            break;
+        m_current_builder.append_code_point(code_point);
+        ++run_end;
+    }
+
+    if (run_end > m_current_offset)
+        skip(run_end - m_current_offset);
+}
+
 Optional<u32> HTMLTokenizer::peek_code_point(ssize_t offset, StopAtInsertionPoint stop_at_insertion_point) const
 {
     auto it = m_current_offset + offset;
@@ -1315,6 +1339,9 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_run_to_current_builder(stop_at_insertion_point, [](u32 code_point) {
+                        return code_point == '"' || code_point == '&';
+                    });
                     continue;
                 }
             }
@@ -1347,6 +1374,9 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_run_to_current_builder(stop_at_insertion_point, [](u32 code_point) {
+                        return code_point == '\'' || code_point == '&';
+                    });
                     continue;
                 }
             }
@@ -1517,6 +1547,9 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    append_run_to_current_builder(stop_at_insertion_point, [](u32 code_point) {
+                        return code_point == '<' || code_point == '-';
+                    });
                     continue;
                 }
             }
@@ -2871,6 +2904,14 @@ HTMLTokenizer::HTMLTokenizer(StringView input, ByteString const& encoding)
     m_source_positions.empend(0u, 0u);
 }
 
+HTMLTokenizer::HTMLTokenizer(ReadonlySpan<u32> code_points)
+{
+    m_decoded_input.append(code_points.data(), code_points.size());
+    m_current_offset = 0;
+    m_prev_offset = 0;
+    m_source_positions.empend(0u, 0u);
+}
+
 void HTMLTokenizer::insert_input_at_insertion_point(StringView input)
 {
     Vector<u32> new_decoded_input;
@@ -104,6 +104,7 @@ class HTMLTokenizer {
 public:
     explicit HTMLTokenizer();
     explicit HTMLTokenizer(StringView input, ByteString const& encoding);
+    explicit HTMLTokenizer(ReadonlySpan<u32> code_points);
 
     enum class State {
 #define __ENUMERATE_TOKENIZER_STATE(state) state,
@@ -129,6 +130,8 @@ public:
     bool is_blocked() const { return m_blocked; }
 
     auto const& source() const { return m_source; }
+    ReadonlySpan<u32> unparsed_code_points() const { return m_decoded_input.span().slice(static_cast<size_t>(m_current_offset)); }
+    size_t input_length() const { return m_decoded_input.size(); }
 
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
@@ -156,6 +159,9 @@ private:
     Optional<u32> next_code_point(StopAtInsertionPoint);
     Optional<u32> peek_code_point(ssize_t offset, StopAtInsertionPoint) const;
 
+    template<typename IsSpecialCodePoint>
+    void append_run_to_current_builder(StopAtInsertionPoint, IsSpecialCodePoint);
+
     enum class ConsumeNextResult {
         Consumed,
         NotConsumed,
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibCore/EventLoop.h>
 #include <LibWeb/HTML/RenderingThread.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
@@ -49,6 +50,7 @@ void RenderingThread::rendering_thread_loop()
             Threading::MutexLocker const locker { m_rendering_task_mutex };
             if (m_needs_to_clear_bitmap_to_surface_cache) {
                 m_bitmap_to_surface.clear();
+                m_rasterized_frame_for_bitmap.clear();
                 m_needs_to_clear_bitmap_to_surface_cache = false;
             }
             while (m_rendering_tasks.is_empty() && !m_exit) {
@@ -64,8 +66,19 @@ void RenderingThread::rendering_thread_loop()
             break;
         }
 
-        auto painting_surface = painting_surface_for_backing_store(task->backing_store);
-        m_skia_player->execute(*task->display_list, task->scroll_state_snapshot, painting_surface);
+        if (can_reuse_rasterized_frame(*task)) {
+            ++m_reused_frames;
+        } else {
+            auto painting_surface = painting_surface_for_backing_store(task->backing_store);
+            m_skia_player->execute(*task->display_list, task->scroll_state_snapshot, painting_surface);
+            ++m_rasterized_frames;
+            if (task->display_list->has_mutable_content()) {
+                m_rasterized_frame_for_bitmap.remove(&task->backing_store->bitmap());
+            } else {
+                m_rasterized_frame_for_bitmap.set(&task->backing_store->bitmap(), RasterizedFrame { task->display_list, task->scroll_state_snapshot });
+            }
+        }
+        dbgln_if(RENDERING_THREAD_DEBUG, "RenderingThread: {} frames rasterized, {} frames reused", m_rasterized_frames.load(), m_reused_frames.load());
         if (m_exit)
             break;
         m_main_thread_event_loop.deferred_invoke([callback = move(task->callback)] {
@@ -81,6 +94,15 @@ void RenderingThread::enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList
     m_rendering_task_ready_wake_condition.signal();
 }
 
+bool RenderingThread::can_reuse_rasterized_frame(Task const& task) const
+{
+    auto rasterized_frame = m_rasterized_frame_for_bitmap.get(&task.backing_store->bitmap());
+    if (!rasterized_frame.has_value())
+        return false;
+    return rasterized_frame->display_list.ptr() == task.display_list.ptr()
+        && rasterized_frame->scroll_state_snapshot == task.scroll_state_snapshot;
+}
+
 NonnullRefPtr<Gfx::PaintingSurface> RenderingThread::painting_surface_for_backing_store(Painting::BackingStore& backing_store)
 {
     auto& bitmap = backing_store.bitmap();
@@ -32,6 +32,12 @@ public:
     void enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList>, Painting::ScrollStateSnapshot&&, NonnullRefPtr<Painting::BackingStore>, Function<void()>&& callback);
     void clear_bitmap_to_surface_cache();
 
+    struct RasterizationStatistics {
+        size_t rasterized_frames { 0 };
+        size_t reused_frames { 0 };
+    };
+    RasterizationStatistics rasterization_statistics() const { return { m_rasterized_frames.load(), m_reused_frames.load() }; }
+
 private:
     void rendering_thread_loop();
     NonnullRefPtr<Gfx::PaintingSurface> painting_surface_for_backing_store(Painting::BackingStore& backing_store);
@@ -52,6 +58,8 @@ private:
         NonnullRefPtr<Painting::BackingStore> backing_store;
         Function<void()> callback;
     };
+    bool can_reuse_rasterized_frame(Task const&) const;
+
     // NOTE: Queue will only contain multiple items in case tasks were scheduled by screenshot requests.
     //       Otherwise, it will contain only one item at a time.
     Queue<Task> m_rendering_tasks;
@@ -60,6 +68,17 @@ private:
 
     HashMap<Gfx::Bitmap*, NonnullRefPtr<Gfx::PaintingSurface>> m_bitmap_to_surface;
     bool m_needs_to_clear_bitmap_to_surface_cache { false };
+
+    // What each backing store bitmap currently contains, so an unchanged frame doesn't have to be rasterized again.
+    // NOTE: The display list is retained so that a newly recorded list can't be mistaken for it by address.
+    struct RasterizedFrame {
+        NonnullRefPtr<Painting::DisplayList> display_list;
+        Painting::ScrollStateSnapshot scroll_state_snapshot;
+    };
+    HashMap<Gfx::Bitmap*, RasterizedFrame> m_rasterized_frame_for_bitmap;
+
+    Atomic<size_t> m_rasterized_frames { 0 };
+    Atomic<size_t> m_reused_frames { 0 };
 };
 
 }
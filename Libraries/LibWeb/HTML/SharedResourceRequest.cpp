@@ -23,14 +23,51 @@ namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(SharedResourceRequest);
 
-GC::Ref<SharedResourceRequest> SharedResourceRequest::get_or_create(JS::Realm& realm, GC::Ref<Page> page, URL::URL const& url)
+// Returns whether an image decoded for the given ideal decode size can also be shown at the wanted one.
+static bool ideal_decode_size_covers(Optional<Gfx::IntSize> const& ideal_decode_size, Optional<Gfx::IntSize> const& wanted_ideal_decode_size)
+{
+    if (!ideal_decode_size.has_value())
+        return true;
+    if (!wanted_ideal_decode_size.has_value())
+        return false;
+    return ideal_decode_size->width() >= wanted_ideal_decode_size->width() && ideal_decode_size->height() >= wanted_ideal_decode_size->height();
+}
+
+GC::Ref<SharedResourceRequest> SharedResourceRequest::get_or_create(JS::Realm& realm, GC::Ref<Page> page, URL::URL const& url, Optional<Gfx::IntSize> ideal_decode_size, UserReportsVisibility user_reports_visibility)
+{
+    auto request = find_or_create(realm, page, url, ideal_decode_size);
+    if (user_reports_visibility == UserReportsVisibility::No)
+        request->keep_image_decoded();
+    return request;
+}
+
+GC::Ref<SharedResourceRequest> SharedResourceRequest::find_or_create(JS::Realm& realm, GC::Ref<Page> page, URL::URL const& url, Optional<Gfx::IntSize> ideal_decode_size)
 {
     auto document = Bindings::principal_host_defined_environment_settings_object(realm).responsible_document();
     VERIFY(document);
     auto& shared_resource_requests = document->shared_resource_requests();
-    if (auto it = shared_resource_requests.find(url); it != shared_resource_requests.end())
-        return *it->value;
+    if (auto it = shared_resource_requests.find(url); it != shared_resource_requests.end()) {
+        auto& request = *it->value;
+
+        // A request that hasn't been fetched yet can still be decoded at a size that suits all of its users.
+        if (request.needs_fetching()) {
+            if (!ideal_decode_size_covers(request.m_ideal_decode_size, ideal_decode_size)) {
+                if (ideal_decode_size.has_value())
+                    request.m_ideal_decode_size = Gfx::IntSize { max(request.m_ideal_decode_size->width(), ideal_decode_size->width()), max(request.m_ideal_decode_size->height(), ideal_decode_size->height()) };
+                else
+                    request.m_ideal_decode_size.clear();
+            }
+            return request;
+        }
+
+        if (ideal_decode_size_covers(request.m_ideal_decode_size, ideal_decode_size))
+            return request;
+
+        // NOTE: Otherwise, the image is fetched again, which is usually answered by the HTTP cache, and decoded at the
+        //       larger size. Users of the existing request keep it, but new ones will share this one from now on.
+    }
     auto request = realm.create<SharedResourceRequest>(page, url, *document);
+    request->m_ideal_decode_size = ideal_decode_size;
     shared_resource_requests.set(url, request);
     return request;
 }
@@ -47,8 +84,17 @@ SharedResourceRequest::~SharedResourceRequest() = default;
 void SharedResourceRequest::finalize()
 {
     Base::finalize();
+
+    // NOTE: Nobody is waiting for the image anymore, so don't let ImageDecoder finish decoding it.
+    m_callbacks.clear();
+    m_state = State::Failed;
+    abort_progressive_decode();
+
     auto& shared_resource_requests = m_document->shared_resource_requests();
-    shared_resource_requests.remove(m_url);
+
+    // NOTE: We may have been replaced by a request that decodes the image at a larger size.
+    if (auto it = shared_resource_requests.find(m_url); it != shared_resource_requests.end() && it->value.ptr() == this)
+        shared_resource_requests.remove(it);
 }
 
 void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
@@ -60,10 +106,18 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial);
     }
     visitor.visit(m_image_data);
 }
 
+void SharedResourceRequest::keep_image_decoded()
+{
+    m_keeps_image_decoded = true;
+    if (auto* image_data = as_if<AnimatedBitmapDecodedImageData>(m_image_data.ptr()))
+        image_data->keep_decoded();
+}
+
 GC::Ptr<DecodedImageData> SharedResourceRequest::image_data() const
 {
     return m_image_data;
@@ -79,6 +133,11 @@ void SharedResourceRequest::set_fetch_controller(GC::Ptr<Fetch::Infrastructure::
     m_fetch_controller = move(fetch_controller);
 }
 
+static bool is_svg_image(URL::URL const& url, StringView mime_type)
+{
+    return mime_type == "image/svg+xml"sv || url.basename().ends_with(".svg"sv);
+}
+
 void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infrastructure::Request> request)
 {
     Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
@@ -102,7 +161,22 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
             return;
         }
 
-        response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+        auto extracted_mime_type = response->header_list()->extract_mime_type();
+        auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
+        if (is_svg_image(request->url(), mime_type)) {
+            response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+            return;
+        }
+
+        // OPTIMIZATION: Hand raster images to the decoder as their data arrives, so that we can show them (and lay
+        //               them out) before the last byte is in, and the final decode doesn't start from scratch.
+        auto process_body_chunk = GC::create_function(heap(), [this](ByteBuffer chunk) {
+            handle_body_chunk(move(chunk));
+        });
+        auto process_end_of_body = GC::create_function(heap(), [this] {
+            handle_end_of_body();
+        });
+        response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
     };
 
     m_state = State::Fetching;
@@ -116,7 +190,7 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -135,6 +209,8 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
         callbacks.on_finish = GC::create_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = GC::create_function(vm().heap(), move(on_fail));
+    if (on_partial)
+        callbacks.on_partial = GC::create_function(vm().heap(), move(on_partial));
 
     m_callbacks.append(move(callbacks));
 }
@@ -144,9 +220,7 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     // AD-HOC: At this point, things gets very ad-hoc.
     // FIXME: Bring this closer to spec.
 
-    bool const is_svg_image = mime_type == "image/svg+xml"sv || url_string.basename().ends_with(".svg"sv);
-
-    if (is_svg_image) {
+    if (is_svg_image(url_string, mime_type)) {
         auto result = SVG::SVGDecodedImageData::create(m_document->realm(), m_page, url_string, data);
         if (result.is_error()) {
             handle_failed_fetch();
@@ -158,15 +232,7 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     }
 
     auto handle_successful_bitmap_decode = [strong_this = GC::Root(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
-        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
-        for (auto& frame : result.frames) {
-            frames.append(AnimatedBitmapDecodedImageData::Frame {
-                .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap, Gfx::AlphaType::Premultiplied, result.color_space),
-                .duration = static_cast<int>(frame.duration),
-            });
-        }
-        strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
-        strong_this->handle_successful_resource_load();
+        strong_this->handle_successful_bitmap_decode(result);
         return {};
     };
 
@@ -174,12 +240,144 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
         strong_this->handle_failed_fetch();
     };
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+    m_encoded_data = move(data);
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(m_encoded_data->bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode), m_ideal_decode_size);
+}
+
+void SharedResourceRequest::handle_body_chunk(ByteBuffer chunk)
+{
+    if (m_state != State::Fetching || chunk.is_empty())
+        return;
+
+    if (!m_did_receive_body_data) {
+        m_did_receive_body_data = true;
+
+        // NOTE: We own the progressive decode, so its callbacks must not keep us alive. If we are collected while the
+        //       image is being decoded, dropping the decode makes ImageDecoder give up on it.
+        auto handle_successful_bitmap_decode = [weak_this = make_weak_ptr<SharedResourceRequest>()](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+            if (weak_this && weak_this->m_state == State::Fetching)
+                weak_this->handle_successful_bitmap_decode(result);
+            return {};
+        };
+
+        auto handle_failed_decode = [weak_this = make_weak_ptr<SharedResourceRequest>()](Error&) -> void {
+            if (weak_this && weak_this->m_state == State::Fetching)
+                weak_this->handle_failed_fetch();
+        };
+
+        auto progressive_decode_or_error = Web::Platform::ImageCodecPlugin::the().start_progressive_decode(move(handle_successful_bitmap_decode), move(handle_failed_decode), m_ideal_decode_size);
+        if (progressive_decode_or_error.is_error()) {
+            dbgln("Failed to start decoding image: {}", progressive_decode_or_error.error());
+            handle_failed_fetch();
+            return;
+        }
+
+        m_progressive_decode = progressive_decode_or_error.release_value();
+        m_encoded_data = ByteBuffer {};
+        m_progressive_decode->on_partial_image = [this](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+            handle_partial_image(move(bitmap));
+        };
+    }
+
+    if (!m_progressive_decode)
+        return;
+
+    // NOTE: We hold on to the encoded data, so that the decoded image can be discarded and decoded again later. If we
+    //       can't, the image simply stays decoded.
+    if (m_encoded_data.has_value() && m_encoded_data->try_append(chunk).is_error())
+        m_encoded_data.clear();
+
+    m_progressive_decode->append(chunk);
+}
+
+void SharedResourceRequest::handle_end_of_body()
+{
+    if (!m_progressive_decode) {
+        // NOTE: There is nothing to decode if the body was empty.
+        if (!m_did_receive_body_data)
+            handle_failed_fetch();
+        return;
+    }
+
+    // NOTE: The decode now settles its promise, which is where we pick up the decoded image.
+    auto progressive_decode = move(m_progressive_decode);
+    progressive_decode->on_partial_image = nullptr;
+    progressive_decode->finish();
+}
+
+void SharedResourceRequest::abort_progressive_decode()
+{
+    if (!m_progressive_decode)
+        return;
+
+    // NOTE: Dropping the progressive decode before it has been finished cancels it in ImageDecoder.
+    m_progressive_decode->on_partial_image = nullptr;
+    m_progressive_decode = nullptr;
+}
+
+void SharedResourceRequest::handle_partial_image(NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    if (m_state != State::Fetching)
+        return;
+
+    // NOTE: The final decode applies the image's color space, the partial image is only a preview of it.
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    frames.append(AnimatedBitmapDecodedImageData::Frame {
+        .bitmap = Gfx::ImmutableBitmap::create(move(bitmap), Gfx::AlphaType::Premultiplied),
+        .duration = 0,
+    });
+    auto image_data_or_error = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), 0, false);
+    if (image_data_or_error.is_error())
+        return;
+    m_image_data = image_data_or_error.release_value();
+
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial)
+            callback.on_partial->function()();
+    }
+}
+
+void SharedResourceRequest::handle_successful_bitmap_decode(Web::Platform::DecodedImage& result)
+{
+    if (result.animation_session) {
+        m_encoded_data.clear();
+
+        auto& first_frame = result.frames.first();
+        AnimatedBitmapDecodedImageData::Frame frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*first_frame.bitmap, Gfx::AlphaType::Premultiplied, result.color_space),
+            .duration = static_cast<int>(first_frame.duration),
+        };
+        m_image_data = AnimatedBitmapDecodedImageData::create_with_animation_session(m_document->realm(), move(frame), result.frame_count, result.frame_durations, result.loop_count, result.color_space, result.animation_session.release_nonnull()).release_value_but_fixme_should_propagate_errors();
+        handle_successful_resource_load();
+        return;
+    }
+
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    for (auto& frame : result.frames) {
+        frames.append(AnimatedBitmapDecodedImageData::Frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap, Gfx::AlphaType::Premultiplied, result.color_space),
+            .duration = static_cast<int>(frame.duration),
+        });
+    }
+    auto image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), result.loop_count, result.is_animated, result.size).release_value_but_fixme_should_propagate_errors();
+
+    // Still images can be decoded again from their encoded data, which lets us discard their pixels while they are out
+    // of view.
+    if (!result.is_animated && result.frames.size() == 1 && m_encoded_data.has_value())
+        image_data->enable_discarding(m_encoded_data.release_value(), m_ideal_decode_size, result.color_space, *m_document);
+    m_encoded_data.clear();
+    if (m_keeps_image_decoded)
+        image_data->keep_decoded();
+
+    m_image_data = image_data;
+    handle_successful_resource_load();
 }
 
 void SharedResourceRequest::handle_failed_fetch()
 {
     m_state = State::Failed;
+    abort_progressive_decode();
+    m_encoded_data.clear();
     for (auto& callback : m_callbacks) {
         if (callback.on_fail)
             callback.on_fail->function()();
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Error.h>
+#include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <LibGC/Function.h>
 #include <LibGC/Root.h>
+#include <LibGfx/Forward.h>
 #include <LibGfx/Size.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Forward.h>
@@ -21,11 +24,21 @@ class SharedResourceRequest final : public JS::Cell {
     GC_DECLARE_ALLOCATOR(SharedResourceRequest);
 
 public:
-    [[nodiscard]] static GC::Ref<SharedResourceRequest> get_or_create(JS::Realm&, GC::Ref<Page>, URL::URL const&);
+    // Whether the user of a request tells the decoded image if it displays it in the viewport. If any user doesn't, the
+    // decoded image is never discarded.
+    enum class UserReportsVisibility {
+        No,
+        Yes,
+    };
+
+    // Requests for the same URL are shared, unless the image has to be decoded at a larger size than an existing request
+    // for it is going to decode it at. Without an ideal decode size, the image is decoded at its natural size.
+    [[nodiscard]] static GC::Ref<SharedResourceRequest> get_or_create(JS::Realm&, GC::Ref<Page>, URL::URL const&, Optional<Gfx::IntSize> ideal_decode_size = {}, UserReportsVisibility = UserReportsVisibility::No);
 
     virtual ~SharedResourceRequest() override;
 
     URL::URL const& url() const { return m_url; }
+    Optional<Gfx::IntSize> const& ideal_decode_size() const { return m_ideal_decode_size; }
 
     [[nodiscard]] GC::Ptr<DecodedImageData> image_data() const;
 
@@ -34,7 +47,8 @@ public:
 
     void fetch_resource(JS::Realm&, GC::Ref<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    // on_partial is invoked whenever more of the image has been decoded while it is still being fetched.
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -42,12 +56,20 @@ public:
 private:
     explicit SharedResourceRequest(GC::Ref<Page>, URL::URL, GC::Ref<DOM::Document>);
 
+    static GC::Ref<SharedResourceRequest> find_or_create(JS::Realm&, GC::Ref<Page>, URL::URL const&, Optional<Gfx::IntSize> ideal_decode_size);
+    void keep_image_decoded();
+
     virtual void finalize() override;
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
+    void handle_successful_bitmap_decode(Platform::DecodedImage&);
+    void handle_body_chunk(ByteBuffer chunk);
+    void handle_end_of_body();
     void handle_failed_fetch();
     void handle_successful_resource_load();
+    void handle_partial_image(NonnullRefPtr<Gfx::Bitmap>);
+    void abort_progressive_decode();
 
     enum class State {
         New,
@@ -63,13 +85,24 @@ private:
     struct Callbacks {
         GC::Ptr<GC::Function<void()>> on_finish;
         GC::Ptr<GC::Function<void()>> on_fail;
+        GC::Ptr<GC::Function<void()>> on_partial;
     };
     Vector<Callbacks> m_callbacks;
 
     URL::URL m_url;
+    Optional<Gfx::IntSize> m_ideal_decode_size;
     GC::Ptr<DecodedImageData> m_image_data;
     GC::Ptr<Fetch::Infrastructure::FetchController> m_fetch_controller;
 
+    // Raster images are decoded as their data arrives, so that they can be shown before they have been fetched in full.
+    RefPtr<Platform::ProgressiveDecode> m_progressive_decode;
+    bool m_did_receive_body_data { false };
+
+    // The encoded image data, kept until the image has been decoded.
+    Optional<ByteBuffer> m_encoded_data;
+
+    bool m_keeps_image_decoded { false };
+
     GC::Ptr<DOM::Document> m_document;
 };
 
@@ -7,10 +7,12 @@
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/CSSStyleProperties.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
 #include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/HTML/DecodedImageCache.h>
 #include <LibWeb/HTML/HTMLElement.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/Internals.h>
@@ -239,6 +241,37 @@ void Internals::set_browser_zoom(double factor)
     page().client().page_did_set_browser_zoom(factor);
 }
 
+WebIDL::UnsignedLongLong Internals::get_restyled_element_count()
+{
+    auto& active_document = window().associated_document();
+    active_document.update_style();
+    return active_document.restyled_element_count();
+}
+
+bool Internals::has_unparsed_declarations(CSS::CSSStyleProperties const& style)
+{
+    return style.has_unparsed_declarations();
+}
+
+JS::Object* Internals::get_decoded_image_cache_statistics()
+{
+    auto statistics = HTML::DecodedImageCache::the().statistics();
+
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("budget"_fly_string, JS::Value(static_cast<double>(statistics.budget)), JS::default_attributes);
+    result->define_direct_property("decodedSize"_fly_string, JS::Value(static_cast<double>(statistics.decoded_size)), JS::default_attributes);
+    result->define_direct_property("imageCount"_fly_string, JS::Value(static_cast<double>(statistics.image_count)), JS::default_attributes);
+    result->define_direct_property("discardedImageCount"_fly_string, JS::Value(static_cast<double>(statistics.discarded_image_count)), JS::default_attributes);
+    result->define_direct_property("discardCount"_fly_string, JS::Value(static_cast<double>(statistics.discard_count)), JS::default_attributes);
+    result->define_direct_property("redecodeCount"_fly_string, JS::Value(static_cast<double>(statistics.redecode_count)), JS::default_attributes);
+    return result;
+}
+
+void Internals::discard_invisible_decoded_images()
+{
+    HTML::DecodedImageCache::the().discard_invisible_images();
+}
+
 bool Internals::headless()
 {
     return page().client().is_headless();
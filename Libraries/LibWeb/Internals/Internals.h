@@ -58,6 +58,12 @@ public:
 
     void set_browser_zoom(double factor);
 
+    WebIDL::UnsignedLongLong get_restyled_element_count();
+    bool has_unparsed_declarations(CSS::CSSStyleProperties const&);
+
+    JS::Object* get_decoded_image_cache_statistics();
+    void discard_invisible_decoded_images();
+
     bool headless();
 
 private:
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibWeb/Dump.h>
 #include <LibWeb/Layout/BlockFormattingContext.h>
 #include <LibWeb/Layout/Box.h>
@@ -19,6 +20,23 @@
 
 namespace Web::Layout {
 
+static IntrinsicSizeCacheStatistics s_intrinsic_size_cache_statistics;
+
+IntrinsicSizeCacheStatistics& FormattingContext::intrinsic_size_cache_statistics()
+{
+    return s_intrinsic_size_cache_statistics;
+}
+
+static void record_intrinsic_size_cache_lookup(bool hit)
+{
+    if constexpr (UPDATE_LAYOUT_DEBUG) {
+        if (hit)
+            ++s_intrinsic_size_cache_statistics.hits;
+        else
+            ++s_intrinsic_size_cache_statistics.misses;
+    }
+}
+
 FormattingContext::FormattingContext(Type type, LayoutMode layout_mode, LayoutState& state, Box const& context_box, FormattingContext* parent)
     : m_type(type)
     , m_layout_mode(layout_mode)
@@ -241,6 +259,10 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     if (!child_box.can_have_children())
         return {};
 
+    // FIXME: Independent formatting contexts with a definite available space don't read each other's results,
+    //        so they could in principle be laid out in parallel. This is not safe yet: layout mutates GC-allocated
+    //        layout nodes (e.g. Box::cached_intrinsic_sizes()), shares non-thread-safe font and shaping caches,
+    //        and lazily creates used values for containing blocks in the shared LayoutState.
     auto independent_formatting_context = create_independent_formatting_context_if_needed(m_state, layout_mode, child_box);
     if (independent_formatting_context)
         independent_formatting_context->run(available_space);
@@ -1448,6 +1470,7 @@ CSSPixels FormattingContext::calculate_min_content_width(Layout::Box const& box)
         return *box.natural_width();
 
     auto& cache = box.cached_intrinsic_sizes().min_content_width;
+    record_intrinsic_size_cache_lookup(cache.has_value());
     if (cache.has_value())
         return cache.value();
 
@@ -1480,6 +1503,7 @@ CSSPixels FormattingContext::calculate_max_content_width(Layout::Box const& box)
         return *box.natural_width();
 
     auto& cache = box.cached_intrinsic_sizes().max_content_width;
+    record_intrinsic_size_cache_lookup(cache.has_value());
     if (cache.has_value())
         return cache.value();
 
@@ -1517,6 +1541,7 @@ CSSPixels FormattingContext::calculate_min_content_height(Layout::Box const& box
         return *box.natural_height();
 
     auto& cache = box.cached_intrinsic_sizes().min_content_height.ensure(width);
+    record_intrinsic_size_cache_lookup(cache.has_value());
     if (cache.has_value())
         return cache.value();
 
@@ -1548,6 +1573,7 @@ CSSPixels FormattingContext::calculate_max_content_height(Layout::Box const& box
         return *box.natural_height();
 
     auto& cache_slot = box.cached_intrinsic_sizes().max_content_height.ensure(width);
+    record_intrinsic_size_cache_lookup(cache_slot.has_value());
     if (cache_slot.has_value())
         return cache_slot.value();
 
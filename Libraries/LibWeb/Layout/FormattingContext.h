@@ -21,6 +21,11 @@ template<typename T>
     return ::max(min, ::min(value, max));
 }
 
+struct IntrinsicSizeCacheStatistics {
+    size_t hits { 0 };
+    size_t misses { 0 };
+};
+
 class FormattingContext {
 public:
     virtual ~FormattingContext();
@@ -57,6 +62,9 @@ public:
 
     static bool creates_block_formatting_context(Box const&);
 
+    // Lookups in Box::cached_intrinsic_sizes(), only recorded when UPDATE_LAYOUT_DEBUG is enabled.
+    static IntrinsicSizeCacheStatistics& intrinsic_size_cache_statistics();
+
     CSSPixels compute_table_box_width_inside_table_wrapper(Box const&, AvailableSpace const&);
     CSSPixels compute_table_box_height_inside_table_wrapper(Box const&, AvailableSpace const&);
 
@@ -18,36 +18,62 @@
 
 namespace Web::Layout {
 
+LayoutState::LayoutState(size_t layout_node_count)
+{
+    m_used_values_by_layout_index.resize(layout_node_count);
+}
+
 LayoutState::~LayoutState()
 {
 }
 
-LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+LayoutState::UsedValues* LayoutState::find_used_values(NodeWithStyle const& node) const
 {
-    if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
-        return *used_values;
+    auto index = node.layout_index();
+    if (index < m_used_values_by_layout_index.size()) {
+        auto* used_values = m_used_values_by_layout_index[index];
+        // NOTE: A node that was removed from the tree may still carry a stale index.
+        if (!used_values || &used_values->node() == &node)
+            return used_values;
+    }
+    if (m_sparse_used_values.is_empty())
+        return nullptr;
+    return m_sparse_used_values.get(node).value_or(nullptr);
+}
 
+LayoutState::UsedValues& LayoutState::create_used_values(NodeWithStyle const& node)
+{
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    m_used_values.append({});
+    auto& used_values = m_used_values.at(m_used_values.size() - 1);
+    used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+
+    auto index = node.layout_index();
+    if (index < m_used_values_by_layout_index.size() && !m_used_values_by_layout_index[index])
+        m_used_values_by_layout_index[index] = &used_values;
+    else
+        m_sparse_used_values.set(node, &used_values);
+    return used_values;
 }
 
-LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
+LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
 {
-    if (auto const* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
+    if (auto* used_values = find_used_values(node))
         return *used_values;
+    return create_used_values(node);
+}
 
-    auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
+LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
+{
+    if (auto const* used_values = find_used_values(node))
+        return *used_values;
+    return const_cast<LayoutState*>(this)->create_used_values(node);
+}
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+LayoutState::UsedValues const* LayoutState::try_get(NodeWithStyle const& node) const
+{
+    return find_used_values(node);
 }
 
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
@@ -142,8 +168,7 @@ void LayoutState::resolve_relative_positions()
 {
     // This function resolves relative position offsets of fragments that belong to inline paintables.
     // It runs *after* the paint tree has been constructed, so it modifies paintable node & fragment offsets directly.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         for (auto& paintable : node.paintables()) {
@@ -232,7 +257,7 @@ void LayoutState::commit(Box& root)
                 auto& inline_node = const_cast<InlineNode&>(static_cast<InlineNode const&>(*parent));
                 auto line_paintable = inline_node.create_paintable_for_line_with_index(line_index);
                 line_paintable->add_fragment(fragment);
-                if (auto const* used_values = used_values_per_layout_node.get(inline_node).value_or(nullptr))
+                if (auto const* used_values = try_get(inline_node))
                     transfer_box_model_metrics(line_paintable->box_model(), *used_values);
                 if (!inline_node_paintables.contains(line_paintable.ptr())) {
                     inline_node_paintables.set(line_paintable.ptr());
@@ -244,8 +269,7 @@ void LayoutState::commit(Box& root)
         return false;
     };
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         auto paintable = node.create_paintable();
@@ -306,15 +330,14 @@ void LayoutState::commit(Box& root)
         auto line_paintable = inline_node->create_paintable_for_line_with_index(0);
         inline_node->add_paintable(line_paintable);
         inline_node_paintables.set(line_paintable.ptr());
-        if (auto const* used_values = used_values_per_layout_node.get(*inline_node).value_or(nullptr))
+        if (auto const* used_values = try_get(*inline_node))
             transfer_box_model_metrics(line_paintable->box_model(), *used_values);
     }
 
     // Resolve relative positions for regular boxes (not line box fragments):
     // NOTE: This needs to occur before fragments are transferred into the corresponding inline paintables, because
     //       after this transfer, the containing_line_box_fragment will no longer be valid.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         if (!node.is_box())
@@ -400,8 +423,7 @@ void LayoutState::commit(Box& root)
     }
 
     // Measure overflow in scroll containers.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         if (!used_values.node().is_box())
             continue;
         auto const& box = static_cast<Layout::Box const&>(used_values.node());
@@ -415,8 +437,7 @@ void LayoutState::commit(Box& root)
             paintable_box.set_scroll_offset(paintable_box.scroll_offset());
     }
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = used_values.node();
         for (auto& paintable : node.paintables()) {
             Painting::PaintableBox* paintable_box = nullptr;
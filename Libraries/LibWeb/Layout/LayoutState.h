@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/SegmentedVector.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
 #include <LibWeb/Layout/Box.h>
@@ -197,6 +198,10 @@ struct LayoutState {
         Optional<StaticPositionRect> m_static_position_rect;
     };
 
+    // A state created with the layout tree's node count looks up used values by Node::layout_index().
+    // Throwaway states (e.g. for intrinsic sizing) touch few nodes, so they use a sparse map instead.
+    LayoutState() = default;
+    explicit LayoutState(size_t layout_node_count);
     ~LayoutState();
 
     // Commits the used values produced by layout and builds a paintable tree.
@@ -204,11 +209,18 @@ struct LayoutState {
 
     UsedValues& get_mutable(NodeWithStyle const&);
     UsedValues const& get(NodeWithStyle const&) const;
-
-    HashMap<GC::Ref<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
+    UsedValues const* try_get(NodeWithStyle const&) const;
 
 private:
     void resolve_relative_positions();
+
+    UsedValues* find_used_values(NodeWithStyle const&) const;
+    UsedValues& create_used_values(NodeWithStyle const&);
+
+    // Used values are allocated in segments, so references to them stay valid as more are created.
+    SegmentedVector<UsedValues, 64> m_used_values;
+    Vector<UsedValues*> m_used_values_by_layout_index;
+    HashMap<GC::Ref<Layout::Node const>, UsedValues*> m_sparse_used_values;
 };
 
 inline CSSPixels clamp_to_max_dimension_value(CSSPixels value)
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/NonnullRefPtr.h>
+#include <AK/NumericLimits.h>
 #include <AK/Vector.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/CSS/StyleValues/ImageStyleValue.h>
@@ -136,6 +137,12 @@ public:
 
     void recompute_containing_block(Badge<DOM::Document>);
 
+    // Dense index of this node in tree order, (re)assigned before each layout pass.
+    // LayoutState uses it to find a node's used values without a hash lookup.
+    static constexpr size_t no_layout_index = NumericLimits<size_t>::max();
+    [[nodiscard]] size_t layout_index() const { return m_layout_index; }
+    void set_layout_index(Badge<DOM::Document>, size_t index) { m_layout_index = index; }
+
     [[nodiscard]] Box const* static_position_containing_block() const;
     [[nodiscard]] Box* static_position_containing_block() { return const_cast<Box*>(const_cast<Node const*>(this)->static_position_containing_block()); }
 
@@ -231,6 +238,8 @@ private:
     Optional<CSS::GeneratedPseudoElement> m_generated_for {};
 
     u32 m_initial_quote_nesting_level { 0 };
+
+    size_t m_layout_index { no_layout_index };
 };
 
 class NodeWithStyle : public Node {
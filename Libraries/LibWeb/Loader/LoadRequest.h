@@ -13,6 +13,7 @@
 #include <LibURL/URL.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web {
 
@@ -40,6 +41,13 @@ public:
     ByteBuffer const& body() const { return m_body; }
     void set_body(ByteBuffer body) { m_body = move(body); }
 
+    // The key under which RequestServer may store the response in its disk cache, if at all.
+    Optional<ByteString> const& cache_partition_key() const { return m_cache_partition_key; }
+    void set_cache_partition_key(Optional<ByteString> key) { m_cache_partition_key = move(key); }
+
+    RequestServer::RequestPriority priority() const { return m_priority; }
+    void set_priority(RequestServer::RequestPriority priority) { m_priority = priority; }
+
     void start_timer() { m_load_timer.start(); }
     AK::Duration load_time() const { return m_load_timer.elapsed_time(); }
 
@@ -80,6 +88,8 @@ private:
     ByteString m_method { "GET" };
     HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_headers;
     ByteBuffer m_body;
+    Optional<ByteString> m_cache_partition_key;
+    RequestServer::RequestPriority m_priority { RequestServer::RequestPriority::Medium };
     Core::ElapsedTimer m_load_timer;
     GC::Root<Page> m_page;
     bool m_main_resource { false };
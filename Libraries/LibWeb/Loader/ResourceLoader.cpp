@@ -407,7 +407,7 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
     }
 
     if (url.scheme() == "http" || url.scheme() == "https") {
-        auto protocol_request = start_network_request(request);
+        auto protocol_request = start_network_request(request, Requests::ResponseBodyTransport::Pipe);
         if (!protocol_request) {
             if (error_callback)
                 error_callback->function()("Failed to start network request"sv, {}, {}, {}, {}, {});
@@ -485,7 +485,9 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, GC::Root<OnHeadersRec
         return;
     }
 
-    auto protocol_request = start_network_request(request);
+    // NOTE: Unbuffered loads are usually large downloads and media, so have RequestServer put their bodies into shared
+    //       memory instead of sending them through a pipe.
+    auto protocol_request = start_network_request(request, Requests::ResponseBodyTransport::SharedMemoryRing);
     if (!protocol_request) {
         on_complete->function()(false, {}, "Failed to start network request"sv);
         return;
@@ -515,7 +517,7 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, GC::Root<OnHeadersRec
     protocol_request->set_unbuffered_request_callbacks(move(protocol_headers_received), move(protocol_data_received), move(protocol_complete));
 }
 
-RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest const& request)
+RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest const& request, Requests::ResponseBodyTransport response_body_transport)
 {
     auto proxy = ProxyMappings::the().proxy_for_url(request.url().value());
 
@@ -528,7 +530,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
     if (!headers.contains("User-Agent"))
         headers.set("User-Agent", m_user_agent.to_byte_string());
 
-    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy);
+    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy, request.cache_partition_key(), request.priority(), response_body_transport);
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
@@ -543,6 +545,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
         on_load_counter_change();
 
     m_active_requests.set(*protocol_request);
+    m_active_requests_by_load_request_id.set(request.id(), protocol_request.ptr());
     return protocol_request;
 }
 
@@ -569,12 +572,22 @@ void ResourceLoader::finish_network_request(NonnullRefPtr<Requests::Request> pro
     if (on_load_counter_change)
         on_load_counter_change();
 
+    m_active_requests_by_load_request_id.remove_all_matching([&](auto, auto* request) {
+        return request == protocol_request.ptr();
+    });
+
     deferred_invoke([this, protocol_request = move(protocol_request)] {
         auto did_remove = m_active_requests.remove(protocol_request);
         VERIFY(did_remove);
     });
 }
 
+void ResourceLoader::set_request_priority(int load_request_id, RequestServer::RequestPriority priority)
+{
+    if (auto request = m_active_requests_by_load_request_id.get(load_request_id); request.has_value())
+        (*request)->set_priority(priority);
+}
+
 void ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
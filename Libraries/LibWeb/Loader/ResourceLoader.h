@@ -9,12 +9,14 @@
 
 #include <AK/ByteString.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/HashTable.h>
 #include <LibCore/EventReceiver.h>
 #include <LibRequests/Forward.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Loader/Resource.h>
 #include <LibWeb/Loader/UserAgent.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web {
 
@@ -69,12 +71,15 @@ public:
     void clear_cache();
     void evict_from_cache(LoadRequest const&);
 
+    // Changes the priority of the network request that was started for the given LoadRequest, if it is still in flight.
+    void set_request_priority(int load_request_id, RequestServer::RequestPriority);
+
     GC::Heap& heap() { return m_heap; }
 
 private:
     explicit ResourceLoader(GC::Heap&, NonnullRefPtr<Requests::RequestClient>);
 
-    RefPtr<Requests::Request> start_network_request(LoadRequest const&);
+    RefPtr<Requests::Request> start_network_request(LoadRequest const&, Requests::ResponseBodyTransport);
     void handle_network_response_headers(LoadRequest const&, HTTP::HeaderMap const&);
     void finish_network_request(NonnullRefPtr<Requests::Request>);
 
@@ -83,6 +88,7 @@ private:
     GC::Heap& m_heap;
     NonnullRefPtr<Requests::RequestClient> m_request_client;
     HashTable<NonnullRefPtr<Requests::Request>> m_active_requests;
+    HashMap<int, Requests::Request*> m_active_requests_by_load_request_id;
 
     String m_user_agent;
     String m_platform;
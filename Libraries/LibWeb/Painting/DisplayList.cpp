@@ -10,6 +10,17 @@ namespace Web::Painting {
 
 void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
 {
+    command.visit(
+        [&](DrawPaintingSurface const&) { m_has_mutable_content = true; },
+        [&](PaintNestedDisplayList const& nested) {
+            if (nested.display_list && nested.display_list->has_mutable_content())
+                m_has_mutable_content = true;
+        },
+        [&](AddMask const& mask) {
+            if (mask.display_list && mask.display_list->has_mutable_content())
+                m_has_mutable_content = true;
+        },
+        [](auto const&) {});
     m_commands.append({ scroll_frame_id, move(command) });
 }
 
@@ -61,11 +72,16 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
     VERIFY(!m_surfaces.is_empty());
 
     for (size_t command_index = 0; command_index < commands.size(); command_index++) {
-        auto scroll_frame_id = commands[command_index].scroll_frame_id;
-        auto command = commands[command_index].command;
+        auto const& item = commands[command_index];
+        auto scroll_frame_id = item.scroll_frame_id;
 
-        if (command.has<PaintScrollBar>()) {
-            auto& paint_scroll_bar = command.get<PaintScrollBar>();
+        // OPTIMIZATION: Only copy the recorded command if it has to be adjusted for the current scroll state.
+        //               Copying every command would churn reference counts and duplicate paths and glyph runs.
+        Optional<Command> adjusted_command;
+
+        if (item.command.has<PaintScrollBar>()) {
+            adjusted_command = item.command;
+            auto& paint_scroll_bar = adjusted_command->get<PaintScrollBar>();
             auto scroll_offset = scroll_state.own_offset_for_frame_with_id(paint_scroll_bar.scroll_frame_id);
             if (paint_scroll_bar.vertical) {
                 auto offset = scroll_offset.y() * paint_scroll_bar.scroll_size;
@@ -79,14 +95,20 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
         if (scroll_frame_id.has_value()) {
             auto cumulative_offset = scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id.value());
             auto scroll_offset = cumulative_offset.to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
-            command.visit(
-                [&](auto& command) {
-                    if constexpr (requires { command.translate_by(scroll_offset); }) {
-                        command.translate_by(scroll_offset);
-                    }
-                });
+            if (!scroll_offset.is_zero()) {
+                if (!adjusted_command.has_value())
+                    adjusted_command = item.command;
+                adjusted_command->visit(
+                    [&](auto& command) {
+                        if constexpr (requires { command.translate_by(scroll_offset); }) {
+                            command.translate_by(scroll_offset);
+                        }
+                    });
+            }
         }
 
+        Command const& command = adjusted_command.has_value() ? adjusted_command.value() : item.command;
+
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || would_be_fully_clipped_by_painter(*bounding_rect))) {
             // Any clip or mask that's located outside of the visible region is equivalent to a simple clip-rect,
@@ -96,11 +96,16 @@ public:
     void set_device_pixels_per_css_pixel(double device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
     double device_pixels_per_css_pixel() const { return m_device_pixels_per_css_pixel; }
 
+    // True if playing back this list may produce different pixels over time without it being re-recorded,
+    // e.g. because it draws a canvas surface that is painted into directly.
+    bool has_mutable_content() const { return m_has_mutable_content; }
+
 private:
     DisplayList() = default;
 
     AK::SegmentedVector<CommandListItem, 512> m_commands;
     double m_device_pixels_per_css_pixel;
+    bool m_has_mutable_content { false };
 };
 
 }
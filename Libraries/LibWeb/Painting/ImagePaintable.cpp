@@ -65,16 +65,31 @@ void ImagePaintable::paint(PaintContext& context, PaintPhase phase) const
     if (phase == PaintPhase::Foreground) {
         auto image_rect = absolute_rect();
         auto image_rect_device_pixels = context.rounded_device_rect(image_rect);
+
+        // NOTE: The bitmap may have been decoded at a reduced size, so object-fit and object-position have to go by the
+        //       natural size of the image instead, if it has one.
+        Optional<CSSPixelSize> natural_size;
+        if (auto intrinsic_width = m_image_provider.intrinsic_width(), intrinsic_height = m_image_provider.intrinsic_height();
+            !m_is_svg_image && intrinsic_width.has_value() && intrinsic_height.has_value() && *intrinsic_width > 0 && *intrinsic_height > 0)
+            natural_size = CSSPixelSize { *intrinsic_width, *intrinsic_height };
+
+        // Images with object-fit: none are drawn at their natural size, so they must not be decoded any smaller than that.
+        auto bitmap_size = image_rect_device_pixels.size().to_type<int>();
+        if (natural_size.has_value() && computed_values().object_fit() == CSS::ObjectFit::None)
+            bitmap_size = context.rounded_device_size(*natural_size).to_type<int>();
+
         if (m_renders_as_alt_text) {
             auto enclosing_rect = context.enclosing_device_rect(image_rect).to_type<int>();
             context.display_list_recorder().draw_rect(enclosing_rect, Gfx::Color::Black);
             context.display_list_recorder().draw_text(enclosing_rect, m_alt_text, *Platform::FontPlugin::the().default_font(12), Gfx::TextAlignment::Center, computed_values().color());
-        } else if (auto bitmap = m_image_provider.current_image_bitmap(image_rect_device_pixels.size().to_type<int>())) {
+        } else if (auto bitmap = m_image_provider.current_image_bitmap(bitmap_size)) {
             ScopedCornerRadiusClip corner_clip { context, image_rect_device_pixels, normalized_border_radii_data(ShrinkRadiiForBorders::Yes) };
             auto image_int_rect_device_pixels = image_rect_device_pixels.to_type<int>();
             auto bitmap_rect = bitmap->rect();
             auto scaling_mode = to_gfx_scaling_mode(computed_values().image_rendering(), bitmap_rect, image_int_rect_device_pixels);
-            auto bitmap_aspect_ratio = (float)bitmap_rect.height() / bitmap_rect.width();
+            auto natural_width = natural_size.has_value() ? natural_size->width().to_float() : static_cast<float>(bitmap_rect.width());
+            auto natural_height = natural_size.has_value() ? natural_size->height().to_float() : static_cast<float>(bitmap_rect.height());
+            auto bitmap_aspect_ratio = natural_height / natural_width;
             auto image_aspect_ratio = (float)image_rect.height() / (float)image_rect.width();
 
             auto scale_x = 0.0f;
@@ -83,7 +98,7 @@ void ImagePaintable::paint(PaintContext& context, PaintPhase phase) const
             // https://drafts.csswg.org/css-images/#the-object-fit
             auto object_fit = m_is_svg_image ? CSS::ObjectFit::Contain : computed_values().object_fit();
             if (object_fit == CSS::ObjectFit::ScaleDown) {
-                if (bitmap_rect.width() > image_rect.width() || bitmap_rect.height() > image_rect.height()) {
+                if (image_rect.width() < natural_width || image_rect.height() < natural_height) {
                     object_fit = CSS::ObjectFit::Contain;
                 } else {
                     object_fit = CSS::ObjectFit::None;
@@ -92,24 +107,24 @@ void ImagePaintable::paint(PaintContext& context, PaintPhase phase) const
 
             switch (object_fit) {
             case CSS::ObjectFit::Fill:
-                scale_x = (float)image_rect.width() / bitmap_rect.width();
-                scale_y = (float)image_rect.height() / bitmap_rect.height();
+                scale_x = (float)image_rect.width() / natural_width;
+                scale_y = (float)image_rect.height() / natural_height;
                 break;
             case CSS::ObjectFit::Contain:
                 if (bitmap_aspect_ratio >= image_aspect_ratio) {
-                    scale_x = (float)image_rect.height() / bitmap_rect.height();
+                    scale_x = (float)image_rect.height() / natural_height;
                     scale_y = scale_x;
                 } else {
-                    scale_x = (float)image_rect.width() / bitmap_rect.width();
+                    scale_x = (float)image_rect.width() / natural_width;
                     scale_y = scale_x;
                 }
                 break;
             case CSS::ObjectFit::Cover:
                 if (bitmap_aspect_ratio >= image_aspect_ratio) {
-                    scale_x = (float)image_rect.width() / bitmap_rect.width();
+                    scale_x = (float)image_rect.width() / natural_width;
                     scale_y = scale_x;
                 } else {
-                    scale_x = (float)image_rect.height() / bitmap_rect.height();
+                    scale_x = (float)image_rect.height() / natural_height;
                     scale_y = scale_x;
                 }
                 break;
@@ -120,8 +135,8 @@ void ImagePaintable::paint(PaintContext& context, PaintPhase phase) const
                 scale_y = 1;
             }
 
-            auto scaled_bitmap_width = CSSPixels::nearest_value_for(bitmap_rect.width() * scale_x);
-            auto scaled_bitmap_height = CSSPixels::nearest_value_for(bitmap_rect.height() * scale_y);
+            auto scaled_bitmap_width = CSSPixels::nearest_value_for(natural_width * scale_x);
+            auto scaled_bitmap_height = CSSPixels::nearest_value_for(natural_height * scale_y);
 
             auto residual_horizontal = image_rect.width() - scaled_bitmap_width;
             auto residual_vertical = image_rect.height() - scaled_bitmap_height;
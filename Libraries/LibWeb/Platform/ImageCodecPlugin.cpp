@@ -11,6 +11,10 @@ namespace Web::Platform {
 
 static ImageCodecPlugin* s_the;
 
+AnimationSession::~AnimationSession() = default;
+
+ProgressiveDecode::~ProgressiveDecode() = default;
+
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
 ImageCodecPlugin& ImageCodecPlugin::the()
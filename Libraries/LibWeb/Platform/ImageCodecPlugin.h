@@ -7,11 +7,15 @@
 
 #pragma once
 
+#include <AK/Function.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/Promise.h>
 #include <LibGfx/ColorSpace.h>
 #include <LibGfx/Forward.h>
+#include <LibGfx/Size.h>
 
 namespace Web::Platform {
 
@@ -20,11 +24,42 @@ struct Frame {
     size_t duration { 0 };
 };
 
+// Decodes the remaining frames of an animation as they are asked for. The decoder's state is kept around for as long
+// as the session is alive.
+class AnimationSession : public RefCounted<AnimationSession> {
+public:
+    virtual ~AnimationSession();
+
+    virtual void request_frames(size_t first_frame_index, size_t count) = 0;
+
+    Function<void(size_t frame_index, Frame)> on_frame_decoded;
+};
+
+// Decodes an image while its encoded data is still arriving, reporting what has been decoded of it so far.
+class ProgressiveDecode : public RefCounted<ProgressiveDecode> {
+public:
+    virtual ~ProgressiveDecode();
+
+    virtual void append(ReadonlyBytes) = 0;
+    virtual void finish() = 0;
+
+    Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image;
+};
+
 struct DecodedImage {
+    // The size of the image. Its frames are smaller than this if it was decoded for a smaller ideal size.
+    Gfx::IntSize size;
     bool is_animated { false };
     u32 loop_count { 0 };
+    size_t frame_count { 0 };
     Vector<Frame> frames;
     Gfx::ColorSpace color_space;
+
+    // Only set for animations, in which case `frames` only holds the first frame.
+    RefPtr<AnimationSession> animation_session;
+
+    // The durations of every frame of such an animation, or 0 for frames whose duration is only known once decoded.
+    Vector<u32> frame_durations;
 };
 
 class ImageCodecPlugin {
@@ -34,7 +69,12 @@ public:
 
     virtual ~ImageCodecPlugin();
 
-    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    // If the image is going to be displayed a lot smaller than its actual size, the ideal size lets the decoder save time
+    // and memory by decoding it at a reduced size. Decoded images then still report their actual size.
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}) = 0;
+
+    // The callbacks are invoked once ProgressiveDecode::finish() has been called and the whole image has been decoded.
+    virtual ErrorOr<NonnullRefPtr<ProgressiveDecode>> start_progressive_decode(ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}) = 0;
 };
 
 }
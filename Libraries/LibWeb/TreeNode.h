@@ -66,10 +66,14 @@ public:
     size_t index() const
     {
         // The index of an object is its number of preceding siblings, or 0 if it has none.
-        size_t index = 0;
-        for (auto* node = previous_sibling(); node; node = node->previous_sibling())
-            ++index;
-        return index;
+        if (!m_parent)
+            return 0;
+
+        // OPTIMIZATION: Counting preceding siblings makes visiting every child of a large parent quadratic, so we
+        //               number all children of the parent at once, and keep those numbers until they shift.
+        if (!m_parent->m_child_indices_are_valid)
+            m_parent->update_child_indices();
+        return m_index;
     }
 
     bool is_ancestor_of(TreeNode const&) const;
@@ -343,11 +347,23 @@ protected:
     }
 
 private:
+    void update_child_indices() const
+    {
+        size_t index = 0;
+        for (auto* child = m_first_child; child; child = child->m_next_sibling)
+            child->m_index = index++;
+        m_child_indices_are_valid = true;
+    }
+
     T* m_parent { nullptr };
     T* m_first_child { nullptr };
     T* m_last_child { nullptr };
     T* m_next_sibling { nullptr };
     T* m_previous_sibling { nullptr };
+
+    // Our index among our siblings, only meaningful while our parent's m_child_indices_are_valid is set.
+    mutable size_t m_index { 0 };
+    mutable bool m_child_indices_are_valid { false };
 };
 
 template<typename T>
@@ -355,6 +371,10 @@ inline void TreeNode<T>::remove_child(GC::Ref<T> node)
 {
     VERIFY(node->m_parent == this);
 
+    // Removing anything but the last child shifts the index of the children after it.
+    if (node->m_next_sibling)
+        m_child_indices_are_valid = false;
+
     if (m_first_child == node)
         m_first_child = node->m_next_sibling;
 
@@ -377,6 +397,9 @@ inline void TreeNode<T>::append_child(GC::Ref<T> node)
 {
     VERIFY(!node->m_parent);
 
+    if (m_child_indices_are_valid)
+        node->m_index = m_last_child ? m_last_child->m_index + 1 : 0;
+
     if (m_last_child)
         m_last_child->m_next_sibling = node.ptr();
     node->m_previous_sibling = m_last_child;
@@ -403,6 +426,7 @@ inline void TreeNode<T>::replace_child(GC::Ref<T> new_child, GC::Ref<T> old_chil
     if (new_child->m_previous_sibling)
         new_child->m_previous_sibling->m_next_sibling = new_child;
     new_child->m_parent = old_child->m_parent;
+    new_child->m_index = old_child->m_index;
     old_child->m_next_sibling = nullptr;
     old_child->m_previous_sibling = nullptr;
     old_child->m_parent = nullptr;
@@ -417,6 +441,8 @@ inline void TreeNode<T>::insert_before(GC::Ref<T> node, GC::Ptr<T> child)
     VERIFY(!node->m_parent);
     VERIFY(child->parent() == this);
 
+    m_child_indices_are_valid = false;
+
     node->m_previous_sibling = child->m_previous_sibling;
     node->m_next_sibling = child;
 
@@ -436,6 +462,8 @@ inline void TreeNode<T>::prepend_child(GC::Ref<T> node)
 {
     VERIFY(!node->m_parent);
 
+    m_child_indices_are_valid = false;
+
     if (m_first_child)
         m_first_child->m_previous_sibling = node.ptr();
     node->m_next_sibling = m_first_child;
@@ -31,7 +31,73 @@ void ImageCodecPlugin::set_client(NonnullRefPtr<ImageDecoderClient::Client> clie
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+class AnimationSession final : public Web::Platform::AnimationSession {
+public:
+    explicit AnimationSession(NonnullRefPtr<ImageDecoderClient::AnimationSession> session)
+        : m_session(move(session))
+    {
+        m_session->on_frame_decoded = [this](u32 frame_index, ImageDecoderClient::Frame frame) {
+            if (on_frame_decoded)
+                on_frame_decoded(frame_index, { move(frame.bitmap), frame.duration });
+        };
+    }
+
+    virtual ~AnimationSession() override
+    {
+        m_session->on_frame_decoded = nullptr;
+    }
+
+    virtual void request_frames(size_t first_frame_index, size_t count) override
+    {
+        m_session->request_frames(static_cast<u32>(first_frame_index), static_cast<u32>(count));
+    }
+
+private:
+    NonnullRefPtr<ImageDecoderClient::AnimationSession> m_session;
+};
+
+class ProgressiveDecode final : public Web::Platform::ProgressiveDecode {
+public:
+    explicit ProgressiveDecode(NonnullRefPtr<ImageDecoderClient::ProgressiveDecode> decode)
+        : m_decode(move(decode))
+    {
+        m_decode->on_partial_image = [this](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+            if (on_partial_image)
+                on_partial_image(move(bitmap));
+        };
+    }
+
+    virtual ~ProgressiveDecode() override
+    {
+        m_decode->on_partial_image = nullptr;
+    }
+
+    virtual void append(ReadonlyBytes bytes) override { m_decode->append(bytes); }
+    virtual void finish() override { m_decode->finish(); }
+
+private:
+    NonnullRefPtr<ImageDecoderClient::ProgressiveDecode> m_decode;
+};
+
+static Web::Platform::DecodedImage to_platform_decoded_image(ImageDecoderClient::DecodedImage& result)
+{
+    // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
+    Web::Platform::DecodedImage decoded_image;
+    decoded_image.size = result.size;
+    decoded_image.is_animated = result.is_animated;
+    decoded_image.loop_count = result.loop_count;
+    decoded_image.frame_count = result.frame_count;
+    for (auto& frame : result.frames) {
+        decoded_image.frames.empend(move(frame.bitmap), frame.duration);
+    }
+    decoded_image.color_space = move(result.color_space);
+    if (result.animation_session)
+        decoded_image.animation_session = adopt_ref(*new AnimationSession(result.animation_session.release_nonnull()));
+    decoded_image.frame_durations = move(result.frame_durations);
+    return decoded_image;
+}
+
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size)
 {
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
@@ -47,22 +113,36 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
     auto image_decoder_promise = m_client->decode_image(
         bytes,
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
-            // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
-            Web::Platform::DecodedImage decoded_image;
-            decoded_image.is_animated = result.is_animated;
-            decoded_image.loop_count = result.loop_count;
-            for (auto& frame : result.frames) {
-                decoded_image.frames.empend(move(frame.bitmap), frame.duration);
-            }
-            decoded_image.color_space = move(result.color_space);
-            promise->resolve(move(decoded_image));
+            promise->resolve(to_platform_decoded_image(result));
             return {};
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        ideal_size);
 
     return promise;
 }
 
+ErrorOr<NonnullRefPtr<Web::Platform::ProgressiveDecode>> ImageCodecPlugin::start_progressive_decode(Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size)
+{
+    if (!m_client)
+        return Error::from_string_literal("ImageDecoderClient is disconnected");
+
+    auto decode = TRY(m_client->start_progressive_decode(
+        [on_resolved = move(on_resolved)](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+            auto decoded_image = to_platform_decoded_image(result);
+            if (on_resolved)
+                return on_resolved(decoded_image);
+            return {};
+        },
+        [on_rejected = move(on_rejected)](Error& error) {
+            if (on_rejected)
+                on_rejected(error);
+        },
+        ideal_size));
+
+    return adopt_ref(*new ProgressiveDecode(move(decode)));
+}
+
 }
@@ -21,6 +21,7 @@ set(GIF_DEBUG ON)
 set(HEAP_DEBUG ON)
 set(HIGHLIGHT_FOCUSED_FRAME_DEBUG ON)
 set(HTML_SCRIPT_DEBUG ON)
+set(HTTP_DISK_CACHE_DEBUG ON)
 set(HTTPJOB_DEBUG ON)
 set(HUNKS_DEBUG ON)
 set(ICO_DEBUG ON)
@@ -49,6 +50,7 @@ set(PLAYBACK_MANAGER_DEBUG ON)
 set(PNG_DEBUG ON)
 set(PROMISE_DEBUG ON)
 set(REGEX_DEBUG ON)
+set(RENDERING_THREAD_DEBUG ON)
 set(REQUESTSERVER_DEBUG ON)
 set(RESOURCE_DEBUG ON)
 set(RSA_PARSE_DEBUG ON)
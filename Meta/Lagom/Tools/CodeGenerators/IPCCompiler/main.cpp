@@ -720,6 +720,33 @@ public:
 
     static u32 static_magic() { return @endpoint.magic@; }
 
+    static StringView message_name([[maybe_unused]] int message_id)
+    {
+        switch (message_id) {)~~~");
+
+    for (auto const& message : endpoint.messages) {
+        auto do_message_name = [&](ByteString const& name) {
+            auto message_generator = generator.fork();
+
+            message_generator.set("message.name", name);
+            message_generator.set("message.pascal_name", pascal_case(name));
+
+            message_generator.append(R"~~~(
+        case (int)Messages::@endpoint.name@::MessageID::@message.pascal_name@:
+            return "@endpoint.name@::@message.pascal_name@"sv;)~~~");
+        };
+
+        do_message_name(message.name);
+        if (message.is_synchronous)
+            do_message_name(message.response_name());
+    }
+
+    generator.append(R"~~~(
+        default:
+            return "(unknown)"sv;
+        }
+    }
+
     static ErrorOr<NonnullOwnPtr<IPC::Message>> decode_message(ReadonlyBytes buffer, [[maybe_unused]] Queue<IPC::File>& files)
     {
         FixedMemoryStream stream { buffer };
@@ -30,6 +30,14 @@ void ConnectionFromClient::die()
     }
     m_pending_jobs.clear();
 
+    for (auto& [_, session] : m_animation_sessions)
+        session->has_ended = true;
+    m_animation_sessions.clear();
+
+    for (auto& [_, session] : m_progressive_decode_sessions)
+        session->has_ended = true;
+    m_progressive_decode_sessions.clear();
+
     auto client_id = this->client_id();
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
@@ -84,9 +92,13 @@ Messages::ImageDecoderServer::ConnectNewClientsResponse ConnectionFromClient::co
     return files;
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<RefPtr<Gfx::Bitmap>>& bitmaps, Vector<u32>& durations)
+static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, size_t first_frame_index, size_t count, Optional<Gfx::IntSize> ideal_size, Vector<RefPtr<Gfx::Bitmap>>& bitmaps, Vector<u32>& durations, Atomic<bool> const* has_ended = nullptr)
 {
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
+    auto end_frame_index = min(first_frame_index + count, decoder.frame_count());
+    for (size_t i = first_frame_index; i < end_frame_index; ++i) {
+        if (has_ended && has_ended->load())
+            return;
+
         auto frame_or_error = decoder.frame(i, ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.append({});
@@ -99,7 +111,7 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
     }
 }
 
-static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
 {
     auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
 
@@ -110,8 +122,10 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         return Error::from_string_literal("Could not decode image from encoded data");
 
     ConnectionFromClient::DecodeResult result;
+    result.size = decoder->size();
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.frame_count = decoder->frame_count();
 
     if (auto maybe_icc_data = decoder->color_space(); !maybe_icc_data.is_error())
         result.color_profile = maybe_icc_data.value();
@@ -132,24 +146,39 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations);
+    // OPTIMIZATION: Decoding every frame of a large animation up front costs a lot of memory and delays the first frame
+    //               by a lot. Only decode the first frame for now, and let the client ask for the rest once it needs them.
+    bool const decode_frames_on_demand = result.is_animated && result.frame_count > 1;
+
+    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, 0, decode_frames_on_demand ? 1 : result.frame_count, ideal_size, bitmaps, result.durations);
 
-    if (bitmaps.is_empty())
+    if (bitmaps.is_empty() || !bitmaps.first())
         return Error::from_string_literal("Could not decode image");
 
+    // NOTE: Tell the client how long the frames it doesn't have yet are, if the decoder knows without decoding them.
+    if (decode_frames_on_demand) {
+        for (size_t i = bitmaps.size(); i < result.frame_count; ++i)
+            result.durations.append(decoder->frame_duration(i).value_or(0));
+    }
+
     result.bitmaps = Gfx::BitmapSequence { move(bitmaps) };
 
+    if (decode_frames_on_demand)
+        result.animation_session = adopt_ref(*new ConnectionFromClient::AnimationSession(move(encoded_buffer), decoder.release_nonnull(), ideal_size));
+
     return result;
 }
 
 NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
 {
     return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
+        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) mutable -> ErrorOr<DecodeResult> {
+            return TRY(decode_image_to_details(move(encoded_buffer), ideal_size, mime_type));
         },
         [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, move(result.bitmaps), move(result.durations), result.scale, move(result.color_profile));
+            if (result.animation_session)
+                strong_this->m_animation_sessions.set(image_id, result.animation_session.release_nonnull());
+            strong_this->async_did_decode_image(image_id, result.size, result.is_animated, result.loop_count, result.frame_count, move(result.bitmaps), move(result.durations), result.scale, move(result.color_profile));
             strong_this->m_pending_jobs.remove(image_id);
             return {};
         },
@@ -180,6 +209,172 @@ void ConnectionFromClient::cancel_decoding(i64 image_id)
     if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
         job.value()->cancel();
     }
+    if (auto session = m_progressive_decode_sessions.take(image_id); session.has_value())
+        session.value()->has_ended = true;
+}
+
+// Don't send partial images more often than this, as each one is a full copy of the image.
+static constexpr auto minimum_time_between_partial_images = AK::Duration::from_milliseconds(100);
+
+// Enough data to tell image formats apart.
+static constexpr size_t minimum_size_to_sniff_image_format = 8;
+
+Messages::ImageDecoderServer::StartProgressiveDecodeResponse ConnectionFromClient::start_progressive_decode(Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    auto image_id = m_next_image_id++;
+    m_progressive_decode_sessions.set(image_id, adopt_ref(*new ProgressiveDecodeSession(ideal_size, move(mime_type))));
+    return image_id;
+}
+
+void ConnectionFromClient::append_progressive_decode_data(i64 image_id, ByteBuffer data)
+{
+    auto session = m_progressive_decode_sessions.get(image_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No progressive decode session for image {}", image_id);
+        return;
+    }
+
+    auto& progressive_session = *session.value();
+    if (progressive_session.encoded_data.try_append(data).is_error()) {
+        async_did_fail_to_decode_image(image_id, "Out of memory"_string);
+        m_progressive_decode_sessions.remove(image_id);
+        return;
+    }
+
+    if (!progressive_session.can_decode_progressively)
+        return;
+
+    // If we can't keep a second copy of the data for the decoder, just wait for all of it to arrive.
+    if (progressive_session.data_to_decode.try_append(data).is_error()) {
+        progressive_session.can_decode_progressively = false;
+        progressive_session.data_to_decode.clear();
+        return;
+    }
+
+    if (!progressive_session.is_decoding && progressive_session.encoded_data.size() >= minimum_size_to_sniff_image_format)
+        decode_progressive_data(image_id, progressive_session);
+}
+
+void ConnectionFromClient::decode_progressive_data(i64 image_id, ProgressiveDecodeSession& session)
+{
+    session.is_decoding = true;
+
+    auto data = move(session.data_to_decode);
+    (void)PartialImageJob::construct(
+        [session = NonnullRefPtr(session), data = move(data)](auto&) -> ErrorOr<RefPtr<Gfx::Bitmap>> {
+            if (session->has_ended || !session->can_decode_progressively)
+                return nullptr;
+
+            if (!session->decoder) {
+                session->decoder = TRY(Gfx::ProgressiveImageDecoder::try_create_for_data_prefix(data));
+                if (!session->decoder) {
+                    session->can_decode_progressively = false;
+                    return nullptr;
+                }
+            }
+
+            auto made_progress_or_error = session->decoder->append(data);
+            if (made_progress_or_error.is_error()) {
+                dbgln_if(IMAGE_DECODER_DEBUG, "Progressive decoding failed: {}", made_progress_or_error.error());
+
+                // NOTE: This is not fatal, the full decode will report whatever is wrong with the image.
+                session->can_decode_progressively = false;
+                session->decoder = nullptr;
+                return nullptr;
+            }
+
+            auto bitmap = session->decoder->bitmap();
+            if (!made_progress_or_error.value() || !bitmap)
+                return nullptr;
+
+            auto now = MonotonicTime::now_coarse();
+            if (now - session->last_partial_image_time < minimum_time_between_partial_images)
+                return nullptr;
+            session->last_partial_image_time = now;
+
+            // NOTE: The decoder keeps writing into its bitmap, so hand out a snapshot of it.
+            return TRY(bitmap->clone());
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](RefPtr<Gfx::Bitmap> bitmap) -> ErrorOr<void> {
+            auto session = strong_this->m_progressive_decode_sessions.get(image_id);
+            if (!session.has_value() || !strong_this->is_open())
+                return {};
+
+            auto& progressive_session = *session.value();
+            progressive_session.is_decoding = false;
+
+            if (bitmap) {
+                Vector<RefPtr<Gfx::Bitmap>> bitmaps;
+                bitmaps.append(move(bitmap));
+                strong_this->async_did_decode_partial_image(image_id, Gfx::BitmapSequence { move(bitmaps) });
+            }
+
+            if (progressive_session.can_decode_progressively && !progressive_session.data_to_decode.is_empty())
+                strong_this->decode_progressive_data(image_id, progressive_session);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
+            dbgln_if(IMAGE_DECODER_DEBUG, "Progressive decoding failed: {}", error);
+            if (auto session = strong_this->m_progressive_decode_sessions.get(image_id); session.has_value()) {
+                session.value()->is_decoding = false;
+                session.value()->can_decode_progressively = false;
+            }
+        });
+}
+
+void ConnectionFromClient::finish_progressive_decode(i64 image_id)
+{
+    auto session = m_progressive_decode_sessions.take(image_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No progressive decode session for image {}", image_id);
+        return;
+    }
+    session.value()->has_ended = true;
+
+    auto const& encoded_data = session.value()->encoded_data;
+    auto encoded_buffer_or_error = Core::AnonymousBuffer::create_with_size(encoded_data.size());
+    if (encoded_buffer_or_error.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", encoded_buffer_or_error.error())));
+        return;
+    }
+
+    auto encoded_buffer = encoded_buffer_or_error.release_value();
+    encoded_data.bytes().copy_to(Bytes { encoded_buffer.data<u8>(), encoded_buffer.size() });
+
+    // The image is now decoded in full like any other, which also answers the client's request for it.
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, move(encoded_buffer), session.value()->ideal_size, session.value()->mime_type));
+}
+
+void ConnectionFromClient::request_animation_frames(i64 image_id, u32 first_frame_index, u32 count)
+{
+    auto session = m_animation_sessions.get(image_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No animation session for image {}", image_id);
+        return;
+    }
+    if (count == 0 || first_frame_index >= session.value()->decoder->frame_count())
+        return;
+
+    (void)FramesJob::construct(
+        [session = NonnullRefPtr(*session.value()), first_frame_index, count](auto&) -> ErrorOr<DecodedFrames> {
+            DecodedFrames frames;
+            Threading::MutexLocker locker(session->decoder_mutex);
+            decode_image_to_bitmaps_and_durations_with_decoder(session->decoder, first_frame_index, count, session->ideal_size, frames.bitmaps.bitmaps, frames.durations, &session->has_ended);
+            return frames;
+        },
+        [strong_this = NonnullRefPtr(*this), image_id, first_frame_index](DecodedFrames frames) -> ErrorOr<void> {
+            // The client may have lost interest in the animation while we were decoding.
+            if (!strong_this->m_animation_sessions.contains(image_id) || !strong_this->is_open())
+                return {};
+            strong_this->async_did_decode_animation_frames(image_id, first_frame_index, move(frames.bitmaps), move(frames.durations));
+            return {};
+        });
+}
+
+void ConnectionFromClient::end_animation_session(i64 image_id)
+{
+    if (auto session = m_animation_sessions.take(image_id); session.has_value())
+        session.value()->has_ended = true;
 }
 
 }
@@ -6,14 +6,19 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
+#include <AK/Time.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibGfx/BitmapSequence.h>
 #include <LibGfx/ColorSpace.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibThreading/BackgroundAction.h>
+#include <LibThreading/Mutex.h>
 
 namespace ImageDecoder {
 
@@ -26,31 +31,100 @@ public:
 
     virtual void die() override;
 
+    // Only the first frame of an animated image is decoded up front. The decoder is then kept alive, so the client can
+    // ask for the remaining frames as it needs them, instead of holding every frame of the animation at once.
+    struct AnimationSession : public AtomicRefCounted<AnimationSession> {
+        AnimationSession(Core::AnonymousBuffer encoded_buffer, NonnullRefPtr<Gfx::ImageDecoder> decoder, Optional<Gfx::IntSize> ideal_size)
+            : encoded_buffer(move(encoded_buffer))
+            , decoder(move(decoder))
+            , ideal_size(ideal_size)
+        {
+        }
+
+        // NOTE: The decoder reads straight from the encoded data, so we have to keep it alive as well.
+        Core::AnonymousBuffer encoded_buffer;
+        NonnullRefPtr<Gfx::ImageDecoder> decoder;
+        Optional<Gfx::IntSize> ideal_size;
+
+        // Frames are decoded on whichever background thread is free, but the decoder can only decode one at a time.
+        Threading::Mutex decoder_mutex;
+
+        // Set once the client ends the session, so that frame decoding that is still queued can bail out early.
+        Atomic<bool> has_ended { false };
+    };
+
+    // Decodes an image while its encoded data is still arriving, so that the client can show what we have so far. Once
+    // all of the data is there, it is decoded in full like any other image, under the same image id.
+    struct ProgressiveDecodeSession : public AtomicRefCounted<ProgressiveDecodeSession> {
+        ProgressiveDecodeSession(Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+            : ideal_size(ideal_size)
+            , mime_type(move(mime_type))
+        {
+        }
+
+        // NOTE: Partial images are always decoded at full size, only the final decode makes use of this.
+        Optional<Gfx::IntSize> ideal_size;
+        Optional<ByteString> mime_type;
+
+        // Only touched on the main thread.
+        ByteBuffer encoded_data;
+        ByteBuffer data_to_decode;
+        bool is_decoding { false };
+
+        // Only touched by the background action that is decoding the data, of which there is at most one at a time.
+        OwnPtr<Gfx::ProgressiveImageDecoder> decoder;
+        MonotonicTime last_partial_image_time { MonotonicTime::now_coarse() };
+
+        Atomic<bool> can_decode_progressively { true };
+        Atomic<bool> has_ended { false };
+    };
+
     struct DecodeResult {
+        // The size of the image, which its bitmaps are smaller than if they were decoded for a smaller ideal size.
+        Gfx::IntSize size;
         bool is_animated = false;
         u32 loop_count = 0;
+        u32 frame_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
         Gfx::BitmapSequence bitmaps;
+        // For animations that are decoded on demand, this also holds the durations of the frames that haven't been
+        // decoded yet, or 0 where those are unknown.
         Vector<u32> durations;
         Gfx::ColorSpace color_profile;
+        RefPtr<AnimationSession> animation_session;
+    };
+
+    struct DecodedFrames {
+        Gfx::BitmapSequence bitmaps;
+        Vector<u32> durations;
     };
 
 private:
     using Job = Threading::BackgroundAction<DecodeResult>;
+    using FramesJob = Threading::BackgroundAction<DecodedFrames>;
+    using PartialImageJob = Threading::BackgroundAction<RefPtr<Gfx::Bitmap>>;
 
     explicit ConnectionFromClient(NonnullOwnPtr<IPC::Transport>);
 
     virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::StartProgressiveDecodeResponse start_progressive_decode(Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type) override;
+    virtual void append_progressive_decode_data(i64 image_id, ByteBuffer data) override;
+    virtual void finish_progressive_decode(i64 image_id) override;
+    virtual void request_animation_frames(i64 image_id, u32 first_frame_index, u32 count) override;
+    virtual void end_animation_session(i64 image_id) override;
     virtual Messages::ImageDecoderServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
     virtual Messages::ImageDecoderServer::InitTransportResponse init_transport(int peer_pid) override;
 
     ErrorOr<IPC::File> connect_new_client();
 
     NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    void decode_progressive_data(i64 image_id, ProgressiveDecodeSession&);
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+    HashMap<i64, NonnullRefPtr<AnimationSession>> m_animation_sessions;
+    HashMap<i64, NonnullRefPtr<ProgressiveDecodeSession>> m_progressive_decode_sessions;
 };
 
 }
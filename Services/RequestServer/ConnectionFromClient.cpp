@@ -7,6 +7,7 @@
 #include "WebSocketImplCurl.h"
 
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <AK/IDAllocator.h>
 #include <AK/NonnullOwnPtr.h>
 #include <LibCore/ElapsedTimer.h>
@@ -34,6 +35,8 @@ ByteString g_default_certificate_path;
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 static long s_connect_timeout_seconds = 90L;
+static long s_max_connections_per_host = 6L;
+static OwnPtr<DiskCache> s_disk_cache;
 static struct {
     Optional<Core::SocketAddress> server_address;
     Optional<ByteString> server_hostname;
@@ -99,8 +102,26 @@ ByteString build_curl_resolve_list(DNS::LookupResult const& dns_result, StringVi
     return resolve_opt_builder.to_byte_string();
 }
 
+// Writes as much of the given bytes as fits into the (non-blocking) file without waiting, and returns how many that was.
+static ErrorOr<size_t> write_without_blocking(int fd, ReadonlyBytes bytes)
+{
+    size_t total_written = 0;
+    while (total_written < bytes.size()) {
+        auto result = Core::System::write(fd, bytes.slice(total_written));
+        if (result.is_error()) {
+            if (result.error().code() == EAGAIN)
+                break;
+            return result.release_error();
+        }
+        if (result.value() == 0)
+            return Error::from_string_literal("write returned 0");
+        total_written += result.value();
+    }
+    return total_written;
+}
+
 struct ConnectionFromClient::ActiveRequest {
-    CURLM* multi { nullptr };
+    ConnectionPool& pool;
     CURL* easy { nullptr };
     Vector<curl_slist*> curl_string_lists;
     i32 request_id { 0 };
@@ -114,9 +135,31 @@ struct ConnectionFromClient::ActiveRequest {
     String url;
     Optional<String> reason_phrase;
     ByteBuffer body;
-
-    ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, int writer_fd)
-        : multi(multi)
+    RequestPriority priority { RequestPriority::Medium };
+    bool is_in_flight { false };
+
+    // Response body bytes that the pipe didn't take yet. The transfer is paused while there are any.
+    ByteBuffer pending_body;
+    bool is_waiting_for_pipe_space { false };
+    Function<void()> on_pending_body_written;
+
+    // If set, the response body is written into this ring instead of the pipe, which then only serves as a doorbell.
+    Optional<Requests::ResponseBodyRing> body_ring;
+    bool is_waiting_for_body_ring_space { false };
+
+    // State for storing the response in the disk cache, or for revalidating a response that is already stored there.
+    Optional<ByteString> cache_partition_key;
+    ByteString method;
+    URL::URL request_url;
+    HTTP::HeaderMap request_headers;
+    UnixDateTime request_time;
+    OwnPtr<CacheEntryWriter> cache_entry_writer;
+    Optional<ByteString> revalidated_cache_key;
+    int cached_body_fd { -1 };
+    bool should_restart_without_validation { false };
+
+    ActiveRequest(ConnectionFromClient& client, ConnectionPool& pool, CURL* easy, i32 request_id, int writer_fd)
+        : pool(pool)
         , easy(easy)
         , request_id(request_id)
         , client(client)
@@ -126,17 +169,51 @@ struct ConnectionFromClient::ActiveRequest {
 
     ~ActiveRequest()
     {
+        notifier = nullptr;
         if (writer_fd > 0)
             MUST(Core::System::close(writer_fd));
+        if (cached_body_fd >= 0)
+            MUST(Core::System::close(cached_body_fd));
 
-        auto result = curl_multi_remove_handle(multi, easy);
-        VERIFY(result == CURLM_OK);
+        pool.unschedule(*this);
         curl_easy_cleanup(easy);
 
         for (auto* string_list : curl_string_lists)
             curl_slist_free_all(string_list);
     }
 
+    void wait_for_pipe_space()
+    {
+        if (!notifier) {
+            notifier = Core::Notifier::construct(writer_fd, Core::NotificationType::Write);
+            notifier->on_activation = [this] { flush_pending_body(); };
+        }
+        notifier->set_enabled(true);
+    }
+
+    void flush_pending_body()
+    {
+        auto result = write_without_blocking(writer_fd, pending_body);
+        if (result.is_error()) {
+            dbgln("flush_pending_body: write failed: {}", result.error());
+            VERIFY_NOT_REACHED();
+        }
+        pending_body = MUST(pending_body.slice(result.value(), pending_body.size() - result.value()));
+        if (!pending_body.is_empty())
+            return;
+
+        notifier->set_enabled(false);
+
+        if (exchange(is_waiting_for_pipe_space, false)) {
+            // NOTE: curl may hand us the data it held back from within this call.
+            if (auto pause_result = curl_easy_pause(easy, CURLPAUSE_CONT); pause_result != CURLE_OK)
+                dbgln("flush_pending_body: Failed to resume request: {}", curl_easy_strerror(pause_result));
+        }
+
+        if (on_pending_body_written)
+            on_pending_body_written();
+    }
+
     void flush_headers_if_needed()
     {
         if (got_all_headers)
@@ -145,8 +222,79 @@ struct ConnectionFromClient::ActiveRequest {
         long http_status_code = 0;
         auto result = curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_status_code);
         VERIFY(result == CURLE_OK);
+
+        if (s_disk_cache && cache_partition_key.has_value()) {
+            if (http_status_code == 304 && revalidated_cache_key.has_value()) {
+                if (auto cached_response = use_revalidated_response(); cached_response.has_value()) {
+                    client->async_headers_became_available(request_id, cached_response->response_headers, cached_response->status_code, cached_response->reason_phrase);
+                    return;
+                }
+
+                // The stored response disappeared while we were revalidating it. The client didn't make a conditional
+                // request, so it must not see this 304. Ask the server for the full response instead.
+                should_restart_without_validation = true;
+                return;
+            } else {
+                start_storing_response(http_status_code);
+            }
+        }
+
         client->async_headers_became_available(request_id, headers, http_status_code, reason_phrase);
     }
+
+    // https://httpwg.org/specs/rfc9111.html#validation.received
+    Optional<DiskCache::CachedResponse> use_revalidated_response()
+    {
+        auto cached_response = s_disk_cache->freshen_entry(*revalidated_cache_key, headers, request_time);
+        if (!cached_response.has_value())
+            return {};
+
+        auto body_fd = s_disk_cache->open_body(cached_response->key);
+        if (body_fd.is_error()) {
+            dbgln("ActiveRequest: Unable to open cached response body: {}", body_fd.error());
+            s_disk_cache->remove_entry(cached_response->key);
+            return {};
+        }
+
+        cached_body_fd = body_fd.release_value();
+        return cached_response;
+    }
+
+    void start_storing_response(long http_status_code)
+    {
+        // The server sent a full response to our conditional request, so the stored one is outdated.
+        if (revalidated_cache_key.has_value())
+            s_disk_cache->remove_entry(*revalidated_cache_key);
+
+        if (!DiskCache::is_cacheable(method, request_headers, http_status_code, headers))
+            return;
+
+        auto writer = s_disk_cache->create_entry(*cache_partition_key, request_url, request_headers, http_status_code, reason_phrase, headers, request_time);
+        if (writer.is_error()) {
+            dbgln("ActiveRequest: Unable to create disk cache entry: {}", writer.error());
+            return;
+        }
+
+        cache_entry_writer = writer.release_value();
+    }
+};
+
+struct ConnectionFromClient::CachedResponseStream {
+    i32 request_id { 0 };
+    int writer_fd { -1 };
+    int body_fd { -1 };
+    ByteBuffer buffer;
+    ReadonlyBytes pending_bytes;
+    u64 bytes_sent { 0 };
+    RefPtr<Core::Notifier> notifier;
+    Optional<Requests::ResponseBodyRing> body_ring;
+    bool is_finished { false };
+
+    ~CachedResponseStream()
+    {
+        MUST(Core::System::close(writer_fd));
+        MUST(Core::System::close(body_fd));
+    }
 };
 
 size_t ConnectionFromClient::on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data)
@@ -181,6 +329,17 @@ size_t ConnectionFromClient::on_header_received(void* buffer, size_t size, size_
     return total_size;
 }
 
+static void ring_response_body_doorbell(Requests::ResponseBodyRing& ring, int writer_fd)
+{
+    if (!ring.take_consumer_waiting())
+        return;
+
+    // NOTE: If the pipe is full, the client has plenty of doorbells to answer already.
+    u8 doorbell = 0;
+    if (auto result = Core::System::write(writer_fd, { &doorbell, sizeof(doorbell) }); result.is_error() && result.error().code() != EAGAIN)
+        dbgln("ring_response_body_doorbell: write failed: {}", result.error());
+}
+
 size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t nmemb, void* user_data)
 {
     auto* request = static_cast<ActiveRequest*>(user_data);
@@ -188,25 +347,49 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
 
     size_t total_size = size * nmemb;
 
-    size_t remaining_length = total_size;
-    u8 const* remaining_data = static_cast<u8 const*>(buffer);
-    while (remaining_length > 0) {
-        auto result = Core::System::write(request->writer_fd, { remaining_data, remaining_length });
-        if (result.is_error()) {
-            if (result.error().code() != EAGAIN) {
-                dbgln("on_data_received: write failed: {}", result.error());
-                VERIFY_NOT_REACHED();
-            }
-            sched_yield();
-            continue;
+    // NOTE: This is the body of a response that the client won't see, as the request is about to be restarted.
+    if (request->should_restart_without_validation)
+        return total_size;
+
+    ReadonlyBytes bytes { buffer, total_size };
+
+    if (request->body_ring.has_value()) {
+        auto& ring = *request->body_ring;
+
+        // NOTE: curl doesn't let us take only part of the data, so pause the transfer until the client has made room
+        //       for all of it. Rings are never smaller than the largest chunk curl hands us, see start_request().
+        if (ring.should_wait_for_space(total_size)) {
+            request->is_waiting_for_body_ring_space = true;
+            return CURL_WRITEFUNC_PAUSE;
+        }
+
+        auto nwritten = ring.write_some(bytes);
+        VERIFY(nwritten == total_size);
+        ring_response_body_doorbell(ring, request->writer_fd);
+    } else {
+        // NOTE: While the client hasn't caught up with the data we've sent so far, pause the transfer. curl hands us
+        //       this data again once we resume it.
+        if (!request->pending_body.is_empty()) {
+            request->is_waiting_for_pipe_space = true;
+            return CURL_WRITEFUNC_PAUSE;
         }
-        auto nwritten = result.value();
-        if (nwritten == 0) {
-            dbgln("on_data_received: write returned 0");
+
+        auto result = write_without_blocking(request->writer_fd, bytes);
+        if (result.is_error()) {
+            dbgln("on_data_received: write failed: {}", result.error());
             VERIFY_NOT_REACHED();
         }
-        remaining_data += nwritten;
-        remaining_length -= nwritten;
+        if (result.value() < total_size) {
+            request->pending_body = MUST(ByteBuffer::copy(bytes.slice(result.value())));
+            request->wait_for_pipe_space();
+        }
+    }
+
+    if (request->cache_entry_writer) {
+        if (auto result = request->cache_entry_writer->write({ buffer, total_size }); result.is_error()) {
+            dbgln("on_data_received: Unable to write to disk cache: {}", result.error());
+            request->cache_entry_writer = nullptr;
+        }
     }
 
     request->downloaded_so_far += total_size;
@@ -216,22 +399,22 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
 
 int ConnectionFromClient::on_socket_callback(CURL*, int sockfd, int what, void* user_data, void*)
 {
-    auto* client = static_cast<ConnectionFromClient*>(user_data);
+    auto* pool = static_cast<ConnectionPool*>(user_data);
 
     if (what == CURL_POLL_REMOVE) {
-        client->m_read_notifiers.remove(sockfd);
-        client->m_write_notifiers.remove(sockfd);
+        pool->read_notifiers.remove(sockfd);
+        pool->write_notifiers.remove(sockfd);
         return 0;
     }
 
     if (what & CURL_POLL_IN) {
-        client->m_read_notifiers.ensure(sockfd, [client, sockfd, multi = client->m_curl_multi] {
+        pool->read_notifiers.ensure(sockfd, [pool, sockfd] {
             auto notifier = Core::Notifier::construct(sockfd, Core::NotificationType::Read);
-            notifier->on_activation = [client, sockfd, multi] {
+            notifier->on_activation = [pool, sockfd] {
                 int still_running = 0;
-                auto result = curl_multi_socket_action(multi, sockfd, CURL_CSELECT_IN, &still_running);
+                auto result = curl_multi_socket_action(pool->multi, sockfd, CURL_CSELECT_IN, &still_running);
                 VERIFY(result == CURLM_OK);
-                client->check_active_requests();
+                check_active_requests(*pool);
             };
             notifier->set_enabled(true);
             return notifier;
@@ -239,13 +422,13 @@ int ConnectionFromClient::on_socket_callback(CURL*, int sockfd, int what, void*
     }
 
     if (what & CURL_POLL_OUT) {
-        client->m_write_notifiers.ensure(sockfd, [client, sockfd, multi = client->m_curl_multi] {
+        pool->write_notifiers.ensure(sockfd, [pool, sockfd] {
             auto notifier = Core::Notifier::construct(sockfd, Core::NotificationType::Write);
-            notifier->on_activation = [client, sockfd, multi] {
+            notifier->on_activation = [pool, sockfd] {
                 int still_running = 0;
-                auto result = curl_multi_socket_action(multi, sockfd, CURL_CSELECT_OUT, &still_running);
+                auto result = curl_multi_socket_action(pool->multi, sockfd, CURL_CSELECT_OUT, &still_running);
                 VERIFY(result == CURLM_OK);
-                client->check_active_requests();
+                check_active_requests(*pool);
             };
             notifier->set_enabled(true);
             return notifier;
@@ -257,48 +440,134 @@ int ConnectionFromClient::on_socket_callback(CURL*, int sockfd, int what, void*
 
 int ConnectionFromClient::on_timeout_callback(void*, long timeout_ms, void* user_data)
 {
-    auto* client = static_cast<ConnectionFromClient*>(user_data);
-    if (!client->m_timer)
+    auto* pool = static_cast<ConnectionPool*>(user_data);
+    if (!pool->timer)
         return 0;
     if (timeout_ms < 0) {
-        client->m_timer->stop();
+        pool->timer->stop();
     } else {
-        client->m_timer->restart(timeout_ms);
+        pool->timer->restart(timeout_ms);
     }
     return 0;
 }
 
-ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transport)
-    : IPC::ConnectionFromClient<RequestClientEndpoint, RequestServerEndpoint>(*this, move(transport), s_client_ids.allocate())
-    , m_resolver(default_resolver())
+ConnectionPool::ConnectionPool()
+    : m_scheduler(
+          [this](ActiveRequest& request) {
+              auto result = curl_multi_add_handle(multi, request.easy);
+              VERIFY(result == CURLM_OK);
+          },
+          [this](ActiveRequest& request) {
+              auto result = curl_multi_remove_handle(multi, request.easy);
+              VERIFY(result == CURLM_OK);
+          })
 {
-    s_connections.set(client_id(), *this);
-
-    m_curl_multi = curl_multi_init();
+    multi = curl_multi_init();
 
     auto set_option = [this](auto option, auto value) {
-        auto result = curl_multi_setopt(m_curl_multi, option, value);
+        auto result = curl_multi_setopt(multi, option, value);
         VERIFY(result == CURLM_OK);
     };
-    set_option(CURLMOPT_SOCKETFUNCTION, &on_socket_callback);
+    set_option(CURLMOPT_SOCKETFUNCTION, &ConnectionFromClient::on_socket_callback);
     set_option(CURLMOPT_SOCKETDATA, this);
-    set_option(CURLMOPT_TIMERFUNCTION, &on_timeout_callback);
+    set_option(CURLMOPT_TIMERFUNCTION, &ConnectionFromClient::on_timeout_callback);
     set_option(CURLMOPT_TIMERDATA, this);
+    set_option(CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    set_option(CURLMOPT_MAX_HOST_CONNECTIONS, s_max_connections_per_host);
 
-    m_timer = Core::Timer::create_single_shot(0, [this] {
+    // NOTE: Depending on the curl version, TLS sessions are cached per easy handle rather than per multi handle. Share
+    //       them explicitly, so that a new connection to a host we've talked to before can resume its TLS session.
+    share = curl_share_init();
+    auto result = curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    VERIFY(result == CURLSHE_OK);
+
+    timer = Core::Timer::create_single_shot(0, [this] {
         int still_running = 0;
-        auto result = curl_multi_socket_action(m_curl_multi, CURL_SOCKET_TIMEOUT, 0, &still_running);
+        auto result = curl_multi_socket_action(multi, CURL_SOCKET_TIMEOUT, 0, &still_running);
         VERIFY(result == CURLM_OK);
-        check_active_requests();
+        ConnectionFromClient::check_active_requests(*this);
     });
 }
 
+ConnectionPool::~ConnectionPool()
+{
+    timer->stop();
+
+    curl_multi_cleanup(multi);
+    multi = nullptr;
+
+    curl_share_cleanup(share);
+    share = nullptr;
+}
+
+// NOTE: curl passes stream weights to the server as HTTP/2 priority information, including when a weight changes while
+//       the transfer is in flight.
+static long http2_stream_weight(RequestPriority priority)
+{
+    switch (priority) {
+    case RequestPriority::VeryHigh:
+        return 256;
+    case RequestPriority::High:
+        return 220;
+    case RequestPriority::Medium:
+        return 147;
+    case RequestPriority::Low:
+        return 64;
+    case RequestPriority::VeryLow:
+        return 16;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void ConnectionPool::schedule(ActiveRequest& request)
+{
+    m_scheduler.schedule(request);
+    if (!request.is_in_flight)
+        dbgln_if(REQUESTSERVER_DEBUG, "ConnectionPool: Deferring low priority request for {}", request.url);
+}
+
+void ConnectionPool::unschedule(ActiveRequest& request)
+{
+    m_scheduler.unschedule(request);
+}
+
+void ConnectionPool::set_priority(ActiveRequest& request, RequestPriority priority)
+{
+    if (request.priority == priority)
+        return;
+
+    m_scheduler.set_priority(request, priority);
+
+    auto result = curl_easy_setopt(request.easy, CURLOPT_STREAM_WEIGHT, http2_stream_weight(priority));
+    if (result != CURLE_OK)
+        dbgln("ConnectionPool: Failed to update stream weight: {}", curl_easy_strerror(result));
+}
+
+static WeakPtr<ConnectionPool> s_connection_pool {};
+static NonnullRefPtr<ConnectionPool> default_connection_pool()
+{
+    if (auto pool = s_connection_pool.strong_ref())
+        return *pool;
+
+    auto pool = make_ref_counted<ConnectionPool>();
+    s_connection_pool = pool;
+    return pool;
+}
+
+ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transport)
+    : IPC::ConnectionFromClient<RequestClientEndpoint, RequestServerEndpoint>(*this, move(transport), s_client_ids.allocate())
+    , m_resolver(default_resolver())
+    , m_connection_pool(default_connection_pool())
+{
+    s_connections.set(client_id(), *this);
+}
+
 ConnectionFromClient::~ConnectionFromClient()
 {
+    // NOTE: These hold easy handles that are attached to the shared multi handle, so they must go before our reference
+    //       to the connection pool does.
     m_active_requests.clear();
-
-    curl_multi_cleanup(m_curl_multi);
-    m_curl_multi = nullptr;
+    m_websockets.clear();
 }
 
 void ConnectionFromClient::die()
@@ -307,8 +576,16 @@ void ConnectionFromClient::die()
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
 
-    if (s_connections.is_empty())
+    if (s_connections.is_empty()) {
+        if (s_disk_cache)
+            s_disk_cache->flush_index();
         Core::EventLoop::current().quit(0);
+    }
+}
+
+void ConnectionFromClient::set_disk_cache(OwnPtr<DiskCache> disk_cache)
+{
+    s_disk_cache = move(disk_cache);
 }
 
 Messages::RequestServer::InitTransportResponse ConnectionFromClient::init_transport([[maybe_unused]] int peer_pid)
@@ -384,48 +661,156 @@ void ConnectionFromClient::set_use_system_dns()
 }
 
 #ifdef AK_OS_WINDOWS
-void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData)
+void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString>, RequestPriority, Optional<Core::AnonymousBuffer>)
 {
     VERIFY(0 && "RequestServer::ConnectionFromClient::start_request is not implemented");
 }
+
+void ConnectionFromClient::issue_network_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString>, Optional<ByteString>, UnixDateTime, RequestPriority, Optional<Requests::ResponseBodyRing>, Optional<int>)
+{
+    VERIFY(0 && "RequestServer::ConnectionFromClient::issue_network_request is not implemented");
+}
 #else
-void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data)
+// https://httpwg.org/specs/rfc9218.html#urgency
+static constexpr u8 default_urgency = 3;
+static u8 urgency_for_priority(RequestPriority priority)
+{
+    switch (priority) {
+    case RequestPriority::VeryHigh:
+        return 0;
+    case RequestPriority::High:
+        return 1;
+    case RequestPriority::Medium:
+        return default_urgency;
+    case RequestPriority::Low:
+        return 5;
+    case RequestPriority::VeryLow:
+        return 7;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static bool is_conditional_or_range_request(HTTP::HeaderMap const& request_headers)
+{
+    return request_headers.contains("If-None-Match"sv)
+        || request_headers.contains("If-Modified-Since"sv)
+        || request_headers.contains("If-Match"sv)
+        || request_headers.contains("If-Unmodified-Since"sv)
+        || request_headers.contains("If-Range"sv)
+        || request_headers.contains("Range"sv);
+}
+
+void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, Optional<ByteString> cache_partition_key, RequestPriority priority, Optional<Core::AnonymousBuffer> response_body_ring)
+{
+    if (!is_valid_request_priority(priority)) {
+        dbgln("StartRequest: Invalid request priority {}", to_underlying(priority));
+        async_request_finished(request_id, 0, {}, Requests::NetworkError::Unknown);
+        return;
+    }
+
+    auto request_time = UnixDateTime::now();
+    Optional<ByteString> revalidated_cache_key;
+
+    Optional<Requests::ResponseBodyRing> body_ring;
+    if (response_body_ring.has_value()) {
+        auto ring = Requests::ResponseBodyRing::adopt(response_body_ring.release_value());
+        if (ring.is_error()) {
+            dbgln("StartRequest: Invalid response body ring: {}", ring.error());
+            async_request_finished(request_id, 0, {}, Requests::NetworkError::Unknown);
+            return;
+        }
+        // NOTE: curl hands us up to CURL_MAX_WRITE_SIZE bytes at a time, all of which have to fit into the ring.
+        if (ring.value().capacity() < CURL_MAX_WRITE_SIZE) {
+            dbgln("StartRequest: Response body ring is too small ({} bytes)", ring.value().capacity());
+            async_request_finished(request_id, 0, {}, Requests::NetworkError::Unknown);
+            return;
+        }
+        body_ring = ring.release_value();
+    }
+
+    if (!s_disk_cache)
+        cache_partition_key.clear();
+
+    // NOTE: Conditional and range requests are made by clients that manage a cache of their own, so pass them through.
+    if (cache_partition_key.has_value() && !is_conditional_or_range_request(request_headers)) {
+        if (auto cached_response = s_disk_cache->find_response(*cache_partition_key, url, method, request_headers); cached_response.has_value()) {
+            if (cached_response->freshness == DiskCache::Freshness::Fresh) {
+                if (start_cached_response(request_id, *cached_response, body_ring))
+                    return;
+            } else {
+                // https://httpwg.org/specs/rfc9111.html#validation.sent
+                if (auto etag = cached_response->response_headers.get("ETag"sv); etag.has_value())
+                    request_headers.set("If-None-Match"sv, *etag);
+                if (auto last_modified = cached_response->response_headers.get("Last-Modified"sv); last_modified.has_value())
+                    request_headers.set("If-Modified-Since"sv, *last_modified);
+                revalidated_cache_key = move(cached_response->key);
+            }
+        }
+    }
+
+    issue_network_request(request_id, move(method), move(url), move(request_headers), move(request_body), proxy_data, move(cache_partition_key), move(revalidated_cache_key), request_time, priority, move(body_ring), {});
+}
+
+// Sends the request to the network. If writer_fd is set, the client has already been told about the request (i.e. this
+// is a restarted request), and the response body keeps going to the same pipe.
+void ConnectionFromClient::issue_network_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, Optional<ByteString> cache_partition_key, Optional<ByteString> revalidated_cache_key, UnixDateTime request_time, RequestPriority priority, Optional<Requests::ResponseBodyRing> body_ring, Optional<int> writer_fd)
 {
     auto host = url.serialized_host().to_byte_string();
 
+    auto fail = [this, request_id, writer_fd](Requests::NetworkError network_error) {
+        if (writer_fd.has_value())
+            MUST(Core::System::close(*writer_fd));
+        // FIXME: Implement timing info for DNS lookup failure.
+        async_request_finished(request_id, 0, {}, network_error);
+    };
+
     m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA })
-        ->when_rejected([this, request_id](auto const& error) {
+        ->when_rejected([fail](auto const& error) {
             dbgln("StartRequest: DNS lookup failed: {}", error);
-            // FIXME: Implement timing info for DNS lookup failure.
-            async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
+            fail(Requests::NetworkError::UnableToResolveHost);
         })
-        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data](auto const& dns_result) mutable {
+        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data, cache_partition_key = move(cache_partition_key), revalidated_cache_key = move(revalidated_cache_key), request_time, priority, body_ring = move(body_ring), writer_fd, fail](auto const& dns_result) mutable {
             if (dns_result->records().is_empty() || dns_result->cached_addresses().is_empty()) {
                 dbgln("StartRequest: DNS lookup failed for '{}'", host);
-                // FIXME: Implement timing info for DNS lookup failure.
-                async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
+                fail(Requests::NetworkError::UnableToResolveHost);
                 return;
             }
 
             auto* easy = curl_easy_init();
             if (!easy) {
                 dbgln("StartRequest: Failed to initialize curl easy handle");
+                fail(Requests::NetworkError::Unknown);
                 return;
             }
 
-            auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
-            if (fds_or_error.is_error()) {
-                dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
-                return;
-            }
+            if (!writer_fd.has_value()) {
+                auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
+                if (fds_or_error.is_error()) {
+                    dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
+                    curl_easy_cleanup(easy);
+                    fail(Requests::NetworkError::Unknown);
+                    return;
+                }
 
-            auto fds = fds_or_error.release_value();
-            auto writer_fd = fds[1];
-            auto reader_fd = fds[0];
-            async_request_started(request_id, IPC::File::adopt_fd(reader_fd));
+                auto fds = fds_or_error.release_value();
+                writer_fd = fds[1];
+                auto reader_fd = fds[0];
+                async_request_started(request_id, IPC::File::adopt_fd(reader_fd));
+            }
 
-            auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
+            auto request = make<ActiveRequest>(*this, *m_connection_pool, easy, request_id, *writer_fd);
             request->url = url.to_string();
+            request->priority = priority;
+            request->body_ring = move(body_ring);
+
+            if (cache_partition_key.has_value()) {
+                request->cache_partition_key = move(cache_partition_key);
+                request->method = method;
+                request->request_url = url;
+                request->request_headers = request_headers;
+                request->request_time = request_time;
+                request->revalidated_cache_key = move(revalidated_cache_key);
+            }
 
             auto set_option = [easy](auto option, auto value) {
                 auto result = curl_easy_setopt(easy, option, value);
@@ -437,6 +822,11 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             };
 
             set_option(CURLOPT_PRIVATE, request.ptr());
+            set_option(CURLOPT_SHARE, m_connection_pool->share);
+
+            // Prefer waiting for an HTTP/2 connection that is being established to the same host over opening another
+            // connection, so that concurrent requests end up multiplexed on one connection.
+            set_option(CURLOPT_PIPEWAIT, 1L);
 
             if (!g_default_certificate_path.is_empty())
                 set_option(CURLOPT_CAINFO, g_default_certificate_path.characters());
@@ -462,6 +852,14 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
 
             set_option(CURLOPT_FOLLOWLOCATION, 0);
 
+            set_option(CURLOPT_STREAM_WEIGHT, http2_stream_weight(priority));
+
+            // https://httpwg.org/specs/rfc9218.html#header
+            if (!request_headers.contains("Priority"sv)) {
+                if (auto urgency = urgency_for_priority(priority); urgency != default_urgency)
+                    request_headers.set("Priority"sv, ByteString::formatted("u={}", urgency));
+            }
+
             struct curl_slist* curl_headers = nullptr;
 
             // NOTE: CURLOPT_POSTFIELDS automatically sets the Content-Type header.
@@ -507,10 +905,9 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             } else
                 VERIFY_NOT_REACHED();
 
-            auto result = curl_multi_add_handle(m_curl_multi, easy);
-            VERIFY(result == CURLM_OK);
-
+            auto& scheduled_request = *request;
             m_active_requests.set(request_id, move(request));
+            m_connection_pool->schedule(scheduled_request);
         });
 }
 #endif
@@ -610,10 +1007,27 @@ static Requests::RequestTimingInfo get_timing_info_from_curl_easy_handle(CURL* e
     };
 }
 
-void ConnectionFromClient::check_active_requests()
+static void record_connection_reuse(ConnectionPool& pool, CURL* easy_handle)
+{
+    // NOTE: A transfer that did not have to open any new connection reused one from the pool.
+    long new_connection_count = 0;
+    auto result = curl_easy_getinfo(easy_handle, CURLINFO_NUM_CONNECTS, &new_connection_count);
+    VERIFY(result == CURLE_OK);
+
+    ++pool.completed_transfer_count;
+    if (new_connection_count == 0)
+        ++pool.reused_connection_count;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "ConnectionPool: {} of {} transfers reused a connection ({}%)",
+        pool.reused_connection_count,
+        pool.completed_transfer_count,
+        pool.reused_connection_count * 100 / pool.completed_transfer_count);
+}
+
+void ConnectionFromClient::check_active_requests(ConnectionPool& pool)
 {
     int msgs_in_queue = 0;
-    while (auto* msg = curl_multi_info_read(m_curl_multi, &msgs_in_queue)) {
+    while (auto* msg = curl_multi_info_read(pool.multi, &msgs_in_queue)) {
         if (msg->msg != CURLMSG_DONE)
             continue;
 
@@ -635,11 +1049,20 @@ void ConnectionFromClient::check_active_requests()
         }
 
         auto* request = static_cast<ActiveRequest*>(application_private);
+        auto& client = *request->client;
 
         if (!request->is_connect_only) {
+            record_connection_reuse(pool, msg->easy_handle);
+
             auto timing_info = get_timing_info_from_curl_easy_handle(msg->easy_handle);
             request->flush_headers_if_needed();
 
+            if (request->should_restart_without_validation) {
+                auto finished_request = client.m_active_requests.take(request->request_id).release_value();
+                client.restart_request_without_validation(*finished_request);
+                continue;
+            }
+
             auto result_code = msg->data.result;
 
             // HTTPS servers might terminate their connection without proper notice of shutdown - i.e. they do not send
@@ -660,15 +1083,164 @@ void ConnectionFromClient::check_active_requests()
                 }
             }
 
-            async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
+            if (request->cache_entry_writer) {
+                if (request_was_successful)
+                    request->cache_entry_writer->commit();
+                request->cache_entry_writer = nullptr;
+            }
+
+            if (request->cached_body_fd >= 0 && request_was_successful) {
+                // The server confirmed that our stored response is still valid, so send its body to the client.
+                client.stream_cached_response(request->request_id, exchange(request->writer_fd, 0), exchange(request->cached_body_fd, -1), move(request->body_ring));
+            } else if (!request->pending_body.is_empty()) {
+                // NOTE: Closing the pipe now would cut the body short, so finish once the client has taken the rest.
+                request->pool.unschedule(*request);
+                request->on_pending_body_written = [&client, request_id = request->request_id, downloaded_so_far = request->downloaded_so_far, timing_info, network_error] {
+                    client.async_request_finished(request_id, downloaded_so_far, timing_info, network_error);
+                    client.deferred_invoke([&client, request_id] {
+                        client.m_active_requests.remove(request_id);
+                    });
+                };
+                continue;
+            } else {
+                client.async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
+            }
         }
 
-        m_active_requests.remove(request->request_id);
+        client.m_active_requests.remove(request->request_id);
+    }
+}
+
+void ConnectionFromClient::restart_request_without_validation(ActiveRequest& request)
+{
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "ConnectionFromClient: Stored response for {} disappeared during revalidation, restarting", request.url);
+
+    // NOTE: The validators were added by us, see start_request().
+    HTTP::HeaderMap request_headers;
+    for (auto const& header : request.request_headers.headers()) {
+        if (!header.name.is_one_of_ignoring_ascii_case("If-None-Match"sv, "If-Modified-Since"sv))
+            request_headers.set(header.name, header.value);
+    }
+
+    issue_network_request(request.request_id, move(request.method), move(request.request_url), move(request_headers), move(request.body), {}, move(request.cache_partition_key), {}, UnixDateTime::now(), request.priority, move(request.body_ring), exchange(request.writer_fd, 0));
+}
+
+bool ConnectionFromClient::start_cached_response(i32 request_id, DiskCache::CachedResponse const& cached_response, Optional<Requests::ResponseBodyRing> body_ring)
+{
+    auto body_fd = s_disk_cache->open_body(cached_response.key);
+    if (body_fd.is_error()) {
+        dbgln("StartRequest: Unable to open cached response body: {}", body_fd.error());
+        s_disk_cache->remove_entry(cached_response.key);
+        return false;
+    }
+
+    auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
+    if (fds_or_error.is_error()) {
+        dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
+        MUST(Core::System::close(body_fd.value()));
+        return false;
+    }
+
+    auto fds = fds_or_error.release_value();
+    async_request_started(request_id, IPC::File::adopt_fd(fds[0]));
+    async_headers_became_available(request_id, cached_response.response_headers, cached_response.status_code, cached_response.reason_phrase);
+
+    stream_cached_response(request_id, fds[1], body_fd.value(), move(body_ring));
+    return true;
+}
+
+void ConnectionFromClient::stream_cached_response(i32 request_id, int writer_fd, int body_fd, Optional<Requests::ResponseBodyRing> body_ring)
+{
+    static constexpr size_t CACHED_RESPONSE_CHUNK_SIZE = 64 * KiB;
+
+    auto stream = make<CachedResponseStream>();
+    stream->request_id = request_id;
+    stream->writer_fd = writer_fd;
+    stream->body_fd = body_fd;
+    stream->body_ring = move(body_ring);
+    stream->buffer = MUST(ByteBuffer::create_uninitialized(CACHED_RESPONSE_CHUNK_SIZE));
+
+    stream->notifier = Core::Notifier::construct(writer_fd, Core::NotificationType::Write);
+    stream->notifier->set_enabled(false);
+    stream->notifier->on_activation = [this, stream = stream.ptr()] {
+        stream->notifier->set_enabled(false);
+        pump_cached_response(*stream);
+    };
+
+    auto& stream_reference = *stream;
+    m_cached_response_streams.set(request_id, move(stream));
+    pump_cached_response(stream_reference);
+}
+
+void ConnectionFromClient::pump_cached_response(CachedResponseStream& stream)
+{
+    // NOTE: The client may tell us that it made room in the ring after we've already sent everything.
+    if (stream.is_finished)
+        return;
+
+    auto finish = [&](Optional<Requests::NetworkError> network_error) {
+        stream.is_finished = true;
+
+        Requests::RequestTimingInfo timing_info;
+        timing_info.encoded_body_size = static_cast<long>(stream.bytes_sent);
+        async_request_finished(stream.request_id, stream.bytes_sent, timing_info, network_error);
+
+        // NOTE: We may be running from within the stream's notifier, so destroy it once we're back in the event loop.
+        deferred_invoke([this, request_id = stream.request_id] {
+            m_cached_response_streams.remove(request_id);
+        });
+    };
+
+    while (true) {
+        if (stream.pending_bytes.is_empty()) {
+            auto nread = Core::System::read(stream.body_fd, stream.buffer.bytes());
+            if (nread.is_error()) {
+                dbgln("pump_cached_response: read failed: {}", nread.error());
+                finish(Requests::NetworkError::Unknown);
+                return;
+            }
+            if (nread.value() == 0) {
+                finish({});
+                return;
+            }
+            stream.pending_bytes = stream.buffer.bytes().trim(nread.value());
+        }
+
+        if (stream.body_ring.has_value()) {
+            // The client hasn't caught up with the data we've sent so far, wait until it tells us it made room.
+            if (stream.body_ring->should_wait_for_space(1))
+                return;
+
+            auto nwritten = stream.body_ring->write_some(stream.pending_bytes);
+            ring_response_body_doorbell(*stream.body_ring, stream.writer_fd);
+
+            stream.pending_bytes = stream.pending_bytes.slice(nwritten);
+            stream.bytes_sent += nwritten;
+            continue;
+        }
+
+        auto nwritten = Core::System::write(stream.writer_fd, stream.pending_bytes);
+        if (nwritten.is_error()) {
+            if (nwritten.error().code() == EAGAIN) {
+                // The client hasn't caught up with the data we've sent so far, wait until the pipe has room again.
+                stream.notifier->set_enabled(true);
+                return;
+            }
+            dbgln("pump_cached_response: write failed: {}", nwritten.error());
+            finish(Requests::NetworkError::Unknown);
+            return;
+        }
+
+        stream.pending_bytes = stream.pending_bytes.slice(nwritten.value());
+        stream.bytes_sent += nwritten.value();
     }
 }
 
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(i32 request_id)
 {
+    if (m_cached_response_streams.remove(request_id))
+        return true;
+
     auto request = m_active_requests.take(request_id);
     if (!request.has_value()) {
         dbgln("StopRequest: Request ID {} not found", request_id);
@@ -678,6 +1250,39 @@ Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(
     return true;
 }
 
+void ConnectionFromClient::response_body_ring_has_space(i32 request_id)
+{
+    if (auto stream = m_cached_response_streams.get(request_id); stream.has_value()) {
+        pump_cached_response(**stream);
+        return;
+    }
+
+    auto request = m_active_requests.get(request_id);
+    if (!request.has_value() || !(*request)->is_waiting_for_body_ring_space)
+        return;
+
+    (*request)->is_waiting_for_body_ring_space = false;
+
+    auto result = curl_easy_pause((*request)->easy, CURLPAUSE_CONT);
+    if (result != CURLE_OK)
+        dbgln("ResponseBodyRingHasSpace: Failed to resume request: {}", curl_easy_strerror(result));
+}
+
+void ConnectionFromClient::set_request_priority(i32 request_id, RequestPriority priority)
+{
+    if (!is_valid_request_priority(priority)) {
+        dbgln("SetRequestPriority: Invalid request priority {}", to_underlying(priority));
+        return;
+    }
+
+    auto request = m_active_requests.get(request_id);
+    if (!request.has_value())
+        return;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "SetRequestPriority: Request for {} now has priority {}", (*request)->url, to_underlying(priority));
+    m_connection_pool->set_priority(**request, priority);
+}
+
 Messages::RequestServer::SetCertificateResponse ConnectionFromClient::set_certificate(i32 request_id, ByteString certificate, ByteString key)
 {
     (void)request_id;
@@ -708,20 +1313,27 @@ void ConnectionFromClient::ensure_connection(URL::URL url, ::RequestServer::Cach
 
         auto connect_only_request_id = get_random<i32>();
 
-        auto request = make<ActiveRequest>(*this, m_curl_multi, easy, connect_only_request_id, 0);
+        auto request = make<ActiveRequest>(*this, *m_connection_pool, easy, connect_only_request_id, 0);
         request->url = url_string_value;
         request->is_connect_only = true;
 
         set_option(CURLOPT_PRIVATE, request.ptr());
+
+        // NOTE: curl does not hand connect-only connections to other transfers, but the TLS session negotiated here is
+        //       shared with the pool, so the actual request can resume it. The TLS options must match those of regular
+        //       requests for the session to be reusable.
+        set_option(CURLOPT_SHARE, m_connection_pool->share);
+        if (!g_default_certificate_path.is_empty())
+            set_option(CURLOPT_CAINFO, g_default_certificate_path.characters());
+
         set_option(CURLOPT_URL, url_string_value.to_byte_string().characters());
         set_option(CURLOPT_PORT, url.port_or_default());
         set_option(CURLOPT_CONNECTTIMEOUT, s_connect_timeout_seconds);
         set_option(CURLOPT_CONNECT_ONLY, 1L);
 
-        auto const result = curl_multi_add_handle(m_curl_multi, easy);
-        VERIFY(result == CURLM_OK);
-
+        auto& scheduled_request = *request;
         m_active_requests.set(connect_only_request_id, move(request));
+        m_connection_pool->schedule(scheduled_request);
 
         return;
     }
@@ -766,7 +1378,7 @@ void ConnectionFromClient::websocket_connect(i64 websocket_id, URL::URL url, Byt
             if (!g_default_certificate_path.is_empty())
                 connection_info.set_root_certificates_path(g_default_certificate_path);
 
-            auto impl = WebSocketImplCurl::create(m_curl_multi);
+            auto impl = WebSocketImplCurl::create(m_connection_pool->multi);
             auto connection = WebSocket::WebSocket::create(move(connection_info), move(impl));
 
             connection->on_open = [this, websocket_id]() {
@@ -9,8 +9,12 @@
 #include <AK/HashMap.h>
 #include <LibDNS/Resolver.h>
 #include <LibIPC/ConnectionFromClient.h>
+#include <LibRequests/ResponseBodyRing.h>
 #include <LibWebSocket/WebSocket.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/RequestClientEndpoint.h>
+#include <RequestServer/RequestPriority.h>
+#include <RequestServer/RequestScheduler.h>
 #include <RequestServer/RequestServerEndpoint.h>
 
 namespace RequestServer {
@@ -25,6 +29,8 @@ struct Resolver : public RefCounted<Resolver>
     DNS::Resolver dns;
 };
 
+struct ConnectionPool;
+
 class ConnectionFromClient final
     : public IPC::ConnectionFromClient<RequestClientEndpoint, RequestServerEndpoint> {
     C_OBJECT(ConnectionFromClient);
@@ -34,6 +40,8 @@ public:
 
     virtual void die() override;
 
+    static void set_disk_cache(OwnPtr<DiskCache>);
+
 private:
     explicit ConnectionFromClient(NonnullOwnPtr<IPC::Transport>);
 
@@ -42,8 +50,10 @@ private:
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString) override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls) override;
     virtual void set_use_system_dns() override;
-    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData) override;
+    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString>, RequestPriority, Optional<Core::AnonymousBuffer>) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
+    virtual void set_request_priority(i32, RequestPriority) override;
+    virtual void response_body_ring_has_space(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString, ByteString) override;
     virtual void ensure_connection(URL::URL url, ::RequestServer::CacheLevel cache_level) override;
 
@@ -57,23 +67,60 @@ private:
     struct ActiveRequest;
     friend struct ActiveRequest;
 
+    friend struct ConnectionPool;
+
     static int on_socket_callback(void*, int sockfd, int what, void* user_data, void*);
     static int on_timeout_callback(void*, long timeout_ms, void* user_data);
     static size_t on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data);
     static size_t on_data_received(void* buffer, size_t size, size_t nmemb, void* user_data);
 
+    void issue_network_request(i32 request_id, ByteString method, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString> cache_partition_key, Optional<ByteString> revalidated_cache_key, UnixDateTime request_time, RequestPriority, Optional<Requests::ResponseBodyRing>, Optional<int> writer_fd);
+    void restart_request_without_validation(ActiveRequest&);
+
     HashMap<i32, NonnullOwnPtr<ActiveRequest>> m_active_requests;
 
-    void check_active_requests();
-    void* m_curl_multi { nullptr };
-    RefPtr<Core::Timer> m_timer;
-    HashMap<int, NonnullRefPtr<Core::Notifier>> m_read_notifiers;
-    HashMap<int, NonnullRefPtr<Core::Notifier>> m_write_notifiers;
+    struct CachedResponseStream;
+    bool start_cached_response(i32 request_id, DiskCache::CachedResponse const&, Optional<Requests::ResponseBodyRing>);
+    void stream_cached_response(i32 request_id, int writer_fd, int body_fd, Optional<Requests::ResponseBodyRing>);
+    void pump_cached_response(CachedResponseStream&);
+
+    HashMap<i32, NonnullOwnPtr<CachedResponseStream>> m_cached_response_streams;
+
+    static void check_active_requests(ConnectionPool&);
     NonnullRefPtr<Resolver> m_resolver;
+    NonnullRefPtr<ConnectionPool> m_connection_pool;
 };
 
 // FIXME: Find a good home for this
 ByteString build_curl_resolve_list(DNS::LookupResult const&, StringView host, u16 port);
 constexpr inline uintptr_t websocket_private_tag = 0x1;
 
+// The curl multi handle that performs the transfers of every client. Sharing it lets requests from different
+// WebContent processes reuse each other's connections and HTTP/2 sessions, and lets us enforce per-host connection
+// limits process-wide. It also decides when each request is handed to curl, so that important requests don't have to
+// compete for bandwidth with ones that can wait.
+struct ConnectionPool : public RefCounted<ConnectionPool>
+    , Weakable<ConnectionPool> {
+    ConnectionPool();
+    ~ConnectionPool();
+
+    using ActiveRequest = ConnectionFromClient::ActiveRequest;
+
+    void schedule(ActiveRequest&);
+    void unschedule(ActiveRequest&);
+    void set_priority(ActiveRequest&, RequestPriority);
+
+    void* multi { nullptr };
+    void* share { nullptr };
+    RefPtr<Core::Timer> timer;
+    HashMap<int, NonnullRefPtr<Core::Notifier>> read_notifiers;
+    HashMap<int, NonnullRefPtr<Core::Notifier>> write_notifiers;
+
+    u64 completed_transfer_count { 0 };
+    u64 reused_connection_count { 0 };
+
+private:
+    RequestScheduler<ActiveRequest> m_scheduler;
+};
+
 }
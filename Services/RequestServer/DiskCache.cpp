@@ -0,0 +1,645 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/GenericShorthands.h>
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA1.h>
+#include <LibFileSystem/FileSystem.h>
+#include <RequestServer/DiskCache.h>
+
+namespace RequestServer {
+
+static constexpr u32 INDEX_MAGIC = 0x4C424843; // "LBHC"
+static constexpr u32 INDEX_VERSION = 1;
+
+// Index updates are batched, so that a page load that stores many responses only rewrites the index once.
+static constexpr int INDEX_FLUSH_DELAY_MS = 1000;
+
+// When the cache grows beyond its maximum size, evict down to this fraction of it to avoid evicting on every store.
+static constexpr u64 EVICTION_TARGET_PERCENT = 90;
+
+// A single response may only take up this fraction of the cache, so that storing it never evicts most of the cache.
+static constexpr u64 MAXIMUM_ENTRY_SIZE_PERCENT = 10;
+
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    Optional<i64> max_age;
+};
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+static CacheControl parse_cache_control(HTTP::HeaderMap const& headers)
+{
+    CacheControl cache_control;
+
+    auto value = headers.get("Cache-Control"sv);
+    if (!value.has_value())
+        return cache_control;
+
+    for (auto directive : value->view().split_view(',')) {
+        directive = directive.trim_whitespace();
+
+        auto name = directive;
+        Optional<StringView> argument;
+        if (auto equals = directive.find('='); equals.has_value()) {
+            name = directive.substring_view(0, *equals).trim_whitespace();
+            argument = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+        }
+
+        if (name.equals_ignoring_ascii_case("no-store"sv))
+            cache_control.no_store = true;
+        else if (name.equals_ignoring_ascii_case("no-cache"sv))
+            cache_control.no_cache = true;
+        else if (name.equals_ignoring_ascii_case("max-age"sv) && argument.has_value())
+            cache_control.max_age = argument->to_number<i64>();
+    }
+
+    return cache_control;
+}
+
+// https://httpwg.org/specs/rfc9110.html#http.date
+static Optional<UnixDateTime> parse_http_date(HTTP::HeaderMap const& headers, StringView name)
+{
+    auto value = headers.get(name);
+    if (!value.has_value())
+        return {};
+
+    auto date_time = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, *value);
+    if (!date_time.has_value())
+        return {};
+    return UnixDateTime::from_seconds_since_epoch(date_time->timestamp());
+}
+
+// https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+static bool is_heuristically_cacheable_status(u32 status_code)
+{
+    return first_is_one_of(status_code, 200u, 203u, 204u, 300u, 301u, 308u, 404u, 405u, 410u, 414u, 501u);
+}
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+static AK::Duration freshness_lifetime(HTTP::HeaderMap const& response_headers, UnixDateTime response_time)
+{
+    // If the max-age response directive is present, use its value.
+    if (auto max_age = parse_cache_control(response_headers).max_age; max_age.has_value())
+        return AK::Duration::from_seconds(*max_age);
+
+    auto date = parse_http_date(response_headers, "Date"sv).value_or(response_time);
+
+    // If the Expires response header field is present, use its value minus the value of the Date response header field.
+    if (response_headers.contains("Expires"sv)) {
+        auto expires = parse_http_date(response_headers, "Expires"sv);
+        if (!expires.has_value())
+            return {};
+        return *expires - date;
+    }
+
+    // Otherwise, no explicit expiration time is present in the response. A heuristic freshness lifetime might be
+    // applicable. If the response has a Last-Modified header field, caches are encouraged to use a heuristic expiration
+    // value that is no more than some fraction of the interval since that time. A typical setting of this fraction
+    // might be 10%.
+    if (auto last_modified = parse_http_date(response_headers, "Last-Modified"sv); last_modified.has_value() && *last_modified < date)
+        return AK::Duration::from_seconds((date - *last_modified).to_seconds() / 10);
+
+    return {};
+}
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+static AK::Duration current_age(HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now)
+{
+    auto date_value = parse_http_date(response_headers, "Date"sv).value_or(response_time);
+    auto age_value = AK::Duration::from_seconds(response_headers.get("Age"sv).map([](auto const& age) { return age.view().template to_number<i64>().value_or(0); }).value_or(0));
+
+    auto apparent_age = max(AK::Duration {}, response_time - date_value);
+    auto response_delay = response_time - request_time;
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+
+    auto resident_time = now - response_time;
+    return corrected_initial_age + resident_time;
+}
+
+static bool has_validator(HTTP::HeaderMap const& response_headers)
+{
+    return response_headers.contains("ETag"sv) || response_headers.contains("Last-Modified"sv);
+}
+
+// https://httpwg.org/specs/rfc9111.html#storing.fields
+static bool is_exempted_for_storage(StringView header_name)
+{
+    return header_name.is_one_of_ignoring_ascii_case(
+        "Connection"sv,
+        "Proxy-Connection"sv,
+        "Keep-Alive"sv,
+        "TE"sv,
+        "Transfer-Encoding"sv,
+        "Upgrade"sv,
+        "Set-Cookie"sv);
+}
+
+// https://httpwg.org/specs/rfc9111.html#update
+static bool is_exempted_for_updating(StringView header_name)
+{
+    return is_exempted_for_storage(header_name) || header_name.equals_ignoring_ascii_case("Content-Length"sv);
+}
+
+static HTTP::HeaderMap headers_for_storage(HTTP::HeaderMap const& headers)
+{
+    HTTP::HeaderMap stored_headers;
+    for (auto const& header : headers.headers()) {
+        if (!is_exempted_for_storage(header.name))
+            stored_headers.set(header.name, header.value);
+    }
+    return stored_headers;
+}
+
+// https://httpwg.org/specs/rfc9111.html#caching.negotiated.responses
+static Vector<StringView> vary_header_names(HTTP::HeaderMap const& response_headers)
+{
+    Vector<StringView> names;
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto name : vary->view().split_view(','))
+            names.append(name.trim_whitespace());
+    }
+    return names;
+}
+
+static ByteString cache_key_for(StringView partition_key, URL::URL const& url)
+{
+    // The fragment is never sent to the server, so it must not be part of the cache key.
+    auto url_without_fragment = url;
+    url_without_fragment.set_fragment({});
+    return ByteString::formatted("{} {}", partition_key, url_without_fragment);
+}
+
+static ByteString key_for_cache_key(StringView cache_key)
+{
+    return encode_hex(::Crypto::Hash::SHA1::hash(cache_key).bytes());
+}
+
+ErrorOr<NonnullOwnPtr<DiskCache>> DiskCache::create(LexicalPath directory, u64 maximum_size)
+{
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    auto cache = adopt_own(*new DiskCache(move(directory), maximum_size));
+    if (auto result = cache->read_index(); result.is_error()) {
+        dbgln("DiskCache: Unable to read index, starting with an empty cache: {}", result.error());
+        cache->m_entries.clear();
+        cache->m_total_size = 0;
+    }
+
+    return cache;
+}
+
+DiskCache::DiskCache(LexicalPath directory, u64 maximum_size)
+    : m_directory(move(directory))
+    , m_maximum_size(maximum_size)
+    , m_maximum_entry_size(maximum_size / 100 * MAXIMUM_ENTRY_SIZE_PERCENT)
+{
+    m_index_flush_timer = Core::Timer::create_single_shot(INDEX_FLUSH_DELAY_MS, [this] {
+        flush_index();
+    });
+}
+
+DiskCache::~DiskCache()
+{
+    flush_index();
+}
+
+LexicalPath DiskCache::body_path(ByteString const& key) const
+{
+    return m_directory.append(key);
+}
+
+LexicalPath DiskCache::temporary_body_path(ByteString const& key) const
+{
+    return m_directory.append(ByteString::formatted("{}.{}.tmp", key, m_next_temporary_id));
+}
+
+Optional<DiskCache::CachedResponse> DiskCache::find_response(StringView partition_key, URL::URL const& url, StringView method, HTTP::HeaderMap const& request_headers)
+{
+    // When presented with a request, a cache MUST NOT reuse a stored response unless:
+
+    // - the request method associated with the stored response allows it to be used for the presented request, and
+    //   (NOTE: Only responses to GET requests are stored.)
+    if (method != "GET"sv)
+        return {};
+
+    // - the presented target URI and that of the stored response match, and
+    auto cache_key = cache_key_for(partition_key, url);
+    auto it = m_entries.find(key_for_cache_key(cache_key));
+    if (it == m_entries.end() || it->value.cache_key != cache_key) {
+        dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Miss for {}", url);
+        return {};
+    }
+    auto& entry = it->value;
+
+    // - request header fields nominated by the stored response (if any) match those presented, and
+    for (auto const& header : entry.varying_request_headers.headers()) {
+        if (request_headers.get(header.name).value_or({}) != header.value) {
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Miss for {} (Vary mismatch on {})", url, header.name);
+            return {};
+        }
+    }
+
+    auto response = cached_response_for_entry(entry);
+
+    // - the stored response is one of the following: fresh, allowed to be served stale, or successfully validated.
+    auto now = UnixDateTime::now();
+    auto is_fresh = freshness_lifetime(entry.response_headers, entry.response_time) > current_age(entry.response_headers, entry.request_time, entry.response_time, now);
+
+    // - the stored response does not contain the no-cache directive, unless it is successfully validated, and
+    if (parse_cache_control(entry.response_headers).no_cache)
+        is_fresh = false;
+
+    // A client can also ask for the stored response to be validated, e.g. when reloading a page.
+    auto request_cache_control = parse_cache_control(request_headers);
+    if (request_cache_control.no_cache || request_cache_control.max_age == 0 || request_headers.get("Pragma"sv) == "no-cache"sv)
+        is_fresh = false;
+
+    if (!is_fresh) {
+        if (!has_validator(entry.response_headers)) {
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Miss for {} (stale without a validator)", url);
+            remove_entry(entry.key);
+            return {};
+        }
+        response.freshness = Freshness::NeedsRevalidation;
+    } else {
+        response.freshness = Freshness::Fresh;
+    }
+
+    entry.last_access_time = now;
+    schedule_index_flush();
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: {} for {}", is_fresh ? "Hit"sv : "Revalidating"sv, url);
+    return response;
+}
+
+DiskCache::CachedResponse DiskCache::cached_response_for_entry(Entry const& entry) const
+{
+    return CachedResponse {
+        .key = entry.key,
+        .status_code = entry.status_code,
+        .reason_phrase = entry.reason_phrase,
+        .response_headers = entry.response_headers,
+        .body_size = entry.body_size,
+    };
+}
+
+ErrorOr<int> DiskCache::open_body(ByteString const& key) const
+{
+    return Core::System::open(body_path(key).string(), O_RDONLY | O_CLOEXEC);
+}
+
+bool DiskCache::is_cacheable(StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    // A cache MUST NOT store a response to a request unless:
+
+    // - the request method is understood by the cache;
+    if (method != "GET"sv)
+        return false;
+
+    // - the response status code is final;
+    // - if the response status code is 206 or 304, or the must-understand cache directive is present: the cache
+    //   understands the response status code;
+    //   (NOTE: Partial and conditional responses are passed through without being stored.)
+    if (status_code < 200 || status_code == 206 || status_code == 304)
+        return false;
+
+    // - the no-store cache directive is not present in the response;
+    if (parse_cache_control(response_headers).no_store || parse_cache_control(request_headers).no_store)
+        return false;
+
+    // AD-HOC: Don't store responses to requests carrying credentials that the cache key doesn't account for, or
+    //         responses that vary on every request.
+    if (request_headers.contains("Authorization"sv) || request_headers.contains("Range"sv))
+        return false;
+    if (vary_header_names(response_headers).contains_slow("*"sv))
+        return false;
+
+    // - the response contains at least one of the following:
+    //   + a private response directive, if the cache is not shared;
+    //   + an Expires header field;
+    //   + a max-age response directive;
+    //   + a status code that is defined as heuristically cacheable.
+    // AD-HOC: Responses that would immediately be stale and can't be validated are useless, so they are not stored.
+    auto response_time = UnixDateTime::now();
+    auto has_freshness = freshness_lifetime(response_headers, response_time) > AK::Duration {};
+    if (!has_freshness && !has_validator(response_headers))
+        return false;
+
+    return is_heuristically_cacheable_status(status_code)
+        || response_headers.contains("Expires"sv)
+        || parse_cache_control(response_headers).max_age.has_value();
+}
+
+ErrorOr<NonnullOwnPtr<CacheEntryWriter>> DiskCache::create_entry(StringView partition_key, URL::URL const& url, HTTP::HeaderMap const& request_headers, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap const& response_headers, UnixDateTime request_time)
+{
+    Entry entry;
+    entry.cache_key = cache_key_for(partition_key, url);
+    entry.key = key_for_cache_key(entry.cache_key);
+    entry.status_code = status_code;
+    entry.reason_phrase = move(reason_phrase);
+    entry.response_headers = headers_for_storage(response_headers);
+    entry.request_time = request_time;
+    entry.response_time = UnixDateTime::now();
+    entry.last_access_time = entry.response_time;
+
+    if (auto content_length = response_headers.get("Content-Length"sv).map([](auto const& value) { return value.view().template to_number<u64>(); }); content_length.has_value() && *content_length > m_maximum_entry_size)
+        return Error::from_string_literal("Response is too large to be stored");
+
+    for (auto name : vary_header_names(response_headers))
+        entry.varying_request_headers.set(name, request_headers.get(name).value_or({}));
+
+    auto temporary_path = temporary_body_path(entry.key);
+    ++m_next_temporary_id;
+
+    auto fd = TRY(Core::System::open(temporary_path.string(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600));
+    return adopt_own(*new CacheEntryWriter(*this, move(entry), move(temporary_path), fd));
+}
+
+Optional<DiskCache::CachedResponse> DiskCache::freshen_entry(ByteString const& key, HTTP::HeaderMap const& not_modified_response_headers, UnixDateTime request_time)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return {};
+    auto& entry = it->value;
+
+    // For each stored response identified, the cache MUST update its header fields with the header fields provided in
+    // the 304 (Not Modified) response.
+    HTTP::HeaderMap updated_headers;
+    for (auto const& header : entry.response_headers.headers()) {
+        if (is_exempted_for_updating(header.name) || !not_modified_response_headers.contains(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+    for (auto const& header : not_modified_response_headers.headers()) {
+        if (!is_exempted_for_updating(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+
+    entry.response_headers = move(updated_headers);
+    entry.request_time = request_time;
+    entry.response_time = UnixDateTime::now();
+    entry.last_access_time = entry.response_time;
+    schedule_index_flush();
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Revalidated {}", entry.cache_key);
+
+    auto response = cached_response_for_entry(entry);
+    response.freshness = Freshness::Fresh;
+    return response;
+}
+
+void DiskCache::commit_entry(Entry entry)
+{
+    if (auto existing = m_entries.take(entry.key); existing.has_value())
+        m_total_size -= existing->body_size;
+
+    // NOTE: The writer refuses to write more than this, so this only catches bodies that grew while they were being
+    //       stored, e.g. because the maximum size changed.
+    if (entry.body_size > m_maximum_entry_size) {
+        (void)Core::System::unlink(body_path(entry.key).string());
+        schedule_index_flush();
+        return;
+    }
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Stored {} ({} bytes)", entry.cache_key, entry.body_size);
+
+    auto key = entry.key;
+    m_total_size += entry.body_size;
+    m_entries.set(key, move(entry));
+
+    // NOTE: Never evict the entry that we just stored to make room for itself.
+    evict_entries_if_needed(key);
+    schedule_index_flush();
+}
+
+void DiskCache::remove_entry(ByteString const& key)
+{
+    auto entry = m_entries.take(key);
+    if (!entry.has_value())
+        return;
+
+    m_total_size -= entry->body_size;
+    (void)Core::System::unlink(body_path(key).string());
+    schedule_index_flush();
+}
+
+void DiskCache::evict_entries_if_needed(Optional<ByteString const&> key_to_keep)
+{
+    if (m_total_size <= m_maximum_size)
+        return;
+
+    Vector<Entry const*> entries;
+    entries.ensure_capacity(m_entries.size());
+    for (auto const& it : m_entries)
+        entries.unchecked_append(&it.value);
+    quick_sort(entries, [](auto const* a, auto const* b) { return a->last_access_time < b->last_access_time; });
+
+    auto target_size = m_maximum_size / 100 * EVICTION_TARGET_PERCENT;
+
+    Vector<ByteString> keys_to_evict;
+    auto remaining_size = m_total_size;
+    for (auto const* entry : entries) {
+        if (remaining_size <= target_size)
+            break;
+        if (key_to_keep.has_value() && entry->key == *key_to_keep)
+            continue;
+        remaining_size -= entry->body_size;
+        keys_to_evict.append(entry->key);
+    }
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Evicting {} entries to stay within {} bytes", keys_to_evict.size(), m_maximum_size);
+
+    for (auto const& key : keys_to_evict)
+        remove_entry(key);
+}
+
+void DiskCache::schedule_index_flush()
+{
+    m_index_is_dirty = true;
+    if (!m_index_flush_timer->is_active())
+        m_index_flush_timer->start();
+}
+
+void DiskCache::flush_index()
+{
+    m_index_flush_timer->stop();
+    if (!m_index_is_dirty)
+        return;
+    m_index_is_dirty = false;
+
+    if (auto result = write_index(); result.is_error())
+        dbgln("DiskCache: Unable to write index: {}", result.error());
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<u32>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<ByteString> read_string(Stream& stream)
+{
+    auto length = TRY(stream.read_value<u32>());
+    auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+    TRY(stream.read_until_filled(buffer));
+    return ByteString::copy(buffer);
+}
+
+static ErrorOr<void> write_headers(Stream& stream, HTTP::HeaderMap const& headers)
+{
+    TRY(stream.write_value<u32>(headers.headers().size()));
+    for (auto const& header : headers.headers()) {
+        TRY(write_string(stream, header.name));
+        TRY(write_string(stream, header.value));
+    }
+    return {};
+}
+
+static ErrorOr<HTTP::HeaderMap> read_headers(Stream& stream)
+{
+    HTTP::HeaderMap headers;
+    auto count = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < count; ++i) {
+        auto name = TRY(read_string(stream));
+        auto value = TRY(read_string(stream));
+        headers.set(move(name), move(value));
+    }
+    return headers;
+}
+
+ErrorOr<void> DiskCache::write_index() const
+{
+    AllocatingMemoryStream stream;
+    TRY(stream.write_value<u32>(INDEX_MAGIC));
+    TRY(stream.write_value<u32>(INDEX_VERSION));
+    TRY(stream.write_value<u32>(m_entries.size()));
+
+    for (auto const& [key, entry] : m_entries) {
+        TRY(write_string(stream, entry.cache_key));
+        TRY(stream.write_value<u32>(entry.status_code));
+        TRY(stream.write_value<u8>(entry.reason_phrase.has_value()));
+        if (entry.reason_phrase.has_value())
+            TRY(write_string(stream, *entry.reason_phrase));
+        TRY(write_headers(stream, entry.response_headers));
+        TRY(write_headers(stream, entry.varying_request_headers));
+        TRY(stream.write_value<i64>(entry.request_time.seconds_since_epoch()));
+        TRY(stream.write_value<i64>(entry.response_time.seconds_since_epoch()));
+        TRY(stream.write_value<i64>(entry.last_access_time.seconds_since_epoch()));
+        TRY(stream.write_value<u64>(entry.body_size));
+    }
+
+    auto contents = TRY(stream.read_until_eof());
+
+    // Write the index to a temporary file first, so that a crash while writing can't leave a truncated index behind.
+    auto index_path = m_directory.append("index"sv).string();
+    auto temporary_index_path = m_directory.append("index.tmp"sv).string();
+
+    auto file = TRY(Core::File::open(temporary_index_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600));
+    TRY(file->write_until_depleted(contents));
+    file->close();
+
+    TRY(Core::System::rename(temporary_index_path, index_path));
+    return {};
+}
+
+ErrorOr<void> DiskCache::read_index()
+{
+    auto index_path = m_directory.append("index"sv).string();
+    if (!FileSystem::exists(index_path))
+        return {};
+
+    auto file = TRY(Core::File::open(index_path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    FixedMemoryStream stream { contents.bytes() };
+
+    if (TRY(stream.read_value<u32>()) != INDEX_MAGIC)
+        return Error::from_string_literal("Invalid index file");
+    if (TRY(stream.read_value<u32>()) != INDEX_VERSION)
+        return Error::from_string_literal("Unsupported index version");
+
+    auto count = TRY(stream.read_value<u32>());
+    for (u32 i = 0; i < count; ++i) {
+        Entry entry;
+        entry.cache_key = TRY(read_string(stream));
+        entry.key = key_for_cache_key(entry.cache_key);
+        entry.status_code = TRY(stream.read_value<u32>());
+        if (TRY(stream.read_value<u8>()) != 0)
+            entry.reason_phrase = TRY(String::from_byte_string(TRY(read_string(stream))));
+        entry.response_headers = TRY(read_headers(stream));
+        entry.varying_request_headers = TRY(read_headers(stream));
+        entry.request_time = UnixDateTime::from_seconds_since_epoch(TRY(stream.read_value<i64>()));
+        entry.response_time = UnixDateTime::from_seconds_since_epoch(TRY(stream.read_value<i64>()));
+        entry.last_access_time = UnixDateTime::from_seconds_since_epoch(TRY(stream.read_value<i64>()));
+        entry.body_size = TRY(stream.read_value<u64>());
+
+        // Skip entries whose body has gone missing since the index was written.
+        if (!FileSystem::exists(body_path(entry.key).string()))
+            continue;
+
+        m_total_size += entry.body_size;
+        m_entries.set(entry.key, move(entry));
+    }
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "DiskCache: Loaded {} entries ({} bytes) from {}", m_entries.size(), m_total_size, m_directory);
+    evict_entries_if_needed();
+    return {};
+}
+
+CacheEntryWriter::CacheEntryWriter(DiskCache& cache, DiskCache::Entry entry, LexicalPath temporary_path, int fd)
+    : m_cache(cache)
+    , m_entry(move(entry))
+    , m_temporary_path(move(temporary_path))
+    , m_fd(fd)
+{
+}
+
+CacheEntryWriter::~CacheEntryWriter()
+{
+    if (m_fd >= 0)
+        (void)Core::System::close(m_fd);
+    if (!m_committed)
+        (void)Core::System::unlink(m_temporary_path.string());
+}
+
+ErrorOr<void> CacheEntryWriter::write(ReadonlyBytes bytes)
+{
+    if (m_entry.body_size + bytes.size() > m_cache.m_maximum_entry_size)
+        return Error::from_string_literal("Response is too large to be stored");
+
+    m_entry.body_size += bytes.size();
+    while (!bytes.is_empty()) {
+        auto nwritten = TRY(Core::System::write(m_fd, bytes));
+        bytes = bytes.slice(nwritten);
+    }
+    return {};
+}
+
+void CacheEntryWriter::commit()
+{
+    VERIFY(!m_committed);
+
+    (void)Core::System::close(m_fd);
+    m_fd = -1;
+
+    if (auto result = Core::System::rename(m_temporary_path.string(), m_cache.body_path(m_entry.key).string()); result.is_error()) {
+        dbgln("DiskCache: Unable to store {}: {}", m_entry.cache_key, result.error());
+        return;
+    }
+
+    m_committed = true;
+    m_cache.commit_entry(move(m_entry));
+}
+
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/LexicalPath.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <LibCore/Timer.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+class CacheEntryWriter;
+
+// A private HTTP cache (https://httpwg.org/specs/rfc9111.html) shared by every client of this RequestServer, and thus
+// by all tabs. Entries are partitioned by the network partition key of the request that stored them. Each response
+// body is stored in its own file, while response metadata lives in an index that is written back to disk shortly
+// after it changes, so the cache survives restarts. The total size of the stored bodies is bounded, and the least
+// recently used entries are evicted first. Responses that would take up more than a tenth of the cache aren't stored.
+class DiskCache {
+public:
+    static ErrorOr<NonnullOwnPtr<DiskCache>> create(LexicalPath directory, u64 maximum_size);
+    ~DiskCache();
+
+    enum class Freshness {
+        Fresh,
+        NeedsRevalidation,
+    };
+
+    struct CachedResponse {
+        ByteString key;
+        u32 status_code { 0 };
+        Optional<String> reason_phrase;
+        HTTP::HeaderMap response_headers;
+        u64 body_size { 0 };
+        Freshness freshness { Freshness::NeedsRevalidation };
+    };
+
+    // https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+    Optional<CachedResponse> find_response(StringView partition_key, URL::URL const&, StringView method, HTTP::HeaderMap const& request_headers);
+
+    ErrorOr<int> open_body(ByteString const& key) const;
+
+    // https://httpwg.org/specs/rfc9111.html#response.cacheability
+    static bool is_cacheable(StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers);
+
+    ErrorOr<NonnullOwnPtr<CacheEntryWriter>> create_entry(StringView partition_key, URL::URL const&, HTTP::HeaderMap const& request_headers, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap const& response_headers, UnixDateTime request_time);
+
+    // https://httpwg.org/specs/rfc9111.html#freshening.responses
+    Optional<CachedResponse> freshen_entry(ByteString const& key, HTTP::HeaderMap const& not_modified_response_headers, UnixDateTime request_time);
+
+    void remove_entry(ByteString const& key);
+
+    void flush_index();
+
+private:
+    friend class CacheEntryWriter;
+
+    struct Entry {
+        ByteString key;
+        ByteString cache_key;
+        u32 status_code { 0 };
+        Optional<String> reason_phrase;
+        HTTP::HeaderMap response_headers;
+        HTTP::HeaderMap varying_request_headers;
+        UnixDateTime request_time;
+        UnixDateTime response_time;
+        UnixDateTime last_access_time;
+        u64 body_size { 0 };
+    };
+
+    DiskCache(LexicalPath directory, u64 maximum_size);
+
+    ErrorOr<void> read_index();
+    ErrorOr<void> write_index() const;
+    void schedule_index_flush();
+
+    LexicalPath body_path(ByteString const& key) const;
+    LexicalPath temporary_body_path(ByteString const& key) const;
+
+    void commit_entry(Entry);
+    void evict_entries_if_needed(Optional<ByteString const&> key_to_keep = {});
+
+    CachedResponse cached_response_for_entry(Entry const&) const;
+
+    LexicalPath m_directory;
+    u64 m_maximum_size { 0 };
+    u64 m_maximum_entry_size { 0 };
+    u64 m_total_size { 0 };
+    u64 m_next_temporary_id { 0 };
+    HashMap<ByteString, Entry> m_entries;
+    RefPtr<Core::Timer> m_index_flush_timer;
+    bool m_index_is_dirty { false };
+};
+
+// Streams a response body into a temporary file while it is being downloaded. The entry only becomes visible in the
+// cache once the download completes successfully and commit() is called; otherwise the file is discarded.
+class CacheEntryWriter {
+public:
+    ~CacheEntryWriter();
+
+    ErrorOr<void> write(ReadonlyBytes);
+    void commit();
+
+private:
+    friend class DiskCache;
+
+    CacheEntryWriter(DiskCache&, DiskCache::Entry, LexicalPath temporary_path, int fd);
+
+    DiskCache& m_cache;
+    DiskCache::Entry m_entry;
+    LexicalPath m_temporary_path;
+    int m_fd { -1 };
+    bool m_committed { false };
+};
+
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace RequestServer {
+
+// How urgently a request's response is needed. RequestServer holds back low priority requests while more important
+// ones are in flight, and forwards the priority to the server where the protocol allows it.
+enum class RequestPriority : u8 {
+    VeryLow,
+    Low,
+    Medium,
+    High,
+    VeryHigh,
+};
+
+// NOTE: Priorities arrive over IPC, where any value of the underlying type can be sent.
+constexpr bool is_valid_request_priority(RequestPriority priority)
+{
+    return to_underlying(priority) <= to_underlying(RequestPriority::VeryHigh);
+}
+
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Vector.h>
+#include <RequestServer/RequestPriority.h>
+
+namespace RequestServer {
+
+// Decides when a request is handed to the network. Medium and higher priority requests always start right away. While
+// high priority requests are in flight, only a few low priority ones may compete with them for bandwidth; the rest are
+// deferred, and started most important first once that is allowed again.
+//
+// The Request type needs to have a `priority` and an `is_in_flight` member, both of which are managed by the scheduler.
+template<typename Request>
+class RequestScheduler {
+public:
+    static constexpr size_t max_low_priority_requests_while_high_priority_in_flight = 2;
+
+    RequestScheduler(Function<void(Request&)> start_request, Function<void(Request&)> stop_request)
+        : m_start_request(move(start_request))
+        , m_stop_request(move(stop_request))
+    {
+    }
+
+    void schedule(Request& request)
+    {
+        if (should_defer(request.priority)) {
+            m_deferred_requests.append(&request);
+            return;
+        }
+
+        start(request);
+    }
+
+    void unschedule(Request& request)
+    {
+        if (!request.is_in_flight) {
+            m_deferred_requests.remove_first_matching([&](auto* deferred_request) { return deferred_request == &request; });
+            return;
+        }
+
+        request.is_in_flight = false;
+        update_in_flight_counts(request.priority, -1);
+        m_stop_request(request);
+
+        start_deferred_requests();
+    }
+
+    void set_priority(Request& request, RequestPriority priority)
+    {
+        if (request.priority == priority)
+            return;
+
+        if (request.is_in_flight) {
+            update_in_flight_counts(request.priority, -1);
+            update_in_flight_counts(priority, 1);
+        }
+        request.priority = priority;
+
+        start_deferred_requests();
+    }
+
+    bool is_deferred(Request const& request) const
+    {
+        return m_deferred_requests.first_matching([&](auto* deferred_request) { return deferred_request == &request; }).has_value();
+    }
+
+    size_t deferred_request_count() const { return m_deferred_requests.size(); }
+
+private:
+    bool should_defer(RequestPriority priority) const
+    {
+        if (priority >= RequestPriority::Medium)
+            return false;
+        return m_in_flight_high_priority_count > 0
+            && m_in_flight_low_priority_count >= max_low_priority_requests_while_high_priority_in_flight;
+    }
+
+    void start(Request& request)
+    {
+        VERIFY(!request.is_in_flight);
+        request.is_in_flight = true;
+        update_in_flight_counts(request.priority, 1);
+
+        m_start_request(request);
+    }
+
+    void start_deferred_requests()
+    {
+        while (!m_deferred_requests.is_empty()) {
+            // Start the most important deferred request first, in the order they were made.
+            size_t next_index = 0;
+            for (size_t i = 1; i < m_deferred_requests.size(); ++i) {
+                if (m_deferred_requests[i]->priority > m_deferred_requests[next_index]->priority)
+                    next_index = i;
+            }
+
+            if (should_defer(m_deferred_requests[next_index]->priority))
+                return;
+
+            start(*m_deferred_requests.take(next_index));
+        }
+    }
+
+    void update_in_flight_counts(RequestPriority priority, int delta)
+    {
+        if (priority >= RequestPriority::High)
+            m_in_flight_high_priority_count += delta;
+        else if (priority <= RequestPriority::Low)
+            m_in_flight_low_priority_count += delta;
+    }
+
+    Function<void(Request&)> m_start_request;
+    Function<void(Request&)> m_stop_request;
+
+    Vector<Request*> m_deferred_requests;
+    size_t m_in_flight_high_priority_count { 0 };
+    size_t m_in_flight_low_priority_count { 0 };
+};
+
+}
@@ -11,12 +11,14 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/TLSv12.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 
 #if defined(AK_OS_MACOS)
 #    include <LibCore/Platform/ProcessStatisticsMach.h>
@@ -44,12 +46,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     StringView mach_server_name;
     bool wait_for_debugger = false;
+    bool enable_http_disk_cache = false;
+    u64 http_disk_cache_size_in_mib = 256;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(serenity_resource_root, "Absolute path to directory for serenity resources", "serenity-resource-root", 'r', "serenity-resource-root");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
+    args_parser.add_option(enable_http_disk_cache, "Enable the HTTP disk cache", "enable-http-disk-cache");
+    args_parser.add_option(http_disk_cache_size_in_mib, "Maximum size of the HTTP disk cache in MiB", "http-disk-cache-size", 0, "size");
     args_parser.parse(arguments);
 
     if (wait_for_debugger)
@@ -63,6 +69,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Core::EventLoop event_loop;
 
+    if (enable_http_disk_cache) {
+        auto cache_directory = LexicalPath::join(Core::StandardPaths::user_data_directory(), "Ladybird"sv, "HTTPCache"sv);
+
+        if (auto disk_cache = RequestServer::DiskCache::create(move(cache_directory), http_disk_cache_size_in_mib * MiB); disk_cache.is_error())
+            warnln("Unable to create HTTP disk cache: {}", disk_cache.error());
+        else
+            RequestServer::ConnectionFromClient::set_disk_cache(disk_cache.release_value());
+    }
+
 #if defined(AK_OS_MACOS)
     if (!mach_server_name.is_empty())
         Core::Platform::register_with_mach_server(mach_server_name);
@@ -70,5 +85,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<RequestServer::ConnectionFromClient>());
 
-    return event_loop.exec();
+    auto exit_code = event_loop.exec();
+
+    // Make sure the disk cache index is written out while the event loop still exists.
+    RequestServer::ConnectionFromClient::set_disk_cache(nullptr);
+
+    return exit_code;
 }
@@ -22,6 +22,7 @@
 #include <LibWeb/ARIA/RoleType.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/ComputedProperties.h>
+#include <LibWeb/CSS/Parser/Tokenizer.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/CharacterData.h>
@@ -32,6 +33,7 @@
 #include <LibWeb/DOM/Text.h>
 #include <LibWeb/Dump.h>
 #include <LibWeb/HTML/BrowsingContext.h>
+#include <LibWeb/HTML/DecodedImageCache.h>
 #include <LibWeb/HTML/HTMLInputElement.h>
 #include <LibWeb/HTML/SelectedFile.h>
 #include <LibWeb/HTML/Storage.h>
@@ -259,6 +261,12 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "dump-dom-memory-usage") {
+        if (auto* doc = page->page().top_level_browsing_context().active_document())
+            Web::dump_dom_memory_usage(*doc);
+        return;
+    }
+
     if (request == "dump-layout-tree") {
         if (auto* doc = page->page().top_level_browsing_context().active_document()) {
             if (auto* viewport = doc->layout_node())
@@ -341,6 +349,7 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
 
     if (request == "clear-cache") {
         Web::ResourceLoader::the().clear_cache();
+        Web::CSS::Parser::Tokenizer::clear_style_sheet_token_cache();
         return;
     }
 
@@ -370,6 +379,17 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "dump-ipc-statistics") {
+        dump_statistics();
+        Web::ResourceLoader::the().request_client().dump_statistics();
+        return;
+    }
+
+    if (request == "dump-decoded-image-cache-statistics") {
+        Web::HTML::DecodedImageCache::the().dump_statistics();
+        return;
+    }
+
     if (request == "load-reference-page") {
         if (auto* document = page->page().top_level_browsing_context().active_document()) {
             auto has_mismatch_selector = false;
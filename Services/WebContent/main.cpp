@@ -19,6 +19,7 @@
 #include <LibMedia/Audio/Loader.h>
 #include <LibRequests/RequestClient.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/HTML/DecodedImageCache.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/Internals.h>
 #include <LibWeb/Loader/ContentFilter.h>
@@ -113,6 +114,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool collect_garbage_on_every_allocation = false;
     bool is_headless = false;
     bool disable_scrollbar_painting = false;
+    u64 decoded_image_cache_size_in_mib = Web::HTML::DecodedImageCache::default_budget / MiB;
     StringView echo_server_port_string_view {};
 
     Core::ArgsParser args_parser;
@@ -134,6 +136,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical viewport scrollbars", "disable-scrollbar-painting");
+    args_parser.add_option(decoded_image_cache_size_in_mib, "Maximum size of decoded image data in MiB", "decoded-image-cache-size", 0, "size");
     args_parser.add_option(echo_server_port_string_view, "Echo server port used in test internals", "echo-server-port", 0, "echo_server_port");
     args_parser.add_option(is_headless, "Report that the browser is running in headless mode", "headless");
 
@@ -172,6 +175,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Web::Painting::g_paint_viewport_scrollbars = !disable_scrollbar_painting;
 
+    Web::HTML::DecodedImageCache::the().set_budget(decoded_image_cache_size_in_mib * MiB);
+
     if (!echo_server_port_string_view.is_empty()) {
         if (auto maybe_echo_server_port = echo_server_port_string_view.to_number<u16>(); maybe_echo_server_port.has_value())
             Web::Internals::Internals::set_echo_server_port(maybe_echo_server_port.value());
@@ -38,3 +38,29 @@ BENCHMARK_CASE(several_scans)
     auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(several_scans));
     MUST(plugin_decoder->frame(0));
 }
+
+// A photo gallery shows many photos as thumbnails, which lets them be decoded at a reduced size.
+static constexpr size_t photo_gallery_photo_count = 50;
+static constexpr Gfx::IntSize photo_gallery_thumbnail_size { 100, 100 };
+
+static size_t decode_photo_gallery(Optional<Gfx::IntSize> ideal_size)
+{
+    size_t decoded_size_in_bytes = 0;
+    for (size_t i = 0; i < photo_gallery_photo_count; ++i) {
+        auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(rgb_image));
+        auto frame = MUST(plugin_decoder->frame(0, ideal_size));
+        decoded_size_in_bytes += frame.image->data_size();
+    }
+    return decoded_size_in_bytes;
+}
+
+BENCHMARK_CASE(photo_gallery_at_full_size)
+{
+    EXPECT_EQ(decode_photo_gallery({}), photo_gallery_photo_count * 592 * 800 * sizeof(u32));
+}
+
+BENCHMARK_CASE(photo_gallery_at_thumbnail_size)
+{
+    // The 592x800 photos are decoded at a quarter of their size, which takes a sixteenth of the memory.
+    EXPECT_EQ(decode_photo_gallery(photo_gallery_thumbnail_size), photo_gallery_photo_count * 148 * 200 * sizeof(u32));
+}
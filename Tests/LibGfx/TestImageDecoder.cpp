@@ -44,6 +44,38 @@ static ErrorOr<Gfx::ImageFrameDescriptor> expect_single_frame_of_size(Gfx::Image
     return frame;
 }
 
+// Feeds the data in small chunks, and expects the end result to be the same as decoding all of it at once.
+static void expect_progressive_decode_to_match(ReadonlyBytes bytes, Gfx::Bitmap const& expected_bitmap)
+{
+    static constexpr size_t chunk_size = 100;
+
+    auto decoder = TRY_OR_FAIL(Gfx::ProgressiveImageDecoder::try_create_for_data_prefix(bytes));
+    VERIFY(decoder);
+
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size) {
+        TRY_OR_FAIL(decoder->append(bytes.slice(offset, min(chunk_size, bytes.size() - offset))));
+
+        // The size of the image is known long before all of its data is there.
+        if (offset >= bytes.size() / 2) {
+            auto bitmap = decoder->bitmap();
+            VERIFY(bitmap);
+            EXPECT_EQ(bitmap->size(), expected_bitmap.size());
+        }
+    }
+
+    auto bitmap = decoder->bitmap();
+    VERIFY(bitmap);
+    EXPECT_EQ(bitmap->size(), expected_bitmap.size());
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x) {
+            if (bitmap->get_pixel(x, y) != expected_bitmap.get_pixel(x, y)) {
+                FAIL(ByteString::formatted("Pixel ({}, {}) differs", x, y));
+                return;
+            }
+        }
+    }
+}
+
 TEST_CASE(test_bmp)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("bmp/rgba32-1.bmp"sv)));
@@ -143,6 +175,9 @@ TEST_CASE(test_gif)
     EXPECT(plugin_decoder->is_animated());
     EXPECT(!plugin_decoder->loop_count());
 
+    // The duration is known before the frame is decoded.
+    EXPECT_EQ(plugin_decoder->frame_duration(1), 400);
+
     auto frame = TRY_OR_FAIL(plugin_decoder->frame(1));
     EXPECT(frame.duration == 400);
 }
@@ -292,6 +327,54 @@ TEST_CASE(test_jpeg_rgb_components)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 592, 800 }));
 }
 
+TEST_CASE(test_jpeg_decode_to_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb_components.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    // An ideal size that's much smaller than the image makes the decoder scale it down while decoding it.
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 100, 100 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(148, 200));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(592, 800));
+
+    // One that's only a bit smaller doesn't.
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 400, 400 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+}
+
+TEST_CASE(test_jpeg_size_is_read_from_header)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb_components.jpg"sv)));
+
+    // Cut the image off right after its start of scan marker, leaving nothing but the header.
+    auto bytes = file->bytes();
+    size_t header_size = 0;
+    for (size_t i = 2; i + 3 < bytes.size(); ++i) {
+        if (bytes[i] == 0xFF && bytes[i + 1] == 0xDA) {
+            header_size = i + 2 + ((bytes[i + 2] << 8) | bytes[i + 3]);
+            break;
+        }
+    }
+    VERIFY(header_size > 0);
+
+    // Asking for the size and color profile first must not decode the image, which would fail for a header on its own.
+    auto header_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(bytes.trim(header_size)));
+    EXPECT_EQ(header_decoder->size(), Gfx::IntSize(592, 800));
+    EXPECT(!TRY_OR_FAIL(header_decoder->icc_data()).has_value());
+    EXPECT_EQ(header_decoder->natural_frame_format(), Gfx::NaturalFrameFormat::RGB);
+
+    // So the image is only decoded once, at the ideal size.
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(bytes));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(592, 800));
+    (void)TRY_OR_FAIL(plugin_decoder->icc_data());
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 100, 100 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(148, 200));
+    EXPECT_EQ(TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 100, 100 })).image, frame.image);
+}
+
 TEST_CASE(test_jpeg_ycck)
 {
     Array test_inputs = {
@@ -396,6 +479,23 @@ TEST_CASE(test_jpeg_malformed_frame)
     }
 }
 
+TEST_CASE(test_jpeg_progressive_decode)
+{
+    Array test_inputs = {
+        TEST_INPUT("jpg/rgb24.jpg"sv),
+        TEST_INPUT("jpg/odd-restart.jpg"sv),
+        TEST_INPUT("jpg/successive_approximation.jpg"sv),
+    };
+
+    for (auto test_input : test_inputs) {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(test_input));
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
+
+        expect_progressive_decode_to_match(file->bytes(), *frame.image);
+    }
+}
+
 TEST_CASE(test_png)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
@@ -470,6 +570,15 @@ TEST_CASE(test_png_malformed_frame)
     }
 }
 
+TEST_CASE(test_png_progressive_decode)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto frame = TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
+
+    expect_progressive_decode_to_match(file->bytes(), *frame.image);
+}
+
 TEST_CASE(test_tiff_uncompressed)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("tiff/uncompressed.tiff"sv)));
@@ -594,6 +703,25 @@ TEST_CASE(test_tiff_deflate)
     EXPECT_EQ(frame.image->get_pixel(60, 75), Gfx::Color::NamedColor::Red);
 }
 
+TEST_CASE(test_tiff_parallel_decoding)
+{
+    // NOTE: These images are large enough and have enough strips or tiles to be decoded in parallel.
+    auto decode = [](StringView path) -> ErrorOr<Gfx::ImageFrameDescriptor> {
+        auto file = TRY(Core::MappedFile::map(path));
+        auto plugin_decoder = TRY(Gfx::TIFFImageDecoderPlugin::create(file->bytes()));
+        return expect_single_frame_of_size(*plugin_decoder, { 400, 300 });
+    };
+
+    auto uncompressed = TRY_OR_FAIL(decode(TEST_INPUT("tiff/uncompressed.tiff"sv)));
+    for (auto path : { TEST_INPUT("tiff/deflate.tiff"sv), TEST_INPUT("tiff/tiled.tiff"sv) }) {
+        auto frame = TRY_OR_FAIL(decode(path));
+        for (int y = 0; y < 300; ++y) {
+            for (int x = 0; x < 400; ++x)
+                EXPECT_EQ(frame.image->get_pixel(x, y), uncompressed.image->get_pixel(x, y));
+        }
+    }
+}
+
 TEST_CASE(test_tiff_krita)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("tiff/krita.tif"sv)));
@@ -1028,6 +1156,21 @@ TEST_CASE(test_webp_extended_lossless_animated)
     }
 }
 
+TEST_CASE(test_webp_extended_lossless_animated_out_of_order)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/extended-lossless-animated.webp"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::WebPImageDecoderPlugin::create(file->bytes()));
+
+    // Frames are decoded as they are asked for, so going back has to start over from the first frame.
+    for (size_t frame_index : { 6u, 2u, 3u, 2u, 7u, 0u }) {
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(frame_index));
+        EXPECT_EQ(frame.image->get_pixel(500, 700), Gfx::Color::Yellow);
+        EXPECT_EQ(frame.image->get_pixel(500, 0), (frame_index == 2 || frame_index == 6) ? Gfx::Color::Black : Gfx::Color(0, 0, 0, 0));
+    }
+
+    EXPECT(plugin_decoder->frame(8).is_error());
+}
+
 TEST_CASE(test_webp_unpremultiplied_alpha)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/semi-transparent-pixel.webp"sv)));
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/BackgroundAction.h>
+#include <LibThreading/ParallelFor.h>
+#include <LibThreading/Thread.h>
+#include <sched.h>
+
+TEST_CASE(every_index_is_visited_once)
+{
+    static constexpr size_t count = 1000;
+
+    Array<Atomic<u32>, count> visits;
+
+    TRY_OR_FAIL(Threading::parallel_for(count, 4, [&](size_t index) -> ErrorOr<void> {
+        visits[index].fetch_add(1);
+        return {};
+    }));
+
+    for (auto const& visit_count : visits)
+        EXPECT_EQ(visit_count.load(), 1u);
+}
+
+TEST_CASE(nothing_to_do)
+{
+    TRY_OR_FAIL(Threading::parallel_for(0, 4, [](size_t) -> ErrorOr<void> {
+        FAIL("Callback should not be called");
+        return {};
+    }));
+}
+
+TEST_CASE(single_thread_runs_on_calling_thread)
+{
+    auto calling_thread = pthread_self();
+
+    TRY_OR_FAIL(Threading::parallel_for(10, 1, [&](size_t) -> ErrorOr<void> {
+        EXPECT(pthread_equal(pthread_self(), calling_thread));
+        return {};
+    }));
+}
+
+TEST_CASE(error_is_returned)
+{
+    auto result = Threading::parallel_for(1000, 4, [&](size_t index) -> ErrorOr<void> {
+        if (index == 10)
+            return Error::from_errno(EINVAL);
+        return {};
+    });
+
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EINVAL);
+}
+
+TEST_CASE(busy_background_threads_are_not_waited_for)
+{
+    static constexpr size_t count = 100;
+
+    // NOTE: There is a single background thread by default, and it is the one calling parallel_for() here. So the helper
+    //       it enqueues can't start until the call has returned, and must not be waited for.
+    Atomic<size_t> visit_count { 0 };
+    Atomic<bool> is_done { false };
+
+    Threading::run_on_background_thread([&] {
+        MUST(Threading::parallel_for(count, 4, [&](size_t) -> ErrorOr<void> {
+            visit_count.fetch_add(1);
+            return {};
+        }));
+        is_done.store(true);
+    });
+
+    while (!is_done.load())
+        sched_yield();
+
+    EXPECT_EQ(visit_count.load(), count);
+}
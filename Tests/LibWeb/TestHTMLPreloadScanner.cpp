@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibURL/Parser.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+
+static Web::HTML::HTMLPreloadScanner make_scanner(bool scripting_enabled = true)
+{
+    return { URL::Parser::basic_parse("https://example.com/dir/page.html"sv).release_value(), "UTF-8"_string, scripting_enabled };
+}
+
+static Vector<String> serialize(Vector<Web::HTML::PreloadRequest> const& requests)
+{
+    Vector<String> serialized_urls;
+    for (auto const& request : requests)
+        serialized_urls.append(request.url.serialize());
+    return serialized_urls;
+}
+
+static Vector<String> scan(StringView input, bool scripting_enabled = true)
+{
+    auto scanner = make_scanner(scripting_enabled);
+    scanner.set_input(input);
+    return serialize(scanner.scan());
+}
+
+TEST_CASE(subresources)
+{
+    auto urls = scan(R"(
+        <link rel="stylesheet" href="style.css">
+        <link rel="icon" href="favicon.ico">
+        <script src="/app.js"></script>
+        <img src="https://cdn.example.net/a.png" srcset="b.png 2x">
+    )"sv);
+
+    EXPECT_EQ(urls.size(), 3u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/style.css"sv);
+    EXPECT_EQ(urls[1], "https://example.com/app.js"sv);
+    EXPECT_EQ(urls[2], "https://cdn.example.net/a.png"sv);
+}
+
+TEST_CASE(single_image_source_is_selected)
+{
+    auto urls = scan(R"(
+        <img src="a.png" srcset="a-2x.png 2x, a-3x.png 3x">
+        <img srcset="b-3x.png 3x, b-2x.png 2x, b-half.png 0.5x">
+        <img src="c.png" srcset="c-1x.png, c-2x.png 2x">
+        <img src="d.png" srcset="d-400.png 400w, d-800.png 800w" sizes="50vw">
+        <img srcset="">
+    )"sv);
+
+    // NOTE: Images with width descriptors are left to the img element, since their sizes depend on layout.
+    EXPECT_EQ(urls.size(), 3u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/a.png"sv);
+    EXPECT_EQ(urls[1], "https://example.com/dir/b-2x.png"sv);
+    EXPECT_EQ(urls[2], "https://example.com/dir/c-1x.png"sv);
+}
+
+TEST_CASE(base_element)
+{
+    auto urls = scan(R"(<base href="https://static.example.org/"><base href="/ignored/"><script src="x.js"></script>)"sv);
+
+    EXPECT_EQ(urls.size(), 1u);
+    EXPECT_EQ(urls[0], "https://static.example.org/x.js"sv);
+}
+
+TEST_CASE(markup_in_raw_text_is_ignored)
+{
+    auto urls = scan(R"(
+        <script>document.write('<img src="a.png">');</script>
+        <textarea><img src="b.png"></textarea>
+        <style>/* <img src="c.png"> */</style>
+        <img src="d.png">
+    )"sv);
+
+    EXPECT_EQ(urls.size(), 1u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/d.png"sv);
+}
+
+TEST_CASE(requests_match_the_fetches_of_their_elements)
+{
+    using Web::Fetch::Infrastructure::Request;
+
+    auto scanner = make_scanner();
+    scanner.set_input(R"(
+        <img src="a.png">
+        <img src="b.png" crossorigin>
+        <link rel="stylesheet" href="c.css" crossorigin="use-credentials">
+        <script type="module" src="d.js"></script>
+        <link rel="modulepreload" href="e.js" crossorigin="use-credentials">
+        <script nomodule src="legacy.js"></script>
+        <script type="text/template" src="template.html"></script>
+        <script language="javascript" src="f.js"></script>
+    )"sv);
+    auto requests = scanner.scan();
+
+    EXPECT_EQ(requests.size(), 6u);
+    EXPECT_EQ(serialize(requests), (Vector<String> {
+                                       "https://example.com/dir/a.png"_string,
+                                       "https://example.com/dir/b.png"_string,
+                                       "https://example.com/dir/c.css"_string,
+                                       "https://example.com/dir/d.js"_string,
+                                       "https://example.com/dir/e.js"_string,
+                                       "https://example.com/dir/f.js"_string,
+                                   }));
+
+    EXPECT_EQ(requests[0].mode, Request::Mode::NoCORS);
+    EXPECT_EQ(requests[0].credentials_mode, Request::CredentialsMode::Include);
+    EXPECT_EQ(requests[1].mode, Request::Mode::CORS);
+    EXPECT_EQ(requests[1].credentials_mode, Request::CredentialsMode::SameOrigin);
+    EXPECT_EQ(requests[2].mode, Request::Mode::CORS);
+    EXPECT_EQ(requests[2].credentials_mode, Request::CredentialsMode::Include);
+    EXPECT_EQ(requests[3].mode, Request::Mode::CORS);
+    EXPECT_EQ(requests[3].credentials_mode, Request::CredentialsMode::SameOrigin);
+    EXPECT_EQ(requests[4].mode, Request::Mode::CORS);
+    EXPECT_EQ(requests[4].credentials_mode, Request::CredentialsMode::Include);
+    EXPECT_EQ(requests[5].mode, Request::Mode::NoCORS);
+}
+
+TEST_CASE(noscript_contents_are_only_scanned_without_scripting)
+{
+    auto input = R"(<noscript><img src="fallback.png"></noscript><img src="a.png">)"sv;
+
+    auto urls = scan(input);
+    EXPECT_EQ(urls.size(), 1u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/a.png"sv);
+
+    urls = scan(input, false);
+    EXPECT_EQ(urls.size(), 2u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/fallback.png"sv);
+    EXPECT_EQ(urls[1], "https://example.com/dir/a.png"sv);
+}
+
+TEST_CASE(lazy_images_are_not_preloaded)
+{
+    auto input = R"(<img src="a.png" loading="LAZY"><img src="b.png" loading="eager">)"sv;
+
+    auto urls = scan(input);
+    EXPECT_EQ(urls.size(), 1u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/b.png"sv);
+
+    // NOTE: Without scripting, images are never loaded lazily.
+    urls = scan(input, false);
+    EXPECT_EQ(urls.size(), 2u);
+}
+
+TEST_CASE(scanning_continues_where_it_stopped)
+{
+    auto scanner = make_scanner();
+    scanner.set_input(R"(<script src="a.js"></script><img src="b.png"><style>/* <img src="c.png"> */</style><img src="d.png">)"sv);
+
+    // NOTE: Scanning stops at the first token boundary after the given number of code points.
+    auto urls = serialize(scanner.scan(1));
+    EXPECT_EQ(urls.size(), 1u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/a.js"sv);
+    EXPECT(scanner.remaining_input_length() > 0);
+
+    urls = serialize(scanner.scan(1));
+    EXPECT(urls.is_empty());
+
+    // NOTE: The tokenizer state is kept between calls, so the contents of <style> still aren't mistaken for markup.
+    urls = serialize(scanner.scan());
+    EXPECT_EQ(urls.size(), 2u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/b.png"sv);
+    EXPECT_EQ(urls[1], "https://example.com/dir/d.png"sv);
+    EXPECT_EQ(scanner.remaining_input_length(), 0u);
+    EXPECT(scanner.has_reached_end_of_input());
+    EXPECT(scanner.scan().is_empty());
+
+    // NOTE: Input that arrives after the scanner reached the end of what it had is scanned once it's handed over.
+    scanner.set_input(R"(<img src="e.png">)"sv);
+    EXPECT(!scanner.has_reached_end_of_input());
+    urls = serialize(scanner.scan());
+    EXPECT_EQ(urls.size(), 1u);
+    EXPECT_EQ(urls[0], "https://example.com/dir/e.png"sv);
+}
+
+TEST_CASE(base_url_is_kept_across_inputs)
+{
+    auto scanner = make_scanner();
+    scanner.set_input(R"(<base href="https://static.example.org/">)"sv);
+    EXPECT(scanner.scan().is_empty());
+
+    scanner.set_input(R"(<img src="a.png">)"sv);
+    auto urls = serialize(scanner.scan());
+    EXPECT_EQ(urls.size(), 1u);
+    EXPECT_EQ(urls[0], "https://static.example.org/a.png"sv);
+}
@@ -199,6 +199,20 @@ TEST_CASE(character_reference_in_attribute)
     END_ENUMERATION();
 }
 
+TEST_CASE(long_attribute_values)
+{
+    auto tokens = run_tokenizer("<p foo=\"a b\r\nc\rd\0e&amp;f\" bar='lorem ipsum \"dolor\" sit amet'>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_EQ(current_token->type(), Token::Type::StartTag);
+    EXPECT_EQ(current_token->tag_name(), "p");
+    NEXT_TOKEN();
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(2);
+    EXPECT_EQ(last_token->attribute("foo"_fly_string).value(), "a b\nc\nd\uFFFDe&f"sv);
+    EXPECT_EQ(last_token->attribute("bar"_fly_string).value(), "lorem ipsum \"dolor\" sit amet"sv);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(numeric_character_reference)
 {
     auto tokens = run_tokenizer("&#1111"sv);
@@ -229,6 +243,17 @@ TEST_CASE(comment)
     END_ENUMERATION();
 }
 
+TEST_CASE(comment_data)
+{
+    auto tokens = run_tokenizer("<!-- a <b> c\r\nd - e -->"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_EQ(current_token->type(), Token::Type::Comment);
+    EXPECT_EQ(current_token->comment(), " a <b> c\nd - e "sv);
+    NEXT_TOKEN();
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(doctype)
 {
     auto tokens = run_tokenizer("<!DOCTYPE html><html></html>"sv);
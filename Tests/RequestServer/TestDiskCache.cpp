@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibFileSystem/TempFile.h>
+#include <LibTest/TestCase.h>
+#include <LibURL/Parser.h>
+#include <RequestServer/DiskCache.h>
+
+using RequestServer::DiskCache;
+
+static constexpr auto partition_key = "https://example.com"sv;
+
+static URL::URL url_for(StringView string)
+{
+    return URL::Parser::basic_parse(string).release_value();
+}
+
+static HTTP::HeaderMap headers(std::initializer_list<Array<StringView, 2>> list)
+{
+    HTTP::HeaderMap map;
+    for (auto const& header : list)
+        map.set(header[0], header[1]);
+    return map;
+}
+
+static void store(DiskCache& cache, URL::URL const& url, HTTP::HeaderMap const& response_headers, StringView body, HTTP::HeaderMap const& request_headers = {})
+{
+    auto writer = MUST(cache.create_entry(partition_key, url, request_headers, 200, {}, response_headers, UnixDateTime::now()));
+    MUST(writer->write(body.bytes()));
+    writer->commit();
+}
+
+static ByteString read_body(DiskCache& cache, ByteString const& key)
+{
+    auto file = MUST(Core::File::adopt_fd(MUST(cache.open_body(key)), Core::File::OpenMode::Read));
+    return ByteString::copy(MUST(file->read_until_eof()));
+}
+
+TEST_CASE(fresh_response_is_served_from_cache)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath(directory->path().to_byte_string()), 1 * MiB));
+
+    auto url = url_for("https://example.com/style.css"sv);
+    store(*cache, url, headers({ { "Cache-Control"sv, "max-age=3600"sv } }), "body { color: red }"sv);
+
+    auto response = cache->find_response(partition_key, url, "GET"sv, {});
+    VERIFY(response.has_value());
+    EXPECT_EQ(response->freshness, DiskCache::Freshness::Fresh);
+    EXPECT_EQ(response->status_code, 200u);
+    EXPECT_EQ(response->body_size, 19u);
+    EXPECT_EQ(read_body(*cache, response->key), "body { color: red }"sv);
+
+    EXPECT(!cache->find_response(partition_key, url, "POST"sv, {}).has_value());
+    EXPECT(!cache->find_response("https://other.example"sv, url, "GET"sv, {}).has_value());
+    EXPECT(!cache->find_response(partition_key, url_for("https://example.com/other.css"sv), "GET"sv, {}).has_value());
+}
+
+TEST_CASE(stale_response_is_revalidated_and_freshened)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath(directory->path().to_byte_string()), 1 * MiB));
+
+    auto url = url_for("https://example.com/script.js"sv);
+    store(*cache, url, headers({ { "Cache-Control"sv, "max-age=0"sv }, { "ETag"sv, "\"v1\""sv } }), "alert(1)"sv);
+
+    auto response = cache->find_response(partition_key, url, "GET"sv, {});
+    VERIFY(response.has_value());
+    EXPECT_EQ(response->freshness, DiskCache::Freshness::NeedsRevalidation);
+    EXPECT_EQ(response->response_headers.get("ETag"sv), "\"v1\""sv);
+
+    auto freshened = cache->freshen_entry(response->key, headers({ { "Cache-Control"sv, "max-age=3600"sv }, { "ETag"sv, "\"v1\""sv } }), UnixDateTime::now());
+    VERIFY(freshened.has_value());
+    EXPECT_EQ(freshened->freshness, DiskCache::Freshness::Fresh);
+
+    response = cache->find_response(partition_key, url, "GET"sv, {});
+    VERIFY(response.has_value());
+    EXPECT_EQ(response->freshness, DiskCache::Freshness::Fresh);
+    EXPECT_EQ(response->response_headers.get("Cache-Control"sv), "max-age=3600"sv);
+    EXPECT_EQ(read_body(*cache, response->key), "alert(1)"sv);
+
+    // A removed entry can't be freshened.
+    cache->remove_entry(response->key);
+    EXPECT(!cache->freshen_entry(response->key, {}, UnixDateTime::now()).has_value());
+}
+
+TEST_CASE(stale_response_without_validator_is_removed)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath(directory->path().to_byte_string()), 1 * MiB));
+
+    auto url = url_for("https://example.com/image.png"sv);
+    store(*cache, url, headers({ { "Cache-Control"sv, "max-age=0"sv } }), "png"sv);
+
+    EXPECT(!cache->find_response(partition_key, url, "GET"sv, {}).has_value());
+    EXPECT(!cache->find_response(partition_key, url, "GET"sv, {}).has_value());
+}
+
+TEST_CASE(request_can_force_revalidation)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath(directory->path().to_byte_string()), 1 * MiB));
+
+    auto url = url_for("https://example.com/index.html"sv);
+    store(*cache, url, headers({ { "Cache-Control"sv, "max-age=3600"sv }, { "Last-Modified"sv, "Mon, 01 Jan 2024 00:00:00 GMT"sv } }), "<html>"sv);
+
+    auto response = cache->find_response(partition_key, url, "GET"sv, headers({ { "Cache-Control"sv, "no-cache"sv } }));
+    VERIFY(response.has_value());
+    EXPECT_EQ(response->freshness, DiskCache::Freshness::NeedsRevalidation);
+
+    response = cache->find_response(partition_key, url, "GET"sv, headers({ { "Pragma"sv, "no-cache"sv } }));
+    VERIFY(response.has_value());
+    EXPECT_EQ(response->freshness, DiskCache::Freshness::NeedsRevalidation);
+
+    response = cache->find_response(partition_key, url, "GET"sv, {});
+    VERIFY(response.has_value());
+    EXPECT_EQ(response->freshness, DiskCache::Freshness::Fresh);
+}
+
+TEST_CASE(vary_mismatch_is_a_miss)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath(directory->path().to_byte_string()), 1 * MiB));
+
+    auto url = url_for("https://example.com/data.json"sv);
+    store(*cache, url, headers({ { "Cache-Control"sv, "max-age=3600"sv }, { "Vary"sv, "Accept-Language"sv } }), "{}"sv, headers({ { "Accept-Language"sv, "en"sv } }));
+
+    EXPECT(cache->find_response(partition_key, url, "GET"sv, headers({ { "Accept-Language"sv, "en"sv } })).has_value());
+    EXPECT(!cache->find_response(partition_key, url, "GET"sv, headers({ { "Accept-Language"sv, "nl"sv } })).has_value());
+    EXPECT(!cache->find_response(partition_key, url, "GET"sv, {}).has_value());
+}
+
+TEST_CASE(cacheability)
+{
+    auto max_age = headers({ { "Cache-Control"sv, "max-age=3600"sv } });
+
+    EXPECT(DiskCache::is_cacheable("GET"sv, {}, 200, max_age));
+    EXPECT(!DiskCache::is_cacheable("POST"sv, {}, 200, max_age));
+    EXPECT(!DiskCache::is_cacheable("GET"sv, {}, 206, max_age));
+    EXPECT(!DiskCache::is_cacheable("GET"sv, {}, 304, max_age));
+    EXPECT(!DiskCache::is_cacheable("GET"sv, {}, 200, headers({ { "Cache-Control"sv, "no-store"sv } })));
+    EXPECT(!DiskCache::is_cacheable("GET"sv, headers({ { "Cache-Control"sv, "no-store"sv } }), 200, max_age));
+    EXPECT(!DiskCache::is_cacheable("GET"sv, headers({ { "Authorization"sv, "Basic Zm9vOmJhcg=="sv } }), 200, max_age));
+    EXPECT(!DiskCache::is_cacheable("GET"sv, {}, 200, headers({ { "Cache-Control"sv, "max-age=3600"sv }, { "Vary"sv, "*"sv } })));
+
+    // Responses that are immediately stale are only worth storing if they can be revalidated.
+    EXPECT(!DiskCache::is_cacheable("GET"sv, {}, 200, {}));
+    EXPECT(DiskCache::is_cacheable("GET"sv, {}, 200, headers({ { "ETag"sv, "\"v1\""sv } })));
+}
+
+TEST_CASE(oversized_response_is_not_stored)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath(directory->path().to_byte_string()), 1000));
+
+    auto url = url_for("https://example.com/video.mp4"sv);
+    auto response_headers = headers({ { "Cache-Control"sv, "max-age=3600"sv } });
+
+    // The entry size cap is a tenth of the maximum cache size.
+    EXPECT(cache->create_entry(partition_key, url, {}, 200, {}, headers({ { "Cache-Control"sv, "max-age=3600"sv }, { "Content-Length"sv, "101"sv } }), UnixDateTime::now()).is_error());
+
+    {
+        auto chunk = ByteString::repeated('a', 60);
+        auto writer = MUST(cache->create_entry(partition_key, url, {}, 200, {}, response_headers, UnixDateTime::now()));
+        MUST(writer->write(chunk.bytes()));
+        EXPECT(writer->write(chunk.bytes()).is_error());
+    }
+
+    EXPECT(!cache->find_response(partition_key, url, "GET"sv, {}).has_value());
+}
+
+TEST_CASE(eviction_keeps_newly_stored_entry)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(DiskCache::create(LexicalPath(directory->path().to_byte_string()), 1000));
+
+    auto response_headers = headers({ { "Cache-Control"sv, "max-age=3600"sv } });
+    auto body = ByteString::repeated('a', 90);
+
+    for (size_t i = 0; i < 12; ++i)
+        store(*cache, url_for(ByteString::formatted("https://example.com/{}", i)), response_headers, body);
+
+    // Storing the twelfth entry exceeds the maximum size, so entries are evicted until the cache is back at 90% of it.
+    size_t remaining_entries = 0;
+    for (size_t i = 0; i < 12; ++i) {
+        if (cache->find_response(partition_key, url_for(ByteString::formatted("https://example.com/{}", i)), "GET"sv, {}).has_value())
+            ++remaining_entries;
+    }
+    EXPECT_EQ(remaining_entries, 10u);
+    EXPECT(cache->find_response(partition_key, url_for("https://example.com/11"sv), "GET"sv, {}).has_value());
+}
+
+TEST_CASE(index_survives_restart)
+{
+    Core::EventLoop loop;
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto path = LexicalPath(directory->path().to_byte_string());
+    auto url = url_for("https://example.com/font.woff2"sv);
+
+    {
+        auto cache = MUST(DiskCache::create(path, 1 * MiB));
+        store(*cache, url, headers({ { "Cache-Control"sv, "max-age=3600"sv } }), "woff2"sv);
+        cache->flush_index();
+    }
+
+    auto cache = MUST(DiskCache::create(path, 1 * MiB));
+    auto response = cache->find_response(partition_key, url, "GET"sv, {});
+    VERIFY(response.has_value());
+    EXPECT_EQ(response->freshness, DiskCache::Freshness::Fresh);
+    EXPECT_EQ(read_body(*cache, response->key), "woff2"sv);
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <RequestServer/RequestScheduler.h>
+
+using RequestServer::RequestPriority;
+
+struct TestRequest {
+    int id { 0 };
+    RequestPriority priority { RequestPriority::Medium };
+    bool is_in_flight { false };
+};
+
+struct TestScheduler : public RequestServer::RequestScheduler<TestRequest> {
+    TestScheduler()
+        : RequestScheduler(
+              [this](TestRequest& request) { started.append(request.id); },
+              [this](TestRequest& request) { stopped.append(request.id); })
+    {
+    }
+
+    Vector<int> started;
+    Vector<int> stopped;
+};
+
+TEST_CASE(requests_start_immediately_without_high_priority_requests)
+{
+    TestScheduler scheduler;
+
+    TestRequest requests[] = {
+        { 1, RequestPriority::VeryLow },
+        { 2, RequestPriority::Low },
+        { 3, RequestPriority::Low },
+        { 4, RequestPriority::Low },
+        { 5, RequestPriority::Medium },
+    };
+    for (auto& request : requests)
+        scheduler.schedule(request);
+
+    EXPECT_EQ(scheduler.started, (Vector<int> { 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(scheduler.deferred_request_count(), 0u);
+}
+
+TEST_CASE(low_priority_requests_are_deferred_while_high_priority_requests_are_in_flight)
+{
+    TestScheduler scheduler;
+
+    TestRequest high { 1, RequestPriority::High };
+    TestRequest low1 { 2, RequestPriority::Low };
+    TestRequest low2 { 3, RequestPriority::Low };
+    TestRequest low3 { 4, RequestPriority::Low };
+    TestRequest medium { 5, RequestPriority::Medium };
+
+    scheduler.schedule(high);
+    scheduler.schedule(low1);
+    scheduler.schedule(low2);
+    scheduler.schedule(low3);
+    scheduler.schedule(medium);
+
+    // A few low priority requests may run alongside high priority ones, and medium priority ones are never held back.
+    EXPECT_EQ(scheduler.started, (Vector<int> { 1, 2, 3, 5 }));
+    EXPECT(scheduler.is_deferred(low3));
+    EXPECT(!low3.is_in_flight);
+
+    // Once the high priority request finishes, deferred requests are started.
+    scheduler.unschedule(high);
+    EXPECT_EQ(scheduler.stopped, (Vector<int> { 1 }));
+    EXPECT_EQ(scheduler.started, (Vector<int> { 1, 2, 3, 5, 4 }));
+    EXPECT(low3.is_in_flight);
+    EXPECT_EQ(scheduler.deferred_request_count(), 0u);
+}
+
+TEST_CASE(deferred_requests_start_most_important_first)
+{
+    TestScheduler scheduler;
+
+    TestRequest high { 1, RequestPriority::VeryHigh };
+    TestRequest low1 { 2, RequestPriority::Low };
+    TestRequest low2 { 3, RequestPriority::Low };
+    TestRequest very_low { 4, RequestPriority::VeryLow };
+    TestRequest low3 { 5, RequestPriority::Low };
+    TestRequest low4 { 6, RequestPriority::Low };
+
+    scheduler.schedule(high);
+    scheduler.schedule(low1);
+    scheduler.schedule(low2);
+    scheduler.schedule(very_low);
+    scheduler.schedule(low3);
+    scheduler.schedule(low4);
+    EXPECT_EQ(scheduler.deferred_request_count(), 3u);
+
+    // Finishing a low priority request makes room for exactly one deferred request.
+    scheduler.unschedule(low1);
+    EXPECT_EQ(scheduler.started, (Vector<int> { 1, 2, 3, 5 }));
+
+    scheduler.unschedule(high);
+    EXPECT_EQ(scheduler.started, (Vector<int> { 1, 2, 3, 5, 6, 4 }));
+}
+
+TEST_CASE(raising_priority_starts_deferred_request)
+{
+    TestScheduler scheduler;
+
+    TestRequest high { 1, RequestPriority::High };
+    TestRequest low1 { 2, RequestPriority::Low };
+    TestRequest low2 { 3, RequestPriority::Low };
+    TestRequest low3 { 4, RequestPriority::Low };
+
+    scheduler.schedule(high);
+    scheduler.schedule(low1);
+    scheduler.schedule(low2);
+    scheduler.schedule(low3);
+    EXPECT(scheduler.is_deferred(low3));
+
+    scheduler.set_priority(low3, RequestPriority::High);
+    EXPECT(!scheduler.is_deferred(low3));
+    EXPECT(low3.is_in_flight);
+    EXPECT_EQ(low3.priority, RequestPriority::High);
+}
+
+TEST_CASE(lowering_priority_of_in_flight_request_releases_deferred_requests)
+{
+    TestScheduler scheduler;
+
+    TestRequest high { 1, RequestPriority::High };
+    TestRequest low1 { 2, RequestPriority::Low };
+    TestRequest low2 { 3, RequestPriority::Low };
+    TestRequest low3 { 4, RequestPriority::Low };
+
+    scheduler.schedule(high);
+    scheduler.schedule(low1);
+    scheduler.schedule(low2);
+    scheduler.schedule(low3);
+    EXPECT(scheduler.is_deferred(low3));
+
+    // With no high priority request left in flight, nothing needs to be held back.
+    scheduler.set_priority(high, RequestPriority::Medium);
+    EXPECT(low3.is_in_flight);
+    EXPECT(scheduler.stopped.is_empty());
+}
+
+TEST_CASE(unscheduling_deferred_request_does_not_start_it)
+{
+    TestScheduler scheduler;
+
+    TestRequest high { 1, RequestPriority::High };
+    TestRequest low1 { 2, RequestPriority::Low };
+    TestRequest low2 { 3, RequestPriority::Low };
+    TestRequest low3 { 4, RequestPriority::Low };
+
+    scheduler.schedule(high);
+    scheduler.schedule(low1);
+    scheduler.schedule(low2);
+    scheduler.schedule(low3);
+
+    scheduler.unschedule(low3);
+    EXPECT_EQ(scheduler.deferred_request_count(), 0u);
+    EXPECT(scheduler.stopped.is_empty());
+
+    scheduler.unschedule(high);
+    EXPECT_EQ(scheduler.started, (Vector<int> { 1, 2, 3 }));
+}
+
+TEST_CASE(request_priority_validation)
+{
+    EXPECT(RequestServer::is_valid_request_priority(RequestPriority::VeryLow));
+    EXPECT(RequestServer::is_valid_request_priority(RequestPriority::VeryHigh));
+    EXPECT(!RequestServer::is_valid_request_priority(static_cast<RequestPriority>(5)));
+    EXPECT(!RequestServer::is_valid_request_priority(static_cast<RequestPriority>(255)));
+}
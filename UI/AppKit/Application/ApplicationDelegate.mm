@@ -631,6 +631,9 @@
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump DOM Tree"
                                                 action:@selector(dumpDOMTree:)
                                          keyEquivalent:@""]];
+    [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump DOM Memory Usage"
+                                                action:@selector(dumpDOMMemoryUsage:)
+                                         keyEquivalent:@""]];
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Layout Tree"
                                                 action:@selector(dumpLayoutTree:)
                                          keyEquivalent:@""]];
@@ -655,6 +658,12 @@
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Local Storage"
                                                 action:@selector(dumpLocalStorage:)
                                          keyEquivalent:@""]];
+    [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump IPC Statistics"
+                                                action:@selector(dumpIPCStatistics:)
+                                         keyEquivalent:@""]];
+    [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Decoded Image Cache Statistics"
+                                                action:@selector(dumpDecodedImageCacheStatistics:)
+                                         keyEquivalent:@""]];
     [submenu addItem:[NSMenuItem separatorItem]];
 
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Show Line Box Borders"
@@ -344,6 +344,11 @@ static NSString* const TOOLBAR_TAB_OVERVIEW_IDENTIFIER = @"ToolbarTabOverviewIde
     [self debugRequest:"dump-dom-tree" argument:""];
 }
 
+- (void)dumpDOMMemoryUsage:(id)sender
+{
+    [self debugRequest:"dump-dom-memory-usage" argument:""];
+}
+
 - (void)dumpLayoutTree:(id)sender
 {
     [self debugRequest:"dump-layout-tree" argument:""];
@@ -379,6 +384,16 @@ static NSString* const TOOLBAR_TAB_OVERVIEW_IDENTIFIER = @"ToolbarTabOverviewIde
     [self debugRequest:"dump-local-storage" argument:""];
 }
 
+- (void)dumpIPCStatistics:(id)sender
+{
+    [self debugRequest:"dump-ipc-statistics" argument:""];
+}
+
+- (void)dumpDecodedImageCacheStatistics:(id)sender
+{
+    [self debugRequest:"dump-decoded-image-cache-statistics" argument:""];
+}
+
 - (void)toggleLineBoxBorders:(id)sender
 {
     m_settings.should_show_line_box_borders = !m_settings.should_show_line_box_borders;
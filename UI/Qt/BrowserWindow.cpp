@@ -380,6 +380,13 @@ BrowserWindow::BrowserWindow(Vector<URL::URL> const& initial_urls, IsPopupWindow
         debug_request("dump-dom-tree");
     });
 
+    auto* dump_dom_memory_usage_action = new QAction("Dump DOM &Memory Usage", this);
+    dump_dom_memory_usage_action->setIcon(load_icon_from_uri("resource://icons/browser/dom-tree.png"sv));
+    debug_menu->addAction(dump_dom_memory_usage_action);
+    QObject::connect(dump_dom_memory_usage_action, &QAction::triggered, this, [this] {
+        debug_request("dump-dom-memory-usage");
+    });
+
     auto* dump_layout_tree_action = new QAction("Dump &Layout Tree", this);
     dump_layout_tree_action->setIcon(load_icon_from_uri("resource://icons/16x16/layout.png"sv));
     debug_menu->addAction(dump_layout_tree_action);
@@ -429,6 +436,18 @@ BrowserWindow::BrowserWindow(Vector<URL::URL> const& initial_urls, IsPopupWindow
         debug_request("dump-local-storage");
     });
 
+    auto* dump_ipc_statistics_action = new QAction("Dump &IPC Statistics", this);
+    debug_menu->addAction(dump_ipc_statistics_action);
+    QObject::connect(dump_ipc_statistics_action, &QAction::triggered, this, [this] {
+        debug_request("dump-ipc-statistics");
+    });
+
+    auto* dump_decoded_image_cache_statistics_action = new QAction("Dump Decoded Image "Dump &Decoded Image Cache Statistics"Cache Statistics", this);
+    debug_menu->addAction(dump_decoded_image_cache_statistics_action);
+    QObject::connect(dump_decoded_image_cache_statistics_action, &QAction::triggered, this, [this] {
+        debug_request("dump-decoded-image-cache-statistics");
+    });
+
     debug_menu->addSeparator();
 
     m_show_line_box_borders_action = new QAction("Show Line Box Borders", this);